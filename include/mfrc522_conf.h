@@ -20,9 +20,39 @@
  * Delay function is disabled and retry count is set to some value. In general, total number of time in which device has
  * to respond is: retry count * time of executing one iteration of a loop. In some circumstances this may be not enough.
  * The multiplier has to be tuned, depending on bus settings, e.g. clock frequency and other links.
+ *
+ * Driver operations do not depend on the multiplier when low-level monotonic clock is available. Time budgets defined
+ * by MFRC522_CONF_DEADLINE_* macros are used then.
  */
 #define MFRC522_CONF_RETRY_CNT_MUL 10
 
+/**
+ * Time budgets (in microseconds) of driver operations. Used only if low-level monotonic clock is available, i.e. 'now'
+ * operation is set or MFRC522_LL_CLOCK macro is enabled. Then waits end when the budget is exhausted rather than after
+ * a number of retries, so timeouts do not depend on speed of a host and a bus.
+ *
+ * - SOFT_RESET: waiting for the device to come back from soft reset
+ * - CMD: waiting for a command to terminate, e.g. Idle, Mem or Random, and polls of register scripts
+ * - CRC: waiting for CRC coprocessor result
+ * - SELF_TEST: waiting for self test output
+ * - TRANSCEIVE: waiting for a response of a PICC when the timer is not used. Otherwise the budget is added to twice
+ *   the timer period, as the timer decides when the command times out
+ * - WAKE_UP: waiting for the oscillator to become stable when the device leaves soft power-down
+ */
+#define MFRC522_CONF_DEADLINE_SOFT_RESET 5000
+#define MFRC522_CONF_DEADLINE_CMD 2000
+#define MFRC522_CONF_DEADLINE_CRC 500
+#define MFRC522_CONF_DEADLINE_SELF_TEST 10000
+#define MFRC522_CONF_DEADLINE_TRANSCEIVE 5000
+#define MFRC522_CONF_DEADLINE_WAKE_UP 5000
+
+/**
+ * Maximum time (in microseconds) the driver waits for IRQ pin to become active during transceive command. Used only if
+ * low-level IRQ wait function is available and low-level clock is not. The value shall cover the longest expected
+ * response time of a PICC.
+ */
+#define MFRC522_CONF_IRQ_WAIT_TIMEOUT 25000
+
 /**
  * According to MFRC522 documentation, the formula to calculate timer period is:
  * TPeriod = ((TPrescaler * 2 + Fixed) * (TReload + 1)) / 13.56 MHz,
@@ -38,11 +38,37 @@ extern "C" {
  */
 #define MFRC522_DRV_TIM_MAX_PERIOD 16383
 
+/**
+ * Frame waiting time (in milliseconds) used for ISO/IEC 14443-3 frames, i.e. REQA, ANTICOLLISION, SELECT and HLTA.
+ * The PICC responds within about 100us, thus the shortest timer period is sufficient
+ */
+#define MFRC522_DRV_FWT_ISO14443_3 1
+
+/**
+ * Frame waiting time (in milliseconds) used for MIFARE Classic authentication
+ */
+#define MFRC522_DRV_FWT_MIFARE_AUTH 10
+
+/**
+ * Size of TX storage in non-blocking transceive operation. Large enough to hold the longest frame sent by PICC APIs
+ */
+#define MFRC522_DRV_TRANSCEIVE_OP_TX_SZ 12
+
+/**
+ * Size of RX storage in non-blocking transceive operation. Large enough to hold the longest frame received by PICC APIs
+ */
+#define MFRC522_DRV_TRANSCEIVE_OP_RX_SZ 5
+
 /**
  * The number of bytes returned in self test mode
  */
 #define MFRC522_DRV_SELF_TEST_FIFO_SZ 64
 
+/**
+ * Number of registers captured by a register snapshot
+ */
+#define MFRC522_DRV_SNAPSHOT_SZ 30
+
 /**
  * Total number of bytes returned by 'Random' command
  */
@@ -53,6 +79,53 @@ extern "C" {
  */
 #define MFRC522_DRV_RAND_BYTES 10
 
+/**
+ * The number of registers in MFRC522 register map
+ */
+#define MFRC522_DRV_REG_NUM 64
+
+/**
+ * Initializer of 'mfrc522_drv_read_until_conf' with default values: whole register compared, default number of retries
+ * without delays, no backoff and no deadline. Fields added in later versions take their default values as well, e.g.
+ * mfrc522_drv_read_until_conf ru_conf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+ */
+#define MFRC522_DRV_READ_UNTIL_CONF_DEFAULT \
+    {mfrc522_reg_reserved0, 0x00, 0xFF, 0x00, 0, MFRC522_DRV_DEF_RETRY_CNT, 0, 0, 0}
+
+/**
+ * Initializer of 'mfrc522_drv_tim_conf' with default values: odd prescaler and reload value of zero, single-shot timer
+ * started manually
+ */
+#define MFRC522_DRV_TIM_CONF_DEFAULT {0, mfrc522_drv_tim_psl_odd, 0, false, false}
+
+/**
+ * Initializer of 'mfrc522_drv_transceive_conf' with default values: Transceive command without any data, polled
+ * instead of timed, with CRC and bit oriented framing handled by a caller. Fields added in later versions take their
+ * default values as well
+ */
+#define MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT \
+    {NULL, 0, NULL, 0, mfrc522_reg_cmd_transceive, 0, false, 0, 0, false, 0, 0, 0}
+
+/**
+ * Create register script entry which writes a byte to a register
+ */
+#define MFRC522_DRV_SCRIPT_WR(ADDR, VAL) {mfrc522_drv_script_op_write, (ADDR), (u8)(VAL), 0xFF}
+
+/**
+ * Create register script entry which writes a field of a register. FIELD is a name of the field
+ * as passed to MFRC522_REG_FIELD() macro, e.g. MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_mode, 1, MODE_CRC_PRESET)
+ */
+#define MFRC522_DRV_SCRIPT_WR_MASKED(ADDR, VAL, FIELD) \
+    {mfrc522_drv_script_op_write_masked, (ADDR), \
+     (u8)(((u8)(VAL) << MFRC522_REG_FIELD_POS(FIELD)) & MFRC522_REG_FIELD_MSK_REAL(FIELD)), \
+     (u8)MFRC522_REG_FIELD_MSK_REAL(FIELD)}
+
+/**
+ * Create register script entry which polls a register until (value & MSK) == EXP.
+ * Default number of retries is used
+ */
+#define MFRC522_DRV_SCRIPT_POLL(ADDR, EXP, MSK) {mfrc522_drv_script_op_poll, (ADDR), (u8)(EXP), (u8)(MSK)}
+
 /* ------------------------------------------------------------ */
 /* -------------------------- Data types ---------------------- */
 /* ------------------------------------------------------------ */
@@ -125,30 +198,120 @@ typedef enum mfrc522_drv_status_
     /**<
      * An error when halting a PICC
      */
-    mfrc522_drv_status_halt_err = MAKE_STATUS(0x0F, status_severity_critical)
+    mfrc522_drv_status_halt_err = MAKE_STATUS(0x0F, status_severity_critical),
+    /**<
+     * Non-blocking operation has not completed yet
+     */
+    mfrc522_drv_status_in_progress = MAKE_STATUS(0x10, status_severity_none),
+    /**<
+     * Cascade tag or SAK of a PICC is inconsistent with UID size
+     */
+    mfrc522_drv_status_cascade_err = MAKE_STATUS(0x11, status_severity_critical),
+    /**<
+     * Bit collision was detected, i.e. more than one PICC answered
+     */
+    mfrc522_drv_status_collision = MAKE_STATUS(0x12, status_severity_non_critical)
 } mfrc522_drv_status;
 
 /**
- * MFRC522 configuration values
+ * Methods of computing CRC_A of PICC frames. Values are fixed and new methods are only appended, so zero-initialized
+ * configurations keep using the coprocessor
+ */
+typedef enum mfrc522_drv_crc_mode_
+{
+    mfrc522_drv_crc_mode_coproc = 0, /**< CRC coprocessor invoked with CalcCRC command */
+    mfrc522_drv_crc_mode_sw = 1, /**< Software implementation, i.e. 'mfrc522_picc_crc_a()' */
+    mfrc522_drv_crc_mode_hw = 2 /**< Appended and checked by the device during transceive (TxCRCEn and RxCRCEn bits) */
+} mfrc522_drv_crc_mode;
+
+/**
+ * Register shadow cache.
+ *
+ * Keeps last known values of registers that are never modified by a device itself. Thanks to that, masked writes to
+ * such registers do not need to read a register first. Do not modify the fields manually.
+ */
+typedef struct mfrc522_drv_reg_cache_
+{
+    u8 regs[MFRC522_DRV_REG_NUM]; /**< Shadowed register values */
+    u64 valid; /**< Bitmask of registers whose shadowed values are valid. Bit n stands for register n */
+} mfrc522_drv_reg_cache;
+
+/**
+ * Snapshot of configuration registers, i.e. host-owned registers except for BitFramingReg (set up for every frame) and
+ * SerialSpeedReg (owned by low-level layer). Use 'mfrc522_drv_snapshot_get()' to access particular registers.
+ */
+typedef struct mfrc522_drv_reg_snapshot_
+{
+    u8 regs[MFRC522_DRV_SNAPSHOT_SZ]; /**< Register values in order of ascending register addresses */
+} mfrc522_drv_reg_snapshot;
+
+/**
+ * Operations recognized by register script interpreter
+ */
+typedef enum mfrc522_drv_script_op_
+{
+    mfrc522_drv_script_op_write = 0, /**< Write a byte to a register */
+    mfrc522_drv_script_op_write_masked, /**< Write a field of a register */
+    mfrc522_drv_script_op_poll /**< Poll a register until expected value is read */
+} mfrc522_drv_script_op;
+
+/**
+ * Single entry of a register script. Use MFRC522_DRV_SCRIPT_* macros to create entries, so that constant scripts can be
+ * evaluated at compile time and placed in read-only memory.
+ */
+typedef struct mfrc522_drv_script_entry_
+{
+    u8 op; /**< Operation. An instance of mfrc522_drv_script_op */
+    u8 addr; /**< Register address */
+    u8 val; /**< Value to write (already shifted) or expected value in case of poll */
+    u8 mask; /**< Mask of affected bits (already shifted) */
+} mfrc522_drv_script_entry;
+
+/**
+ * MFRC522 configuration values.
+ *
+ * The structure has to be zero-initialized (or set up with 'mfrc522_drv_conf_init()') before its fields are filled,
+ * so that fields added in later versions of the library take their default values.
  */
 typedef struct mfrc522_drv_conf_
 {
 #if MFRC522_LL_PTR
-    mfrc522_ll_init ll_init; /**< Low-level init function pointer */
-    mfrc522_ll_send ll_send; /**< Low-level send function pointer */
-    mfrc522_ll_recv ll_recv; /**< Low-level receive function pointer */
-#if MFRC522_LL_DELAY
-    mfrc522_ll_delay ll_delay; /**< Low-level delay function pointer */
-#endif
+    const mfrc522_ll_ops* ll_ops; /**< Pointer to a table of low-level operations */
 #endif
+    void* ll_ctx; /**< Low-level context of a device passed to every low-level call. Can be NULL */
     mfrc522_picc_atqa_verify_fn atqa_verify_fn; /**< Pointer to optional ATQA verification function. Can be NULL */
+    mfrc522_drv_crc_mode crc_mode; /**< Method of computing CRC_A of PICC frames */
     /* Read-only fields. Do not modify manually */
+    mfrc522_drv_reg_cache* reg_cache; /**< Register shadow cache set by 'mfrc522_drv_reg_cache_attach()'. Can be NULL */
     u8 chip_version; /**< Chip version number */
     u8 self_test_out[MFRC522_DRV_SELF_TEST_FIFO_SZ]; /**< Self test bytes */
 } mfrc522_drv_conf;
 
 /**
- * Configuration structure used by 'mfrc522_drv_read_until()' function
+ * Callback invoked when asynchronous register operation completes.
+ *
+ * @param status Status of the operation. Valid values are:
+ *               - mfrc522_drv_status_ll_err on low-level error
+ *               - mfrc522_drv_status_ok on success
+ * @param arg User argument passed when the operation was started.
+ */
+typedef void (*mfrc522_drv_async_cb)(mfrc522_drv_status status, void* arg);
+
+/**
+ * Asynchronous register operation. The structure is provided by the caller and must stay valid until the callback is
+ * invoked. Do not modify the fields manually.
+ */
+typedef struct mfrc522_drv_async_req_
+{
+    const mfrc522_drv_conf* conf; /**< Device's configuration */
+    mfrc522_ll_xfer xfer; /**< Transfer passed to low-level layer */
+    mfrc522_drv_async_cb cb; /**< Completion callback */
+    void* arg; /**< User argument passed to completion callback */
+} mfrc522_drv_async_req;
+
+/**
+ * Configuration structure used by 'mfrc522_drv_read_until()' function. Initialize it with
+ * MFRC522_DRV_READ_UNTIL_CONF_DEFAULT and override the fields of interest
  */
 typedef struct mfrc522_drv_read_until_conf_
 {
@@ -158,6 +321,9 @@ typedef struct mfrc522_drv_read_until_conf_
     u8 exp_payload; /**< Expected payload. Used as the exit criterion. */
     u32 delay; /**< Optional delay in microseconds between reads. Valid only if MFRC522_LL_DELAY is set */
     u32 retry_cnt; /**< Maximum number of retries */
+    u32 first_delay; /**< Expected latency in microseconds, waited before the first read. Zero reads immediately */
+    u32 max_delay; /**< Backoff cap in microseconds. If greater than 'delay', the delay doubles after each retry */
+    u32 timeout; /**< Deadline in microseconds measured from the call. Zero disables the deadline */
 } mfrc522_drv_read_until_conf;
 
 /**
@@ -170,7 +336,7 @@ typedef enum mfrc522_drv_tim_psl_type_
 } mfrc522_drv_tim_psl_type;
 
 /**
- * Timer configuration structure
+ * Timer configuration structure. Initialize it with MFRC522_DRV_TIM_CONF_DEFAULT
  */
 typedef struct mfrc522_drv_tim_conf_
 {
@@ -178,6 +344,7 @@ typedef struct mfrc522_drv_tim_conf_
     mfrc522_drv_tim_psl_type prescaler_type; /**< Prescaler type */
     u16 reload_val; /**< Reload value */
     bool periodic; /**< Periodicity flag */
+    bool auto_start; /**< Automatic start flag. When set, the timer starts at the end of transmission (TAuto) */
 } mfrc522_drv_tim_conf;
 
 /**
@@ -218,7 +385,8 @@ typedef struct mfrc522_drv_ext_itf_conf_
 } mfrc522_drv_ext_itf_conf;
 
 /**
- * Configuration used with transceive command
+ * Configuration used with transceive command. Initialize it with MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT and override
+ * the fields of interest
  */
 typedef struct mfrc522_drv_transceive_conf_
 {
@@ -226,9 +394,24 @@ typedef struct mfrc522_drv_transceive_conf_
     size tx_data_sz; /**< Size of TX data in bytes */
     u8* rx_data; /**< Pointer where RX data will be stored. vMust be large enough to contain the number of 'rx_data_sz'
                       bytes. Can be NULL when 'rx_data_sz' equals to zero */
-    size rx_data_sz; /**< Expected number of RX bytes. Can be zero (no data is expected on RX side) */
+    size rx_data_sz; /**< Expected number of RX bytes, or the maximum one if 'rx_var_len' is set. Can be zero
+                          (no data is expected on RX side) */
     mfrc522_reg_cmd command; /**< Command used to transceive the data.
                                   Valid ones are 'mfrc522_reg_cmd_transceive' and 'mfrc522_reg_cmd_authent' */
+    u16 timeout; /**< Frame waiting time in milliseconds, measured by the timer from the end of transmission. Zero
+                      means that the timer is not used and the device is polled default number of times instead */
+    bool hw_crc; /**< Set to let the device append CRC_A to TX data and check it in RX data. CRC bytes are not part of
+                      'tx_data' and 'rx_data' then */
+    u8 tx_last_bits; /**< Number of bits of the last TX byte to be transmitted (0-7). Zero means the whole byte */
+    u8 rx_align; /**< Bit position of the first received bit within the first RX byte (0-7). Used for bit oriented
+                      anticollision frames */
+    bool rx_var_len; /**< Set if length of RX data is not known in advance. Any number of bytes up to 'rx_data_sz'
+                          is accepted then and the last byte may be incomplete */
+    /* Output fields. Set by the driver */
+    size rx_len; /**< Number of RX bytes stored in 'rx_data', including an incomplete last byte */
+    u8 rx_last_bits; /**< Number of valid bits of the last RX byte. Zero means the whole byte is valid */
+    u8 coll_pos; /**< Position of the first collided bit in 'rx_data' counted from 1, including 'rx_align' bits of
+                      the first byte. Zero if no collision was detected */
 } mfrc522_drv_transceive_conf;
 
 /**
@@ -243,10 +426,110 @@ typedef struct mfrc522_drv_auth_conf_
     u8* key; /**< Either Key A or Key B depending on 'key_type' setting */
 } mfrc522_drv_auth_conf;
 
+/**
+ * States of non-blocking transceive operation
+ */
+typedef enum mfrc522_drv_transceive_state_
+{
+    mfrc522_drv_transceive_state_idle = 0, /**< Operation not started or already finished */
+    mfrc522_drv_transceive_state_busy, /**< Command is being executed by the device */
+    mfrc522_drv_transceive_state_done /**< Command completed. The operation is waiting for being finished */
+} mfrc522_drv_transceive_state;
+
+/**
+ * Non-blocking transceive operation.
+ *
+ * The instance keeps the whole context of a command between start, poll and finish calls, thus several operations on
+ * different devices can be driven from a single thread. Fields are managed by the driver, do not modify them manually.
+ * The instance shall not be copied while the operation is in progress.
+ */
+typedef struct mfrc522_drv_transceive_op_
+{
+    mfrc522_drv_transceive_state state; /**< Current state of the operation */
+    mfrc522_drv_transceive_conf tr_conf; /**< Copy of transceive configuration */
+    mfrc522_drv_status result; /**< Outcome of the command. Valid in 'done' state */
+    u8 command; /**< Value of CommandReg used to invoke the command */
+    u8 bit_framing; /**< Value of BitFramingReg without StartSend bit */
+    u8 com_irq_en; /**< Value of ComIEnReg to be restored. Used only when IRQ pin is awaited */
+    u8 tx_mode; /**< Value of TxModeReg to be restored. Used only when CRC is handled by the device */
+    u8 rx_mode; /**< Value of RxModeReg to be restored. Used only when CRC is handled by the device */
+    bool irq_pin; /**< Set if interrupts are routed to IRQ pin during the command */
+    u32 polls; /**< Number of polls performed so far */
+    u32 poll_limit; /**< Number of polls after which the command times out */
+    u32 poll_delay; /**< Recommended delay between subsequent polls in microseconds */
+    u32 started; /**< Clock value at the start of the command. Used only if low-level clock is available */
+    u32 budget; /**< Time in microseconds after which the command times out. Zero if low-level clock is not available */
+    u8 tx[MFRC522_DRV_TRANSCEIVE_OP_TX_SZ]; /**< TX storage used by PICC operations */
+    u8 rx[MFRC522_DRV_TRANSCEIVE_OP_RX_SZ]; /**< RX storage used by PICC operations */
+} mfrc522_drv_transceive_op;
+
+/**
+ * Card presence probe. Fields are managed by the driver, do not modify them manually
+ */
+typedef struct mfrc522_drv_probe_ctx_
+{
+    bool active; /**< Set while the device is configured for probing */
+    u8 frame; /**< Short frame sent to PICCs, i.e. REQA or WUPA */
+    u8 command; /**< Value of CommandReg used to invoke Transceive command */
+    u8 bit_framing; /**< Value of BitFramingReg used to send short frames, without StartSend bit */
+    u8 command_prev; /**< Value of CommandReg to be restored */
+    u8 bit_framing_prev; /**< Value of BitFramingReg to be restored */
+    u32 poll_limit; /**< Number of ComIrqReg reads after which PICC is considered absent */
+    bool ready; /**< Set if a PICC may be in READY state, i.e. it answered the previous frame */
+} mfrc522_drv_probe_ctx;
+
+/**
+ * Configuration of low-power card detection
+ */
+typedef struct mfrc522_drv_lpcd_conf_
+{
+    mfrc522_picc_cmd frame; /**< Short frame used to probe PICCs. Valid ones are 'mfrc522_picc_cmd_reqa' and
+                                 'mfrc522_picc_cmd_wupa' */
+    u32 sleep_period; /**< Time spent in soft power-down between subsequent probes in microseconds */
+    u32 settle_time; /**< Time between wake-up and a probe in microseconds. PICCs need it to power up in RF field */
+    u32 max_cycles; /**< Maximum number of probes. Zero means that detection lasts until a PICC is found */
+} mfrc522_drv_lpcd_conf;
+
+/**
+ * Self test policy of device bring-up
+ */
+typedef enum mfrc522_drv_bringup_self_test_
+{
+    mfrc522_drv_bringup_self_test_skip = 0, /**< Self test is not performed. It can be deferred with a call to
+                                                 'mfrc522_drv_self_test()' followed by another bring-up */
+    mfrc522_drv_bringup_self_test_run /**< Self test is performed whenever the device is reset */
+} mfrc522_drv_bringup_self_test;
+
+/**
+ * Configuration of device bring-up
+ */
+typedef struct mfrc522_drv_bringup_conf_
+{
+    const mfrc522_drv_script_entry* image; /**< Target register image. Only write and masked write entries of
+                                                host-owned registers are allowed */
+    size image_sz; /**< Number of entries of the image */
+    mfrc522_drv_bringup_self_test self_test; /**< Self test policy */
+    bool force_reset; /**< Reset the device even if it already holds the image */
+} mfrc522_drv_bringup_conf;
+
 /* ------------------------------------------------------------ */
 /* ----------------------- Public functions ------------------- */
 /* ------------------------------------------------------------ */
 
+/**
+ * Set up a configuration structure with default values.
+ *
+ * All fields are zeroed, i.e. no low-level context, no ATQA verification function, no register shadow cache and CRC
+ * coprocessor used for PICC frames. The function is meant to be called before mandatory fields are filled.
+ *
+ * @param conf Pointer to a configuration structure.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_ok on success
+ */
+mfrc522_drv_status
+mfrc522_drv_conf_init(mfrc522_drv_conf* conf);
+
 /**
  * Initialize MFRC522 device.
  *
@@ -256,13 +539,18 @@ typedef struct mfrc522_drv_auth_conf_
  * type was returned which is supported by the library.
  *
  * After receiving an error from low-level receive function, 'chip_version' field is set to MFRC522_REG_VERSION_INVALID.
+ * Register shadow cache is detached, so that a garbage 'reg_cache' pointer is never used. Attach it afterwards with
+ * 'mfrc522_drv_reg_cache_attach()' when needed.
  *
- * In a case 'pointer' low-level calls are used, 'll_send and 'll_recv' pointers need to be set in a configuration
- * structure. Otherwise an error is returned.
+ * In a case 'pointer' low-level calls are used, 'll_ops' table has to be set in a configuration structure and all of its
+ * mandatory operations need to be set. Otherwise an error is returned. Tables of unsupported version are rejected.
+ * In both cases 'll_ctx' field is passed untouched to every low-level call, thus it can be used to tell several
+ * devices apart.
  *
  * @param conf Pointer to a configuration structure. Mandatory fields have to be set prior to call to this function.
  * @return Status of the operation. Valid responses are:
  *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_ll_err on low-level error or unsupported version of 'll_ops' table
  *         - mfrc522_drv_status_dev_err when valid device is not found
  *         - mfrc522_drv_status_ok on success
  */
@@ -273,9 +561,8 @@ mfrc522_drv_init(mfrc522_drv_conf* conf);
  * Write multiple bytes to a PCD's register.
  *
  * The function performs write to a PCD (Proximity Coupling Device). Depending on low-level call mechanism, 'pointer'
- * or 'definition' method is used.
+ * or 'definition' method is used. When register shadow cache is used, the last byte written is stored in the cache.
  *
- * Note that depending on compiler used, the function may be in fact not inlined.
  * In a case when either 'conf' or 'payload' is NULL, mfrc522_drv_status_nullptr is returned.
  *
  * @param conf Pointer to a configuration structure.
@@ -284,20 +571,8 @@ mfrc522_drv_init(mfrc522_drv_conf* conf);
  * @param payload Payload bytes.
  * @return An instance of mfrc522_drv_status. On success mfrc522_drv_ok is returned.
  */
-static inline mfrc522_drv_status
-mfrc522_drv_write(const mfrc522_drv_conf* conf, mfrc522_reg addr, size sz, const u8* payload)
-{
-    NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(payload, mfrc522_drv_status_nullptr);
-#if MFRC522_LL_PTR
-    return (mfrc522_ll_status_ok == conf->ll_send(addr, sz, payload)) ? mfrc522_drv_status_ok
-                                                                      : mfrc522_drv_status_ll_err;
-#elif MFRC522_LL_DEF
-    (void)conf; /* Make compiler happy */
-    return (mfrc522_ll_status_ok == mfrc522_ll_send(addr, sz, payload)) ? mfrc522_drv_status_ok
-                                                                        : mfrc522_drv_status_ll_err;
-#endif
-}
+mfrc522_drv_status
+mfrc522_drv_write(const mfrc522_drv_conf* conf, mfrc522_reg addr, size sz, const u8* payload);
 
 /**
  * Write single byte to a PCD's register.
@@ -320,6 +595,8 @@ mfrc522_drv_write_byte(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8 payloa
  *
  * The function sets new value of a register regarding value, position and mask. It is useful in cases when a single
  * register contains multiple fields and only one of them should be changed. Only bits selected in mask are affected.
+ * When register shadow cache is used and it holds valid value of the register, the register is not read from a device
+ * and a single write is performed.
  * In a case when 'conf' is NULL, mfrc522_drv_status_nullptr is returned.
  *
  * @param conf Pointer to a configuration structure.
@@ -336,9 +613,9 @@ mfrc522_drv_write_masked(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8 val,
  * Read from a PCD.
  *
  * The function performs read from a PCD (Proximity Coupling Device). Depending on low-level call mechanism, 'pointer'
- * or 'definition' method is used.
+ * or 'definition' method is used. The register is always read from a device. When register shadow cache is used and
+ * the register can be shadowed, received value is stored in the cache.
  *
- * Note that depending on compiler used, the function may be in fact not inlined.
  * In a case when either 'conf' or 'payload' is NULL, mfrc522_drv_status_nullptr is returned.
  *
  * @param conf Pointer to a configuration structure.
@@ -346,18 +623,46 @@ mfrc522_drv_write_masked(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8 val,
  * @param payload Pointer to a buffer where incoming bytes are written. Must be big enough to store all data.
  * @return An instance of mfrc522_drv_status. On success mfrc522_drv_status_ok is returned.
  */
-static inline mfrc522_drv_status
-mfrc522_drv_read(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8* payload)
-{
-    NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(payload, mfrc522_drv_status_nullptr);
-#if MFRC522_LL_PTR
-    return (mfrc522_ll_status_ok == conf->ll_recv(addr, payload)) ? mfrc522_drv_status_ok : mfrc522_drv_status_ll_err;
-#elif MFRC522_LL_DEF
-    (void)conf; /* Make compiler happy */
-    return (mfrc522_ll_status_ok == mfrc522_ll_recv(addr, payload)) ? mfrc522_drv_status_ok : mfrc522_drv_status_ll_err;
-#endif
-}
+mfrc522_drv_status
+mfrc522_drv_read(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8* payload);
+
+/**
+ * Read multiple bytes from the same PCD's register.
+ *
+ * The function reads a register 'sz' times in a row using a single low-level call, which is much cheaper than
+ * issuing 'sz' separate reads. It is mainly used to drain the FIFO buffer. When register shadow cache is used and the
+ * register can be shadowed, the last byte received is stored in the cache.
+ *
+ * In a case when either 'conf' or 'payload' is NULL, mfrc522_drv_status_nullptr is returned.
+ *
+ * @param conf Pointer to a configuration structure.
+ * @param addr Register address.
+ * @param sz Number of bytes to read.
+ * @param payload Pointer to a buffer where incoming bytes are written. Must be big enough to store 'sz' bytes.
+ * @return An instance of mfrc522_drv_status. On success mfrc522_drv_status_ok is returned.
+ */
+mfrc522_drv_status
+mfrc522_drv_read_mul(const mfrc522_drv_conf* conf, mfrc522_reg addr, size sz, u8* payload);
+
+/**
+ * Read several registers in one go.
+ *
+ * The function reads each register from 'addrs' list once and stores its value at the same index of 'out' buffer.
+ * All the reads are passed to low-level layer as a single scatter-gather batch (split into chunks when the list is
+ * long), thus registers do not need to be adjacent. If scatter-gather transfers are not supported by low-level layer,
+ * the reads are issued one by one. When register shadow cache is used, values of registers which can be shadowed are
+ * stored in the cache.
+ *
+ * In a case when either 'conf', 'addrs' or 'out' is NULL, mfrc522_drv_status_nullptr is returned.
+ *
+ * @param conf Pointer to a configuration structure.
+ * @param addrs List of register addresses.
+ * @param num Number of registers to read.
+ * @param out Pointer to a buffer where register values are written. Must be big enough to store 'num' bytes.
+ * @return An instance of mfrc522_drv_status. On success mfrc522_drv_status_ok is returned.
+ */
+mfrc522_drv_status
+mfrc522_drv_read_regs(const mfrc522_drv_conf* conf, const mfrc522_reg* addrs, size num, u8* out);
 
 /**
  * Perform masked read from a PCD's register.
@@ -375,6 +680,73 @@ mfrc522_drv_read(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8* payload)
 mfrc522_drv_status
 mfrc522_drv_read_masked(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8* out, u8 mask, u8 pos);
 
+/**
+ * Start asynchronous write to a PCD.
+ *
+ * The function passes the write to asynchronous low-level transfer function (MFRC522_LL_ASYNC in 'definition' mode,
+ * 'submit' operation in 'pointer' mode) and returns at once, so that the bus transfer may run in the background (e.g.
+ * using DMA). 'cb' is invoked from low-level completion context once the transfer is done. If low-level layer does
+ * not support asynchronous transfers, the write is performed at once and 'cb' is invoked before the function returns.
+ *
+ * Payload buffer must stay valid until 'cb' is invoked. Shadowed value of the register is dropped when the write is
+ * submitted, so register shadow cache is never accessed from completion context.
+ *
+ * @param conf Pointer to a configuration structure.
+ * @param req Pointer to a request structure. Must stay valid until 'cb' is invoked.
+ * @param addr Register address.
+ * @param sz Number of bytes to write.
+ * @param payload Bytes to write.
+ * @param cb Completion callback.
+ * @param arg User argument passed to completion callback.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_ll_err if low-level layer did not accept the transfer. 'cb' is not invoked then
+ *         - mfrc522_drv_status_ok if the write was started
+ */
+mfrc522_drv_status
+mfrc522_drv_write_async(const mfrc522_drv_conf* conf, mfrc522_drv_async_req* req, mfrc522_reg addr, size sz,
+                        const u8* payload, mfrc522_drv_async_cb cb, void* arg);
+
+/**
+ * Start asynchronous read of multiple bytes from the same PCD's register.
+ *
+ * The function works in the same way as 'mfrc522_drv_write_async()'. Payload buffer is filled when 'cb' is invoked
+ * with mfrc522_drv_status_ok status.
+ *
+ * @param conf Pointer to a configuration structure.
+ * @param req Pointer to a request structure. Must stay valid until 'cb' is invoked.
+ * @param addr Register address.
+ * @param sz Number of bytes to read.
+ * @param payload Pointer to a buffer where incoming bytes are written. Must be big enough to store 'sz' bytes.
+ * @param cb Completion callback.
+ * @param arg User argument passed to completion callback.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_ll_err if low-level layer did not accept the transfer. 'cb' is not invoked then
+ *         - mfrc522_drv_status_ok if the read was started
+ */
+mfrc522_drv_status
+mfrc522_drv_read_mul_async(const mfrc522_drv_conf* conf, mfrc522_drv_async_req* req, mfrc522_reg addr, size sz,
+                           u8* payload, mfrc522_drv_async_cb cb, void* arg);
+
+/**
+ * Start asynchronous read from a PCD's register. See 'mfrc522_drv_read_mul_async()' for details.
+ *
+ * @param conf Pointer to a configuration structure.
+ * @param req Pointer to a request structure. Must stay valid until 'cb' is invoked.
+ * @param addr Register address.
+ * @param payload Pointer to a buffer where incoming byte is written.
+ * @param cb Completion callback.
+ * @param arg User argument passed to completion callback.
+ * @return Status of the operation. On success mfrc522_drv_status_ok is returned.
+ */
+static inline mfrc522_drv_status
+mfrc522_drv_read_async(const mfrc522_drv_conf* conf, mfrc522_drv_async_req* req, mfrc522_reg addr, u8* payload,
+                       mfrc522_drv_async_cb cb, void* arg)
+{
+    return mfrc522_drv_read_mul_async(conf, req, addr, 1, payload, cb, arg);
+}
+
 /**
  * Store single byte in the FIFO buffer.
  *
@@ -397,7 +769,7 @@ mfrc522_drv_fifo_store(const mfrc522_drv_conf* conf, u8 byte)
  * @return 'mfrc522_drv_status_ok' on success, 'mfrc522_drv_status_ll_err' on failure.
  */
 static inline mfrc522_drv_status
-mfrc522_drv_fifo_store_mul(const mfrc522_drv_conf* conf, u8* bytes, size sz)
+mfrc522_drv_fifo_store_mul(const mfrc522_drv_conf* conf, const u8* bytes, size sz)
 {
     return mfrc522_drv_write(conf, mfrc522_reg_fifo_data, sz, bytes);
 }
@@ -418,6 +790,23 @@ mfrc522_drv_fifo_read(const mfrc522_drv_conf* conf, u8* out)
     return mfrc522_drv_read(conf, mfrc522_reg_fifo_data, out);
 }
 
+/**
+ * Read multiple bytes from the FIFO buffer.
+ *
+ * Call to this function is valid only when FIFO buffer contains at least 'sz' bytes inside.
+ * Otherwise garbage values may be returned.
+ *
+ * @param conf Pointer to a device configuration structure.
+ * @param out Buffer to write output bytes to.
+ * @param sz The number of bytes to be read.
+ * @return 'mfrc522_drv_status_ok' on success, 'mfrc522_drv_status_ll_err' on failure.
+ */
+static inline mfrc522_drv_status
+mfrc522_drv_fifo_read_mul(const mfrc522_drv_conf* conf, u8* out, size sz)
+{
+    return mfrc522_drv_read_mul(conf, mfrc522_reg_fifo_data, sz, out);
+}
+
 /**
  * Flush the FIFO buffer.
  *
@@ -438,6 +827,18 @@ mfrc522_drv_fifo_flush(const mfrc522_drv_conf* conf)
  * by setting 'retry_cnt' field to MFRC522_DRV_RETRY_CNT_INF. The real number of retries may vary, depending on
  * MFRC522_CONF_RETRY_CNT_MUL configuration macro, when MFRC522_LL_DELAY macro is not enabled.
  *
+ * Polling policy is tuned by the remaining fields. If an operation is known to take some time, 'first_delay' postpones
+ * the first read, so the register is not read while the device is surely busy. If 'max_delay' is greater than 'delay',
+ * the delay between reads starts at 'delay' and doubles after each retry until reaching 'max_delay'. Thus short
+ * operations are detected quickly, while long ones do not keep the bus busy. Setting all of them to zero gives fixed
+ * delay between reads.
+ *
+ * Non-zero 'timeout' bounds total time of the call. The time is measured by low-level monotonic clock ('now' operation
+ * or 'mfrc522_ll_now()' if MFRC522_LL_CLOCK is set). If the clock is not available, delays requested so far are summed
+ * up instead, unless MFRC522_LL_DELAY is disabled - the deadline is ignored then. The deadline and the retry count are
+ * checked independently, the one reached first ends the call. Set 'retry_cnt' to MFRC522_DRV_RETRY_CNT_INF to rely on
+ * the deadline only.
+ *
  * After the operation, recent payload is kept in 'payload' field. Its validity depends on status code returned.
  * The function does nothing when either 'conf' or 'ru_conf' parameter is NULL.
  *
@@ -446,16 +847,148 @@ mfrc522_drv_fifo_flush(const mfrc522_drv_conf* conf)
  * @return Status code of the operation. Valid responses are:
  *         - mfrc522_drv_status_nullptr if either 'conf' or 'ru_conf' parameter is NULL
  *         - mfrc522_drv_status_ll_err when low-level call failed
- *         - mfrc522_drv_status_dev_rtr_err when maximum number of retries was reached
+ *         - mfrc522_drv_status_dev_rtr_err when maximum number of retries or the deadline was reached
  *         - mfrc522_drv_status_ok on success
  */
 mfrc522_drv_status
 mfrc522_drv_read_until(const mfrc522_drv_conf* conf, mfrc522_drv_read_until_conf* ru_conf);
 
+/**
+ * Check if a register can be kept in register shadow cache.
+ *
+ * Registers that may be modified by a device itself (e.g. ComIrqReg, FIFOLevelReg, Status1Reg), read-only registers
+ * and reserved ones are never shadowed.
+ *
+ * @param addr Register address.
+ * @return True if the register can be shadowed, false otherwise.
+ */
+bool
+mfrc522_drv_reg_cacheable(mfrc522_reg addr);
+
+/**
+ * Attach register shadow cache to a configuration structure.
+ *
+ * The cache is an explicit opt-in: it is used only after this call and all of its entries start invalidated. Since
+ * 'mfrc522_drv_init()' detaches the cache, the function has to be called after device initialization. Passing NULL
+ * instead of a valid 'cache' pointer detaches the cache.
+ *
+ * @param conf Pointer to a configuration structure.
+ * @param cache Pointer to register shadow cache. Can be NULL.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid 'conf' pointer
+ *         - mfrc522_drv_status_ok on success
+ */
+mfrc522_drv_status
+mfrc522_drv_reg_cache_attach(mfrc522_drv_conf* conf, mfrc522_drv_reg_cache* cache);
+
+/**
+ * Invalidate register shadow cache.
+ *
+ * The function shall be called whenever registers might have been changed without the driver's knowledge, e.g. after
+ * a hard reset or a power loss. Nothing is done when register shadow cache is not used.
+ * An error code is returned when NULL was passed instead of a valid 'conf' pointer.
+ *
+ * @param conf Pointer to a configuration structure.
+ * @return An instance of 'mfrc522_drv_status'. On success, mfrc522_drv_status_ok is returned.
+ */
+mfrc522_drv_status
+mfrc522_drv_reg_cache_invalidate(const mfrc522_drv_conf* conf);
+
+/**
+ * Take a snapshot of configuration registers.
+ *
+ * All registers are read as a single scatter-gather batch. When register shadow cache is used, it is updated with
+ * the values read.
+ *
+ * @param conf Pointer to a configuration structure.
+ * @param snap Snapshot to be filled.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_ll_err on low-level error
+ *         - mfrc522_drv_status_ok on success
+ */
+mfrc522_drv_status
+mfrc522_drv_snapshot(const mfrc522_drv_conf* conf, mfrc522_drv_reg_snapshot* snap);
+
+/**
+ * Write configuration registers back to a device.
+ *
+ * All registers of a snapshot are written as a single scatter-gather batch, e.g. to recover from a brown-out or a soft
+ * reset without replaying the whole initialization sequence. Commands and FIFO are not affected.
+ *
+ * @param conf Pointer to a configuration structure.
+ * @param snap Snapshot to be restored.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_ll_err on low-level error
+ *         - mfrc522_drv_status_ok on success
+ */
+mfrc522_drv_status
+mfrc522_drv_restore(const mfrc522_drv_conf* conf, const mfrc522_drv_reg_snapshot* snap);
+
+/**
+ * Compare a snapshot against a reference one.
+ *
+ * No device access is performed. Together with 'mfrc522_drv_snapshot()' it can be used to detect configuration
+ * drift.
+ *
+ * @param snap Snapshot to be checked.
+ * @param ref Reference snapshot.
+ * @param diff Bitmask of registers whose values differ. Bit n stands for register n.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_ok on success
+ */
+mfrc522_drv_status
+mfrc522_drv_snapshot_diff(const mfrc522_drv_reg_snapshot* snap, const mfrc522_drv_reg_snapshot* ref, u64* diff);
+
+/**
+ * Get a value of a register from a snapshot.
+ *
+ * @param snap Snapshot.
+ * @param addr Register address.
+ * @param val Value of the register.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_nok when the register is not captured by snapshots
+ *         - mfrc522_drv_status_ok on success
+ */
+mfrc522_drv_status
+mfrc522_drv_snapshot_get(const mfrc522_drv_reg_snapshot* snap, mfrc522_reg addr, u8* val);
+
+/**
+ * Execute a register script.
+ *
+ * The function executes a sequence of register operations created with MFRC522_DRV_SCRIPT_* macros. Writes are
+ * collected and passed to the low-level layer as a single scatter-gather batch, so that a backend is able to merge them
+ * into one bus message. Registers modified with masked writes are read at most once per script: host-owned registers
+ * are read up front in one batch (or taken from register shadow cache), the others right before being written. A batch
+ * is also sent prior to every poll operation. Consecutive writes of the same host-owned register are merged into one.
+ *
+ * A write to CommandReg (e.g. SoftReset) is a barrier: the batch is sent right after it and host-owned registers
+ * modified behind it are read again, so that entries are never reordered across a command and masked writes following
+ * a reset are computed from reset values.
+ *
+ * In a case when either 'conf' or 'script' is NULL, mfrc522_drv_status_nullptr is returned.
+ *
+ * @param conf Pointer to a configuration structure.
+ * @param script Array of script entries.
+ * @param sz Number of script entries.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_nok when unknown operation was found
+ *         - mfrc522_drv_status_ll_err on low-level error
+ *         - mfrc522_drv_status_dev_rtr_err when poll operation ran out of retries
+ *         - mfrc522_drv_status_ok on success
+ */
+mfrc522_drv_status
+mfrc522_drv_script_exec(const mfrc522_drv_conf* conf, const mfrc522_drv_script_entry* script, size sz);
+
 /**
  * Perform soft reset on a PCD.
  *
  * Note that the function does not wait until currently active command terminates.
+ * Register shadow cache is invalidated, since all registers are set to their reset values.
  * An error code is returned when NULL was passed instead of a valid 'conf' pointer.
  *
  * @param conf Pointer to a configuration structure.
@@ -470,7 +1003,8 @@ mfrc522_drv_soft_reset(const mfrc522_drv_conf* conf);
  * The function performs initialization of 'tim_conf' fields according to 'period' parameter.
  * Minimum timer period equals to 1ms.
  * Maximum timer period is limited by MFRC522_DRV_TIM_MAX_PERIOD macro.
- * Note that the function does not modify all fields, e.g. periodicity flag has to be set manually.
+ * Note that the function does not modify all fields, e.g. periodicity and automatic start flags have to be set
+ * manually.
  *
  * The function returns error when NUll was passed instead of a 'tim_conf' pointer.
  *
@@ -488,6 +1022,8 @@ mfrc522_drv_tim_set(mfrc522_drv_tim_conf* tim_conf, u16 period);
  * Start MFRC522 timer.
  *
  * The configuration structure passed as 'tim_conf' parameter has to be initialized prior to calling this function.
+ * The timer starts immediately, unless automatic start flag is set. In such case it starts at the end of the next
+ * transmission and stops once a response is being received.
  * The function returns error code when NULL was passed instead of a valid pointer.
  *
  * @param conf Pointer to a MFRC522 configuration structure.
@@ -596,6 +1132,36 @@ mfrc522_drv_irq_pending(u16 irq_states, mfrc522_reg_irq irq);
 mfrc522_drv_status
 mfrc522_drv_self_test(mfrc522_drv_conf* conf);
 
+/**
+ * Bring up MFRC522 device.
+ *
+ * The function replaces a sequence of 'mfrc522_drv_init()', 'mfrc522_drv_soft_reset()', optional
+ * 'mfrc522_drv_self_test()' and initialization functions of particular modules. Chip version, CommandReg and current
+ * values of all registers of the image are read in one batch. When the device is idle and already holds the image, for
+ * example after a restart of a host process, neither a reset nor any write is performed and 'warm' is set. Otherwise
+ * the device is reset (with a self test if requested) and the image is written as a register script, i.e. in one batch
+ * as long as it consists of plain writes. Unlike 'mfrc522_drv_init()', the function keeps register shadow cache
+ * attached beforehand with 'mfrc522_drv_reg_cache_attach()'. On success the cache (if used) holds the values of the
+ * image.
+ *
+ * The image may contain write and masked write entries of host-owned registers only (refer to
+ * 'mfrc522_drv_reg_cacheable()'), otherwise mfrc522_drv_status_nok is returned before any access to the device.
+ *
+ * @param conf Pointer to a configuration structure. Mandatory fields have to be set as for 'mfrc522_drv_init()'.
+ * @param bu_conf Bring-up settings.
+ * @param warm Set to true if the device was found already configured, false otherwise.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_nok when the image contains invalid entries
+ *         - mfrc522_drv_status_ll_err on low-level error or unsupported version of 'll_ops' table
+ *         - mfrc522_drv_status_dev_err when valid device is not found
+ *         - mfrc522_drv_status_dev_rtr_err when the device did not come back from reset
+ *         - mfrc522_drv_status_self_test_err when self test failed
+ *         - mfrc522_drv_status_ok on success
+ */
+mfrc522_drv_status
+mfrc522_drv_bringup(mfrc522_drv_conf* conf, const mfrc522_drv_bringup_conf* bu_conf, bool* warm);
+
 /**
  * Invoke a MFRC522 command.
  *
@@ -676,6 +1242,35 @@ mfrc522_drv_check_error(u8 error_reg, mfrc522_reg_err err);
  * actual demands. Call higher level APIs instead that populates the fields of 'mfrc522_drv_transceive_conf' struct
  * in the right way.
  *
+ * When low-level layer provides IRQ wait function, only RxIRq, IdleIRq and ErrIRq interrupts are routed to IRQ pin for
+ * the duration of the command and the driver sleeps on the pin instead of polling IRQ registers. Pin polarity set by
+ * 'mfrc522_drv_irq_init()' is kept, other interrupt enable bits are restored afterwards. A wake-up without any of
+ * these interrupts pending (e.g. a stale edge) makes the driver wait again for the rest of the time budget.
+ *
+ * When 'timeout' field is set, the timer is started automatically at the end of transmission and the command times out
+ * once TimerIRq is raised, i.e. after exactly the frame waiting time. Previous timer settings are overwritten then.
+ *
+ * TX data may end with an incomplete byte, in which case 'tx_last_bits' tells how many of its bits are transmitted.
+ * Received bits are stored in the FIFO buffer starting with bit position 'rx_align'. Both fields are written to
+ * BitFramingReg for the duration of the command only.
+ *
+ * By default exactly 'rx_data_sz' whole bytes have to be received. When 'rx_var_len' is set, the response may be of any
+ * length up to 'rx_data_sz' bytes, e.g. ATS or a 4-bit ACK. Actual length is reported by 'rx_len' and 'rx_last_bits'
+ * fields in both cases. Longer responses result in mfrc522_drv_status_transceive_rx_mism. CRC bytes left in the FIFO
+ * buffer by the device are counted in 'rx_len' in variable length mode.
+ *
+ * When 'hw_crc' field is set, TxCRCEn and RxCRCEn bits are set for the duration of the command, so the device appends
+ * CRC_A to transmitted data and checks it in received data. CRC bytes left in the FIFO buffer are not copied to
+ * RX data. If the received CRC is wrong, mfrc522_drv_status_crc_err is returned instead of
+ * mfrc522_drv_status_transceive_err.
+ *
+ * In variable length mode a bit collision results in mfrc522_drv_status_collision instead of
+ * mfrc522_drv_status_transceive_err. Bits received so far are stored in RX data then and position of the collided bit
+ * is reported by 'coll_pos'. Values of the collided bit and the following ones are undefined.
+ *
+ * Registers modified for the duration of the command are restored also when polling or waiting for IRQ pin fails with
+ * a low-level error. If they cannot be restored either, their values are dropped from register shadow cache.
+ *
  * @param conf Pointer to a device configuration struct.
  * @param tr_conf Pointer to a transceive configuration struct.
  * @return Status of the operation. On success 'mfrc522_drv_status_ok' is returned.
@@ -683,6 +1278,76 @@ mfrc522_drv_check_error(u8 error_reg, mfrc522_reg_err err);
 mfrc522_drv_status
 mfrc522_drv_transceive(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_conf* tr_conf);
 
+/**
+ * Start non-blocking transceive operation.
+ *
+ * The function does the same as the first part of 'mfrc522_drv_transceive()': TX data is stored and the command is
+ * invoked, but the function returns without waiting for completion. The operation moves to 'busy' state then and
+ * 'mfrc522_drv_transceive_poll()' shall be called until it completes. Interrupt enable bits are left untouched, see
+ * 'mfrc522_drv_transceive_irq_en()' to get IRQ pin activated on completion.
+ *
+ * TX data is sent during the call, whereas RX buffer pointed by 'tr_conf' has to be valid until the operation is
+ * finished. The operation does not need to be initialized before the call. Any previous content is overwritten.
+ *
+ * @param conf Pointer to a device configuration struct.
+ * @param op Pointer to an operation instance.
+ * @param tr_conf Pointer to a transceive configuration struct. The struct is copied into the operation.
+ * @return Status of the operation. On success 'mfrc522_drv_status_ok' is returned.
+ */
+mfrc522_drv_status
+mfrc522_drv_transceive_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op,
+                             const mfrc522_drv_transceive_conf* tr_conf);
+
+/**
+ * Poll non-blocking transceive operation.
+ *
+ * Interrupt registers are read once per call. The operation moves to 'done' state when the command completes, fails or
+ * times out. Recommended delay between subsequent calls is stored in 'poll_delay' field of the operation.
+ *
+ * If low-level monotonic clock is available, the command times out when its time budget is exhausted (refer to
+ * MFRC522_CONF_DEADLINE_TRANSCEIVE), regardless of the number of polls. Otherwise the timeout is counted in polls when
+ * 'timeout' field of transceive configuration is zero, hence the delay shall be kept then.
+ *
+ * @param conf Pointer to a device configuration struct.
+ * @param op Pointer to an operation instance.
+ * @return Status of the operation. Valid return codes are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_nok if the operation was not started
+ *         - mfrc522_drv_status_ll_err on low-level error. The operation moves to 'done' state then
+ *         - mfrc522_drv_status_in_progress if the command is still being executed
+ *         - mfrc522_drv_status_ok if the operation is done and 'mfrc522_drv_transceive_finish()' can be called
+ */
+mfrc522_drv_status
+mfrc522_drv_transceive_poll(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op);
+
+/**
+ * Finish non-blocking transceive operation.
+ *
+ * The function ends the command, enters Idle state and collects RX data. The operation moves back to 'idle' state.
+ * Length of RX data is stored in output fields of the configuration copy, i.e. 'op->tr_conf.rx_len'.
+ *
+ * @param conf Pointer to a device configuration struct.
+ * @param op Pointer to an operation instance.
+ * @return Status of the operation. 'mfrc522_drv_status_nok' is returned if the operation is not done yet. Otherwise
+ *         the function returns the same codes as 'mfrc522_drv_transceive()'.
+ */
+mfrc522_drv_status
+mfrc522_drv_transceive_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op);
+
+/**
+ * Enable or disable interrupts completing non-blocking transceive operations.
+ *
+ * The function enables RxIRq, IdleIRq, ErrIRq and TimerIRq by means of 'mfrc522_drv_irq_en()', so IRQ pin is activated
+ * whenever an operation is ready to be polled. Pin polarity shall be set by 'mfrc522_drv_irq_init()' beforehand.
+ * It allows to wait for many devices at once, e.g. with event sources provided by 'mfrc522_ll_event.h'.
+ *
+ * @param conf Pointer to a device configuration struct.
+ * @param enable True to enable interrupts, false to disable them.
+ * @return Status of the operation. On success 'mfrc522_drv_status_ok' is returned.
+ */
+mfrc522_drv_status
+mfrc522_drv_transceive_irq_en(const mfrc522_drv_conf* conf, bool enable);
+
 /**
  * Initialize contactless external interfaces (contactless UART, analog interface).
  *
@@ -753,6 +1418,61 @@ mfrc522_drv_anticollision(const mfrc522_drv_conf* conf, u8* serial);
 mfrc522_drv_status
 mfrc522_drv_select(const mfrc522_drv_conf* conf, const u8* serial, u8* sak);
 
+/**
+ * Get UID of a PICC and select it, going through as many cascade levels as needed.
+ *
+ * For each cascade level (CL1, CL2, CL3) ANTICOLLISION and SELECT frames are exchanged. Cascade tag and cascade bit of
+ * SAK decide whether UID is complete, so single (4 bytes), double (7 bytes) and triple (10 bytes) size UIDs are
+ * supported. When 'sz' field of 'uid' is set on input (e.g. a PICC is selected again after HLTA), the UID is taken as
+ * known and only SELECT frames are sent, i.e. a single RF exchange per cascade level. Otherwise the UID is stored in
+ * 'uid' on success. Final SAK is stored in either case.
+ *
+ * The function has to be called after ATQA response was collected during REQA or WUPA command. When several PICCs
+ * answer ANTICOLLISION, the position of the first collided bit is read from CollReg, the bit is chosen to be one and
+ * the frame is sent again with all bits known so far (a partial byte frame), which silences PICCs not matching them.
+ * Each collision costs one additional RF exchange. Finally the PICC with the highest UID bits at collided positions is
+ * selected, the others go back to IDLE state.
+ *
+ * @param conf Device configuration structure.
+ * @param uid UID of a PICC. Set 'sz' field to zero if UID is not known.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_nok when size of a known UID is invalid
+ *         - mfrc522_drv_status_anticoll_chksum_err when BCC of UID CLn is invalid
+ *         - mfrc522_drv_status_cascade_err when cascade tag or SAK is inconsistent with UID size
+ *         - mfrc522_drv_status_crc_err when CRC of SAK is invalid
+ *         - mfrc522_drv_status_collision when a collision cannot be resolved (e.g. collided bits of BCC)
+ *         - other codes returned by 'mfrc522_drv_transceive()'
+ *         - mfrc522_drv_status_ok on success
+ */
+mfrc522_drv_status
+mfrc522_drv_select_uid(const mfrc522_drv_conf* conf, mfrc522_picc_uid* uid);
+
+/**
+ * Enumerate all PICCs in RF field.
+ *
+ * REQA is sent, a single PICC is selected by 'mfrc522_drv_select_uid()' and put into HALT state by HLTA. Halted PICCs
+ * do not answer REQA any more, so the sequence repeats until no PICC answers or 'max' UIDs are collected. The latter is
+ * not an error: the remaining PICCs are left in IDLE state and another call enumerates them. To enumerate PICCs again,
+ * use WUPA or reset RF field (e.g. by antenna off and on).
+ *
+ * An unresolved collision or a PICC leaving RF field in the middle of the sequence aborts the enumeration. In such case
+ * 'found' tells how many UIDs were collected (and halted) before.
+ *
+ * The CRC coprocessor has to be initialized prior to calling this function.
+ *
+ * @param conf Device configuration structure.
+ * @param uids Array of at least 'max' elements to store UIDs and SAKs of PICCs in.
+ * @param max Maximum number of PICCs to enumerate.
+ * @param found Number of stored UIDs.
+ * @return Status of the operation. Valid responses are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - codes returned by 'mfrc522_drv_reqa()', 'mfrc522_drv_select_uid()' and 'mfrc522_drv_halt()'
+ *         - mfrc522_drv_status_ok on success
+ */
+mfrc522_drv_status
+mfrc522_drv_inventory(const mfrc522_drv_conf* conf, mfrc522_picc_uid* uids, size max, size* found);
+
 /**
  * Authenticate PICC block.
  *
@@ -782,6 +1502,222 @@ mfrc522_drv_authenticate(const mfrc522_drv_conf* conf, const mfrc522_drv_auth_co
 mfrc522_drv_status
 mfrc522_drv_halt(const mfrc522_drv_conf* conf);
 
+/**
+ * Start non-blocking REQA command. See 'mfrc522_drv_reqa()' for details.
+ *
+ * The operation shall be driven by 'mfrc522_drv_transceive_poll()' and completed by 'mfrc522_drv_reqa_finish()'.
+ *
+ * @param conf Device configuration.
+ * @param op Operation instance.
+ * @return Status of the operation. On success 'mfrc522_drv_status_ok' is returned.
+ */
+mfrc522_drv_status
+mfrc522_drv_reqa_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op);
+
+/**
+ * Finish non-blocking REQA command.
+ *
+ * @param conf Device configuration.
+ * @param op Operation instance in 'done' state.
+ * @param atqa 2-byte output buffer to store ATQA response.
+ * @return Status of the operation. The same codes as in case of 'mfrc522_drv_reqa()' are returned.
+ *         'mfrc522_drv_status_nok' is returned if the operation is not done yet.
+ */
+mfrc522_drv_status
+mfrc522_drv_reqa_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op, u16* atqa);
+
+/**
+ * Start non-blocking anticollision procedure. See 'mfrc522_drv_anticollision()' for details.
+ *
+ * @param conf Device configuration.
+ * @param op Operation instance.
+ * @return Status of the operation. On success 'mfrc522_drv_status_ok' is returned.
+ */
+mfrc522_drv_status
+mfrc522_drv_anticollision_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op);
+
+/**
+ * Finish non-blocking anticollision procedure.
+ *
+ * @param conf Device configuration.
+ * @param op Operation instance in 'done' state.
+ * @param serial Output buffer where 5 bytes of serial data will be stored.
+ * @return Status of the operation. The same codes as in case of 'mfrc522_drv_anticollision()' are returned.
+ *         'mfrc522_drv_status_nok' is returned if the operation is not done yet.
+ */
+mfrc522_drv_status
+mfrc522_drv_anticollision_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op, u8* serial);
+
+/**
+ * Start non-blocking selection of a PICC. See 'mfrc522_drv_select()' for details.
+ *
+ * CRC of the frame is computed by the coprocessor before the function returns.
+ *
+ * @param conf Device configuration.
+ * @param op Operation instance.
+ * @param serial Serial data of a PICC.
+ * @return Status of the operation. On success 'mfrc522_drv_status_ok' is returned.
+ */
+mfrc522_drv_status
+mfrc522_drv_select_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op, const u8* serial);
+
+/**
+ * Finish non-blocking selection of a PICC.
+ *
+ * @param conf Device configuration.
+ * @param op Operation instance in 'done' state.
+ * @param sak Buffer to store SAK response in.
+ * @return Status of the operation. The same codes as in case of 'mfrc522_drv_select()' are returned.
+ *         'mfrc522_drv_status_nok' is returned if the operation is not done yet.
+ */
+mfrc522_drv_status
+mfrc522_drv_select_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op, u8* sak);
+
+/**
+ * Start non-blocking authentication of PICC block. See 'mfrc522_drv_authenticate()' for details.
+ *
+ * @param conf Device configuration.
+ * @param op Operation instance.
+ * @param auth_conf Authentication parameters. Not referenced after the call.
+ * @return Status of the operation. On success 'mfrc522_drv_status_ok' is returned.
+ */
+mfrc522_drv_status
+mfrc522_drv_authenticate_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op,
+                               const mfrc522_drv_auth_conf* auth_conf);
+
+/**
+ * Finish non-blocking authentication of PICC block.
+ *
+ * @param conf Device configuration.
+ * @param op Operation instance in 'done' state.
+ * @return Status of the operation. The same codes as in case of 'mfrc522_drv_authenticate()' are returned.
+ *         'mfrc522_drv_status_nok' is returned if the operation is not done yet.
+ */
+mfrc522_drv_status
+mfrc522_drv_authenticate_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op);
+
+/**
+ * Start non-blocking halt of a PICC. See 'mfrc522_drv_halt()' for details.
+ *
+ * @param conf Device configuration.
+ * @param op Operation instance.
+ * @return Status of the operation. On success 'mfrc522_drv_status_ok' is returned.
+ */
+mfrc522_drv_status
+mfrc522_drv_halt_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op);
+
+/**
+ * Finish non-blocking halt of a PICC.
+ *
+ * @param conf Device configuration.
+ * @param op Operation instance in 'done' state.
+ * @return Status of the operation. The same codes as in case of 'mfrc522_drv_halt()' are returned.
+ *         'mfrc522_drv_status_nok' is returned if the operation is not done yet.
+ */
+mfrc522_drv_status
+mfrc522_drv_halt_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op);
+
+/**
+ * Configure a device for card presence probing.
+ *
+ * The device is left in Transceive state with BitFramingReg set for 7-bit frames, while the timer is armed to start
+ * automatically at the end of transmission and to expire after ISO/IEC 14443-3 frame waiting time. This way each
+ * 'mfrc522_drv_probe()' call only starts transmission and collects a response. Previous values of CommandReg and
+ * BitFramingReg are stored in the probe context. Timer settings are overwritten.
+ *
+ * No other command shall be executed by the device until 'mfrc522_drv_probe_deinit()' is called.
+ *
+ * @param conf Device configuration.
+ * @param probe Pointer to a probe context. The context does not need to be initialized before the call.
+ * @param frame Short frame used to probe PICCs. Valid ones are 'mfrc522_picc_cmd_reqa' and 'mfrc522_picc_cmd_wupa'.
+ * @return Status of the operation. 'mfrc522_drv_status_nok' is returned if the frame is not valid.
+ */
+mfrc522_drv_status
+mfrc522_drv_probe_init(const mfrc522_drv_conf* conf, mfrc522_drv_probe_ctx* probe, mfrc522_picc_cmd frame);
+
+/**
+ * Check whether a PICC is present in RF field.
+ *
+ * The function is a fast path of 'mfrc522_drv_reqa()' meant for high-rate polling loops. Transmission is started by
+ * a single batch of writes, then only ComIrqReg is polled and a response is fetched by a single batch of reads.
+ *
+ * A PICC is present if anything was received, including a collision of responses of several PICCs. ATQA is valid only
+ * if exactly 2 bytes were received, otherwise MFRC522_PICC_ATQA_INV is returned. A PICC which answered the previous
+ * probe stays in READY state and takes the next REQA or WUPA as an unexpected frame: it goes back to IDLE state without
+ * answering. Hence if nothing is received after a positive probe, the frame is sent once again. This way a PICC left
+ * in the field is reported by every probe, at the cost of an extra frame waiting time per probe. The same applies to
+ * the first probe after 'mfrc522_drv_probe_init()', since a PICC might have been left in READY or ACTIVE state.
+ *
+ * @param conf Device configuration.
+ * @param probe Pointer to a probe context configured by 'mfrc522_drv_probe_init()'.
+ * @param present Output set if a PICC is present.
+ * @param atqa Output ATQA response.
+ * @return Status of the operation. Valid return codes are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_nok if the probe is not configured
+ *         - mfrc522_drv_status_ll_err on low-level error
+ *         - mfrc522_drv_status_picc_vrf_err if ATQA was rejected by 'atqa_verify_fn'
+ *         - mfrc522_drv_status_ok otherwise, regardless of PICC presence
+ */
+mfrc522_drv_status
+mfrc522_drv_probe(const mfrc522_drv_conf* conf, mfrc522_drv_probe_ctx* probe, bool* present, u16* atqa);
+
+/**
+ * Restore the device configuration changed by 'mfrc522_drv_probe_init()'. The device enters Idle state.
+ *
+ * @param conf Device configuration.
+ * @param probe Pointer to a probe context.
+ * @return Status of the operation. 'mfrc522_drv_status_nok' is returned if the probe is not configured.
+ */
+mfrc522_drv_status
+mfrc522_drv_probe_deinit(const mfrc522_drv_conf* conf, mfrc522_drv_probe_ctx* probe);
+
+/**
+ * Enter or leave soft power-down mode.
+ *
+ * In soft power-down the oscillator, the receiver and the antenna drivers are switched off, whereas register values
+ * are retained. Thus leaving the mode is a fast resume path: there is no need to initialize the device again. When
+ * leaving the mode, the function returns once the device reports that the wake-up procedure is complete (refer to
+ * MFRC522_CONF_DEADLINE_WAKE_UP). Any command in progress is terminated when the mode is entered.
+ *
+ * @param conf Device configuration.
+ * @param enable Set to enter soft power-down, clear to leave it.
+ * @return Status of the operation. Valid return codes are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_ll_err on low-level error
+ *         - mfrc522_drv_status_dev_rtr_err if the device did not wake up in time
+ *         - mfrc522_drv_status_ok on success
+ */
+mfrc522_drv_status
+mfrc522_drv_power_down(const mfrc522_drv_conf* conf, bool enable);
+
+/**
+ * Detect a PICC with the device kept in soft power-down most of the time.
+ *
+ * Each cycle consists of soft power-down lasting 'sleep_period', wake-up, 'settle_time' with RF field on and a single
+ * probe done in the same way as by 'mfrc522_drv_probe()'. Hence the fraction of time spent in power-down is roughly
+ * 'sleep_period' / ('sleep_period' + 'settle_time' + frame waiting time). When a PICC is found, the device is left
+ * powered up and the PICC answering WUPA or REQA is in READY state, thus anticollision can follow immediately.
+ * Otherwise the device is left in soft power-down, see 'mfrc522_drv_power_down()' to resume it.
+ *
+ * The function relies on low-level delay function to sleep. RF field has to be configured before, e.g. by
+ * 'mfrc522_drv_ext_itf_init()'. Timer settings are overwritten.
+ *
+ * @param conf Device configuration.
+ * @param lpcd_conf Low-power card detection settings.
+ * @param atqa Output ATQA of the PICC found. MFRC522_PICC_ATQA_INV if responses of several PICCs collided.
+ * @return Status of the operation. Valid return codes are:
+ *         - mfrc522_drv_status_nullptr when NULL is passed instead of a valid pointer
+ *         - mfrc522_drv_status_nok if the frame is not valid or low-level delay function is not available
+ *         - mfrc522_drv_status_ll_err on low-level error
+ *         - mfrc522_drv_status_dev_rtr_err if the device did not wake up in time
+ *         - mfrc522_drv_status_picc_vrf_err if ATQA was rejected by 'atqa_verify_fn'. The device is left powered up
+ *         - mfrc522_drv_status_transceive_timeout if no PICC was found within 'max_cycles' probes
+ *         - mfrc522_drv_status_ok if a PICC was found
+ */
+mfrc522_drv_status
+mfrc522_drv_lpcd(const mfrc522_drv_conf* conf, const mfrc522_drv_lpcd_conf* lpcd_conf, u16* atqa);
+
 #ifdef __cplusplus
 }
 #endif
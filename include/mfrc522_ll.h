@@ -33,6 +33,11 @@ extern "C" {
 #endif
 #define SCOPE_MAGIC 0xE0AA
 
+/**
+ * Current version of low-level operations table
+ */
+#define MFRC522_LL_OPS_VERSION 1
+
 /* ------------------------------------------------------------ */
 /* -------------------------- Data types ---------------------- */
 /* ------------------------------------------------------------ */
@@ -57,17 +62,51 @@ typedef enum mfrc522_ll_status_
     /**
      * An error while configuring low-level interface
      */
-     mfrc522_ll_status_init_err = MAKE_STATUS(0x03, status_severity_fatal)
+     mfrc522_ll_status_init_err = MAKE_STATUS(0x03, status_severity_fatal),
+    /**
+     * Asynchronous transfer cannot be accepted at the moment (e.g. queue of requests is full)
+     */
+     mfrc522_ll_status_busy = MAKE_STATUS(0x04, status_severity_non_critical),
+    /**
+     * An awaited event did not occur within given time
+     */
+     mfrc522_ll_status_timeout = MAKE_STATUS(0x05, status_severity_non_critical)
 } mfrc522_ll_status;
 
+/**
+ * Single transfer being a part of a scatter-gather list.
+ * Exactly one of 'tx' and 'rx' fields shall be set. Receive transfer of several bytes reads the same register
+ * several times in a row.
+ */
+typedef struct mfrc522_ll_xfer_
+{
+    u8 addr; /**< MFRC522 register address */
+    size bytes; /**< Number of bytes to send or receive */
+    const u8* tx; /**< Bytes to send. NULL in case of receive transfer */
+    u8* rx; /**< Buffer for received bytes. NULL in case of send transfer */
+} mfrc522_ll_xfer;
+
+/**
+ * Completion callback of asynchronous transfer.
+ *
+ * The callback is invoked by low-level layer once all transfers passed to asynchronous transfer function are done. It
+ * may be called from a different context than the one the transfers were submitted from (e.g. an interrupt handler or
+ * a worker thread), thus it shall return as fast as possible.
+ *
+ * @param arg User argument passed to asynchronous transfer function.
+ * @param status Status of the transfers. On success mfrc522_ll_status_ok is passed.
+ */
+typedef void (*mfrc522_ll_complete)(void* arg, mfrc522_ll_status status);
+
 #if MFRC522_LL_PTR
 /**
  * Function to initialize low-level interface (bus).
  * Depending on actual needs the function may call start-up routines or do nothing.
  *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
  * @return An instance of mfrc522_ll_status. On success mfrc522_ll_status_ok shall be returned.
  */
-typedef mfrc522_ll_status (*mfrc522_ll_init)(void);
+typedef mfrc522_ll_status (*mfrc522_ll_init)(void* ctx);
 
 /**
  * Low-level send function type.
@@ -76,6 +115,7 @@ typedef mfrc522_ll_status (*mfrc522_ll_init)(void);
  * used. Beneath the function any bus can be used, e.g. SPI, I2C or UART. Please refer to device datasheet to check
  * supported digital interface(s).
  *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
  * @param addr MFRC522 register address.
  * @param bytes Number of payload bytes.
  * @param payload Payload bytes.
@@ -83,7 +123,7 @@ typedef mfrc522_ll_status (*mfrc522_ll_init)(void);
  *         - mfrc522_ll_status_send_err on error
  *         - mfrc522_ll_status_ok on success
  */
-typedef mfrc522_ll_status (*mfrc522_ll_send)(u8 addr, size bytes, const u8* payload);
+typedef mfrc522_ll_status (*mfrc522_ll_send)(void* ctx, u8 addr, size bytes, const u8* payload);
 
 /**
  * Low-level receive function type.
@@ -92,15 +132,68 @@ typedef mfrc522_ll_status (*mfrc522_ll_send)(u8 addr, size bytes, const u8* payl
  * used. Beneath the function any bus can be used, e.g. SPI, I2C or UART. Please refer to device datasheet to check
  * supported digital interface(s).
  *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
  * @param addr MFRC522 register address.
  * @param payload Address of a buffer to store received data.
  * @return An instance of mfrc522_ll_status. Valid return codes are:
  *         - mfrc522_ll_status_recv_err on error
  *         - mfrc522_ll_status_ok on success
  */
-typedef mfrc522_ll_status (*mfrc522_ll_recv)(u8 addr, u8* payload);
+typedef mfrc522_ll_status (*mfrc522_ll_recv)(void* ctx, u8 addr, u8* payload);
+
+/**
+ * Low-level multiple-byte receive function type.
+ *
+ * The function reads the same register several times in a row. Since the device supports such reads within a single
+ * bus transaction (e.g. one chip-select cycle in case of SPI), the function is the preferred way to drain the FIFO
+ * buffer. Please refer to device datasheet to check how repeated reads are handled by particular digital interface.
+ *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
+ * @param addr MFRC522 register address.
+ * @param bytes Number of bytes to receive.
+ * @param payload Address of a buffer to store received data. The buffer must be able to hold 'bytes' bytes.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_recv_err on error
+ *         - mfrc522_ll_status_ok on success
+ */
+typedef mfrc522_ll_status (*mfrc522_ll_recv_mul)(void* ctx, u8 addr, size bytes, u8* payload);
+
+/**
+ * Low-level scatter-gather transfer function type.
+ *
+ * The function performs a sequence of sends and receives as a single batch. Depending on digital interface, the
+ * implementation is free to merge all the transfers into one bus message (e.g. one SPI_IOC_MESSAGE call with
+ * chip-select toggled between transfers). The transfers shall reach a device in the same order as they appear in
+ * 'xfers' array.
+ *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
+ * @param xfers Array of transfers.
+ * @param num Number of transfers.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_send_err or mfrc522_ll_status_recv_err on error
+ *         - mfrc522_ll_status_ok on success
+ */
+typedef mfrc522_ll_status (*mfrc522_ll_transfer_multi)(void* ctx, const mfrc522_ll_xfer* xfers, size num);
+
+/**
+ * Low-level asynchronous transfer function type.
+ *
+ * The function starts a sequence of sends and receives (e.g. using DMA) and returns without waiting for them to
+ * complete. Once the transfers are done, 'complete' callback is invoked. Transfer descriptors and buffers they point to
+ * are owned by the caller and stay valid until the callback is invoked.
+ *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
+ * @param xfers Array of transfers.
+ * @param num Number of transfers.
+ * @param complete Completion callback.
+ * @param arg User argument passed to completion callback.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_busy if the transfers cannot be accepted at the moment. Callback is not invoked then
+ *         - mfrc522_ll_status_ok if the transfers were accepted
+ */
+typedef mfrc522_ll_status (*mfrc522_ll_submit)(void* ctx, const mfrc522_ll_xfer* xfers, size num,
+                                               mfrc522_ll_complete complete, void* arg);
 
-#if MFRC522_LL_DELAY
 /**
  * Low-level delay function type.
  *
@@ -108,10 +201,59 @@ typedef mfrc522_ll_status (*mfrc522_ll_recv)(u8 addr, u8* payload);
  * waiting for an event, thus reducing bus congestion. When disabled, the library pools a device until condition is met,
  * resulting in increased bus workload.
  *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
  * @param period Number of microseconds to sleep.
  */
-typedef void (*mfrc522_ll_delay)(u32 period);
-#endif
+typedef void (*mfrc522_ll_delay)(void* ctx, u32 period);
+
+/**
+ * Low-level IRQ wait function type.
+ *
+ * The function blocks until IRQ pin of a device becomes active or the timeout expires, thus the bus stays free while
+ * the driver waits for an event (e.g. during transceive command). Pin polarity is the one configured via
+ * 'mfrc522_drv_irq_init()'. The function shall return at once if the pin is already active.
+ *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
+ * @param timeout Maximum number of microseconds to wait.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_timeout if the pin did not become active within given time
+ *         - mfrc522_ll_status_recv_err on error
+ *         - mfrc522_ll_status_ok if the pin is active
+ */
+typedef mfrc522_ll_status (*mfrc522_ll_wait_irq)(void* ctx, u32 timeout);
+
+/**
+ * Low-level monotonic clock function type.
+ *
+ * The function returns current time in microseconds. Only differences between subsequent values are used, thus
+ * the counter may start from any value and wrap around.
+ *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
+ * @return Current time in microseconds.
+ */
+typedef u32 (*mfrc522_ll_now)(void* ctx);
+
+/**
+ * Table of low-level operations.
+ *
+ * The table is expected to be constant and outlive all driver instances using it. The driver rejects tables whose
+ * 'version' field differs from MFRC522_LL_OPS_VERSION, thus a table built against an incompatible layout is never used.
+ * Optional operations can be set to NULL, in which case the driver falls back to mandatory ones. The layout does not
+ * depend on configuration macros, so a table can be shared by builds with different settings.
+ */
+typedef struct mfrc522_ll_ops_
+{
+    u32 version; /**< Version of the table. Shall be set to MFRC522_LL_OPS_VERSION */
+    mfrc522_ll_init init; /**< Low-level init function pointer */
+    mfrc522_ll_send send; /**< Low-level send function pointer */
+    mfrc522_ll_recv recv; /**< Low-level receive function pointer */
+    mfrc522_ll_recv_mul recv_mul; /**< Low-level multiple-byte receive function pointer */
+    mfrc522_ll_delay delay; /**< Low-level delay function pointer. Can be NULL unless MFRC522_LL_DELAY is set */
+    mfrc522_ll_transfer_multi transfer_multi; /**< Optional scatter-gather transfer function pointer. Can be NULL */
+    mfrc522_ll_submit submit; /**< Optional asynchronous transfer function pointer. Can be NULL */
+    mfrc522_ll_wait_irq wait_irq; /**< Optional IRQ wait function pointer. Can be NULL */
+    mfrc522_ll_now now; /**< Optional monotonic clock function pointer. Can be NULL */
+} mfrc522_ll_ops;
 
 #endif
 
@@ -124,10 +266,11 @@ typedef void (*mfrc522_ll_delay)(u32 period);
  * Function to initialize low-level interface (bus).
  * Depending on actual needs the function may call start-up routines or do nothing.
  *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
  * @return An instance of mfrc522_ll_status. On success mfrc522_ll_status_ok shall be returned.
  */
 mfrc522_ll_status
-mfrc522_ll_init(void);
+mfrc522_ll_init(void* ctx);
 
 /**
  * Low-level function to send data to a device.
@@ -136,6 +279,7 @@ mfrc522_ll_init(void);
  * interface is used. Beneath the function any bus can be used, e.g. SPI, I2C or UART. Please refer to device datasheet
  * to check supported digital interface(s).
  *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
  * @param addr MFRC522 register address.
  * @param bytes Number of payload bytes.
  * @param payload Payload bytes.
@@ -144,7 +288,7 @@ mfrc522_ll_init(void);
  *         - mfrc522_ll_status_ok on success
  */
 mfrc522_ll_status
-mfrc522_ll_send(u8 addr, size bytes, const u8* payload);
+mfrc522_ll_send(void* ctx, u8 addr, size bytes, const u8* payload);
 
 /**
  * Low-level function to receive data from a device.
@@ -153,6 +297,7 @@ mfrc522_ll_send(u8 addr, size bytes, const u8* payload);
  * digital interface is used. Beneath the function any bus can be used, e.g. SPI, I2C or UART. Please refer to device
  * datasheet to check supported digital interface(s).
  *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
  * @param addr MFRC522 register address.
  * @param payload Address of a buffer to store received data.
  * @return An instance of mfrc522_ll_status. Valid return codes are:
@@ -160,7 +305,67 @@ mfrc522_ll_send(u8 addr, size bytes, const u8* payload);
  *         - mfrc522_ll_status_ok on success
  */
 mfrc522_ll_status
-mfrc522_ll_recv(u8 addr, u8* payload);
+mfrc522_ll_recv(void* ctx, u8 addr, u8* payload);
+
+/**
+ * Low-level function to receive multiple bytes from the same register of a device.
+ *
+ * The function reads the same register several times in a row. Since the device supports such reads within a single
+ * bus transaction (e.g. one chip-select cycle in case of SPI), the function is the preferred way to drain the FIFO
+ * buffer. Please refer to device datasheet to check how repeated reads are handled by particular digital interface.
+ *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
+ * @param addr MFRC522 register address.
+ * @param bytes Number of bytes to receive.
+ * @param payload Address of a buffer to store received data. The buffer must be able to hold 'bytes' bytes.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_recv_err on error
+ *         - mfrc522_ll_status_ok on success
+ */
+mfrc522_ll_status
+mfrc522_ll_recv_mul(void* ctx, u8 addr, size bytes, u8* payload);
+
+#if MFRC522_LL_BATCH
+/**
+ * Low-level function to perform a sequence of sends and receives as a single batch.
+ *
+ * Depending on digital interface, the implementation is free to merge all the transfers into one bus message (e.g. one
+ * SPI_IOC_MESSAGE call with chip-select toggled between transfers). The transfers shall reach a device in the same
+ * order as they appear in 'xfers' array. The function has to be defined only when MFRC522_LL_BATCH macro is enabled.
+ * Otherwise the driver performs the transfers one by one using single send and receive functions.
+ *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
+ * @param xfers Array of transfers.
+ * @param num Number of transfers.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_send_err or mfrc522_ll_status_recv_err on error
+ *         - mfrc522_ll_status_ok on success
+ */
+mfrc522_ll_status
+mfrc522_ll_transfer_multi(void* ctx, const mfrc522_ll_xfer* xfers, size num);
+#endif
+
+#if MFRC522_LL_ASYNC
+/**
+ * Low-level function to start a sequence of sends and receives without waiting for them to complete.
+ *
+ * The transfers can be performed in the background (e.g. using DMA). Once they are done, 'complete' callback is
+ * invoked. Transfer descriptors and buffers they point to are owned by the caller and stay valid until the callback is
+ * invoked. The function has to be defined only when MFRC522_LL_ASYNC macro is enabled. Otherwise the driver performs
+ * asynchronous requests synchronously and invokes the callback at once.
+ *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
+ * @param xfers Array of transfers.
+ * @param num Number of transfers.
+ * @param complete Completion callback.
+ * @param arg User argument passed to completion callback.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_busy if the transfers cannot be accepted at the moment. Callback is not invoked then
+ *         - mfrc522_ll_status_ok if the transfers were accepted
+ */
+mfrc522_ll_status
+mfrc522_ll_submit(void* ctx, const mfrc522_ll_xfer* xfers, size num, mfrc522_ll_complete complete, void* arg);
+#endif
 
 #if MFRC522_LL_DELAY
 /**
@@ -168,10 +373,45 @@ mfrc522_ll_recv(u8 addr, u8* payload);
  * waiting for an event, thus reducing bus congestion. When disabled, the library pools a device until condition is met,
  * resulting in increased bus workload.
  *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
  * @param period Number of microseconds to sleep.
  */
 void
-mfrc522_ll_delay(u32 period);
+mfrc522_ll_delay(void* ctx, u32 period);
+#endif
+
+#if MFRC522_LL_IRQ
+/**
+ * Low-level function to wait until IRQ pin of a device becomes active.
+ *
+ * The function blocks until the pin becomes active or the timeout expires, thus the bus stays free while the driver
+ * waits for an event (e.g. during transceive command). Pin polarity is the one configured via 'mfrc522_drv_irq_init()'.
+ * The function has to be defined only when MFRC522_LL_IRQ macro is enabled. Otherwise the driver polls IRQ registers.
+ *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
+ * @param timeout Maximum number of microseconds to wait.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_timeout if the pin did not become active within given time
+ *         - mfrc522_ll_status_recv_err on error
+ *         - mfrc522_ll_status_ok if the pin is active
+ */
+mfrc522_ll_status
+mfrc522_ll_wait_irq(void* ctx, u32 timeout);
+#endif
+
+#if MFRC522_LL_CLOCK
+/**
+ * Low-level monotonic clock function.
+ *
+ * The function returns current time in microseconds. Only differences between subsequent values are used, thus
+ * the counter may start from any value and wrap around. The function has to be defined only when MFRC522_LL_CLOCK
+ * macro is enabled. Otherwise the driver estimates elapsed time by summing up requested delays.
+ *
+ * @param ctx Low-level context of a device, i.e. 'll_ctx' field of driver configuration.
+ * @return Current time in microseconds.
+ */
+u32
+mfrc522_ll_now(void* ctx);
 #endif
 
 #endif
@@ -0,0 +1,125 @@
+#ifndef MFRC522_MFRC522_LL_EVENT_H
+#define MFRC522_MFRC522_LL_EVENT_H
+
+#include "type.h"
+#include "mfrc522_ll.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* ---------------------------- Macros ------------------------ */
+/* ------------------------------------------------------------ */
+
+/**
+ * Default period of timer fallback in microseconds
+ */
+#define MFRC522_LL_EVENT_DEF_POLL_PERIOD 1000
+
+/**
+ * Consumer label of requested GPIO line
+ */
+#define MFRC522_LL_EVENT_CONSUMER "mfrc522"
+
+/* ------------------------------------------------------------ */
+/* -------------------------- Data types ---------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Function used to issue ioctl requests. Has the same semantics as ioctl() system call
+ */
+typedef int (*mfrc522_ll_event_ioctl)(int fd, unsigned long req, void* arg);
+
+/**
+ * Configuration of an event source
+ */
+typedef struct mfrc522_ll_event_conf_
+{
+    const char* chip_path; /**< Path to GPIO character device, e.g. /dev/gpiochip0. NULL selects timer fallback */
+    u32 line; /**< Offset of GPIO line connected to IRQ pin */
+    bool active_low; /**< Set if IRQ pin is active low, i.e. 'irq_signal_inv' was set during IRQ initialization */
+    u32 poll_period; /**< Period of timer fallback in microseconds. Zero selects MFRC522_LL_EVENT_DEF_POLL_PERIOD */
+    mfrc522_ll_event_ioctl ioctl_fn; /**< Function used to issue ioctl requests. NULL selects ioctl() system call */
+} mfrc522_ll_event_conf;
+
+/**
+ * Event source of a single device. Fields are managed by the module, do not modify them manually
+ */
+typedef struct mfrc522_ll_event_
+{
+    int fd; /**< Pollable file descriptor. Negative if the source is closed */
+    bool irq; /**< Set if the descriptor is a GPIO line. Otherwise it is a periodic timer */
+} mfrc522_ll_event;
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Function to open an event source of a device.
+ *
+ * The source is a file descriptor which becomes readable whenever the device may need attention, thus it can be
+ * added to an epoll set shared by many devices. GPIO line connected to IRQ pin is requested from GPIO character device
+ * with edge detection on transitions to active level. If the line is not available, a periodic timer is used instead,
+ * so the device is polled with a given period.
+ *
+ * IRQ pin is driven only by interrupts enabled with 'mfrc522_drv_irq_en()', e.g. by 'mfrc522_drv_transceive_irq_en()'
+ * which enables all interrupts completing non-blocking transceive operation. Once the descriptor is readable, the event
+ * shall be acknowledged by 'mfrc522_ll_event_ack()' and the operation polled by 'mfrc522_drv_transceive_poll()'.
+ *
+ * @param ev Pointer to an event source.
+ * @param conf Pointer to a configuration structure. Not referenced after the call.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_init_err if NULL pointer was passed or neither GPIO line nor the timer can be opened
+ *         - mfrc522_ll_status_ok on success
+ */
+mfrc522_ll_status
+mfrc522_ll_event_open(mfrc522_ll_event* ev, const mfrc522_ll_event_conf* conf);
+
+/**
+ * Function to get a pollable file descriptor of an event source.
+ *
+ * @param ev Pointer to an event source.
+ * @return File descriptor or negative value if NULL was passed or the source is closed.
+ */
+int
+mfrc522_ll_event_fd(const mfrc522_ll_event* ev);
+
+/**
+ * Function to acknowledge pending events. The function never blocks.
+ *
+ * @param ev Pointer to an event source.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_recv_err if NULL pointer was passed, the source is closed or reading failed
+ *         - mfrc522_ll_status_timeout if there was no pending event
+ *         - mfrc522_ll_status_ok if at least one event was acknowledged
+ */
+mfrc522_ll_status
+mfrc522_ll_event_ack(mfrc522_ll_event* ev);
+
+/**
+ * Function to wait for an event and acknowledge it.
+ *
+ * The function has the same semantics as 'wait_irq' low-level operation, thus it can be used to implement it.
+ *
+ * @param ev Pointer to an event source.
+ * @param timeout Maximum time to wait in microseconds.
+ * @return An instance of mfrc522_ll_status. The same codes as in case of 'mfrc522_ll_event_ack()' are returned.
+ */
+mfrc522_ll_status
+mfrc522_ll_event_wait(mfrc522_ll_event* ev, u32 timeout);
+
+/**
+ * Function to close an event source. Does nothing if the source is already closed.
+ *
+ * @param ev Pointer to an event source. Can be NULL.
+ */
+void
+mfrc522_ll_event_close(mfrc522_ll_event* ev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //MFRC522_MFRC522_LL_EVENT_H
@@ -0,0 +1,109 @@
+#ifndef MFRC522_MFRC522_LL_I2CDEV_H
+#define MFRC522_MFRC522_LL_I2CDEV_H
+
+#include "type.h"
+#include "mfrc522_ll.h"
+
+#if !MFRC522_LL_PTR
+#error "MFRC522 driver: i2c-dev backend requires MFRC522_LL_PTR low-level communication method!"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* ---------------------------- Macros ------------------------ */
+/* ------------------------------------------------------------ */
+
+/**
+ * Default 7-bit I2C address of a device. The actual address depends on state of EA and ADR_x pins
+ */
+#define MFRC522_LL_I2CDEV_DEF_ADDR 0x28
+
+/**
+ * Maximum number of I2C messages packed into a single I2C_RDWR call. Write transfer takes one message, whereas read
+ * transfer takes two (register address write followed by data read). Longer batches are split
+ */
+#define MFRC522_LL_I2CDEV_MSG_MAX 42
+
+/**
+ * Size of internal buffer for write messages packed into a single I2C_RDWR call.
+ * A write transfer of N bytes occupies N + 1 bytes (register address is included), a read transfer occupies 1 byte
+ */
+#define MFRC522_LL_I2CDEV_BUF_SZ 512
+
+/* ------------------------------------------------------------ */
+/* -------------------------- Data types ---------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Function used to issue ioctl requests. Has the same semantics as ioctl() system call
+ */
+typedef int (*mfrc522_ll_i2cdev_ioctl)(int fd, unsigned long req, void* arg);
+
+/**
+ * Configuration of i2c-dev backend
+ */
+typedef struct mfrc522_ll_i2cdev_conf_
+{
+    const char* path; /**< Path to i2c-dev device, e.g. /dev/i2c-1 */
+    u8 addr; /**< 7-bit I2C address of a device. Zero selects MFRC522_LL_I2CDEV_DEF_ADDR */
+    mfrc522_ll_i2cdev_ioctl ioctl_fn; /**< Function used to issue ioctl requests. NULL selects ioctl() system call */
+} mfrc522_ll_i2cdev_conf;
+
+/**
+ * Instance of i2c-dev backend. A pointer to the instance shall be passed to the driver as low-level context, i.e.
+ * assigned to 'll_ctx' field of driver configuration. Fields are managed by the backend, do not modify them manually
+ */
+typedef struct mfrc522_ll_i2cdev_
+{
+    int fd; /**< File descriptor of opened device. Negative if no device is opened */
+    mfrc522_ll_i2cdev_conf conf; /**< Configuration of the instance */
+} mfrc522_ll_i2cdev;
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public variables ------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Low-level operations table to be passed to the driver, i.e. assigned to 'll_ops' field of driver configuration.
+ * The table provides scatter-gather transfer function, thus batched register operations are sent in one system call as
+ * a combined transaction (messages joined with repeated START, single STOP at the end). The table is shared by all
+ * instances of the backend, thus several devices can be driven through the same adapter.
+ */
+extern const mfrc522_ll_ops mfrc522_ll_i2cdev_ops;
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Function to set up an instance of i2c-dev backend.
+ *
+ * The function has to be called before the driver is initialized. It only stores the configuration, the device is
+ * opened when low-level init function is called. Initialization fails if the adapter does not support plain I2C
+ * transfers. An instance which has already been opened shall be closed before it is set up again.
+ *
+ * @param dev Pointer to an instance of the backend.
+ * @param conf Pointer to a configuration structure. Path string must outlive the instance.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_init_err if NULL pointer or NULL path were passed
+ *         - mfrc522_ll_status_ok on success
+ */
+mfrc522_ll_status
+mfrc522_ll_i2cdev_setup(mfrc522_ll_i2cdev* dev, const mfrc522_ll_i2cdev_conf* conf);
+
+/**
+ * Function to close i2c-dev device opened by an instance of the backend. Does nothing if no device is opened.
+ *
+ * @param dev Pointer to an instance of the backend. Can be NULL.
+ */
+void
+mfrc522_ll_i2cdev_close(mfrc522_ll_i2cdev* dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //MFRC522_MFRC522_LL_I2CDEV_H
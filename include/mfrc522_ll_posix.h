@@ -0,0 +1,38 @@
+#ifndef MFRC522_MFRC522_LL_POSIX_H
+#define MFRC522_MFRC522_LL_POSIX_H
+
+#include "type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Delay function shared by Linux backends. Sleeps using nanosleep(). Can be assigned to 'delay' field of low-level
+ * operations table.
+ *
+ * @param ctx Low-level context of a device. Not used.
+ * @param period Number of microseconds to sleep.
+ */
+void
+mfrc522_ll_posix_delay(void* ctx, u32 period);
+
+/**
+ * Monotonic clock function shared by Linux backends. Reads CLOCK_MONOTONIC. Can be assigned to 'now' field of
+ * low-level operations table.
+ *
+ * @param ctx Low-level context of a device. Not used.
+ * @return Current time in microseconds. The value wraps around.
+ */
+u32
+mfrc522_ll_posix_now(void* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //MFRC522_MFRC522_LL_POSIX_H
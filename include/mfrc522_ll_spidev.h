@@ -0,0 +1,107 @@
+#ifndef MFRC522_MFRC522_LL_SPIDEV_H
+#define MFRC522_MFRC522_LL_SPIDEV_H
+
+#include "type.h"
+#include "mfrc522_ll.h"
+
+#if !MFRC522_LL_PTR
+#error "MFRC522 driver: spidev backend requires MFRC522_LL_PTR low-level communication method!"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* ---------------------------- Macros ------------------------ */
+/* ------------------------------------------------------------ */
+
+/**
+ * Default SPI clock frequency in Hz. MFRC522 supports up to 10 Mbit/s
+ */
+#define MFRC522_LL_SPIDEV_DEF_SPEED 4000000
+
+/**
+ * Maximum number of transfers packed into a single SPI_IOC_MESSAGE call. Longer batches are split
+ */
+#define MFRC522_LL_SPIDEV_XFER_MAX 32
+
+/**
+ * Size of internal TX and RX buffers shared by all transfers packed into a single SPI_IOC_MESSAGE call.
+ * A transfer of N bytes occupies N + 1 bytes (address byte is included)
+ */
+#define MFRC522_LL_SPIDEV_BUF_SZ 512
+
+/* ------------------------------------------------------------ */
+/* -------------------------- Data types ---------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Function used to issue ioctl requests. Has the same semantics as ioctl() system call
+ */
+typedef int (*mfrc522_ll_spidev_ioctl)(int fd, unsigned long req, void* arg);
+
+/**
+ * Configuration of spidev backend
+ */
+typedef struct mfrc522_ll_spidev_conf_
+{
+    const char* path; /**< Path to spidev device, e.g. /dev/spidev0.0 */
+    u32 speed; /**< SPI clock frequency in Hz. Zero selects MFRC522_LL_SPIDEV_DEF_SPEED */
+    mfrc522_ll_spidev_ioctl ioctl_fn; /**< Function used to issue ioctl requests. NULL selects ioctl() system call */
+} mfrc522_ll_spidev_conf;
+
+/**
+ * Instance of spidev backend. A pointer to the instance shall be passed to the driver as low-level context, i.e.
+ * assigned to 'll_ctx' field of driver configuration. Fields are managed by the backend, do not modify them manually
+ */
+typedef struct mfrc522_ll_spidev_
+{
+    int fd; /**< File descriptor of opened device. Negative if no device is opened */
+    mfrc522_ll_spidev_conf conf; /**< Configuration of the instance */
+} mfrc522_ll_spidev;
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public variables ------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Low-level operations table to be passed to the driver, i.e. assigned to 'll_ops' field of driver configuration.
+ * The table provides scatter-gather transfer function, thus batched register operations are sent in one system call.
+ * The table is shared by all instances of the backend.
+ */
+extern const mfrc522_ll_ops mfrc522_ll_spidev_ops;
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Function to set up an instance of spidev backend.
+ *
+ * The function has to be called before the driver is initialized. It only stores the configuration, the device is
+ * opened and configured (SPI mode 0, 8 bits per word, given clock frequency) when low-level init function is called.
+ * An instance which has already been opened shall be closed before it is set up again.
+ *
+ * @param dev Pointer to an instance of the backend.
+ * @param conf Pointer to a configuration structure. Path string must outlive the instance.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_init_err if NULL pointer or NULL path were passed
+ *         - mfrc522_ll_status_ok on success
+ */
+mfrc522_ll_status
+mfrc522_ll_spidev_setup(mfrc522_ll_spidev* dev, const mfrc522_ll_spidev_conf* conf);
+
+/**
+ * Function to close spidev device opened by an instance of the backend. Does nothing if no device is opened.
+ *
+ * @param dev Pointer to an instance of the backend. Can be NULL.
+ */
+void
+mfrc522_ll_spidev_close(mfrc522_ll_spidev* dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //MFRC522_MFRC522_LL_SPIDEV_H
@@ -0,0 +1,109 @@
+#ifndef MFRC522_MFRC522_LL_THREAD_H
+#define MFRC522_MFRC522_LL_THREAD_H
+
+#include <pthread.h>
+#include "type.h"
+#include "mfrc522_ll.h"
+
+#if !MFRC522_LL_PTR
+#error "MFRC522 driver: thread backend requires MFRC522_LL_PTR low-level communication method!"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* ---------------------------- Macros ------------------------ */
+/* ------------------------------------------------------------ */
+
+/**
+ * Maximum number of asynchronous requests waiting for a worker thread
+ */
+#define MFRC522_LL_THREAD_QUEUE_SZ 8
+
+/* ------------------------------------------------------------ */
+/* -------------------------- Data types ---------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Asynchronous request waiting for a worker thread
+ */
+typedef struct mfrc522_ll_thread_req_
+{
+    const mfrc522_ll_xfer* xfers; /**< Array of transfers */
+    size num; /**< Number of transfers */
+    mfrc522_ll_complete complete; /**< Completion callback */
+    void* arg; /**< User argument passed to completion callback */
+} mfrc522_ll_thread_req;
+
+/**
+ * Instance of thread backend. A pointer to the instance shall be passed to the driver as low-level context, i.e.
+ * assigned to 'll_ctx' field of driver configuration. Fields are managed by the backend, do not modify them manually
+ */
+typedef struct mfrc522_ll_thread_
+{
+    const mfrc522_ll_ops* ops; /**< Wrapped synchronous operations. NULL if the worker is not running */
+    void* ctx; /**< Low-level context passed to wrapped operations */
+    pthread_t worker; /**< Worker thread */
+    bool stopping; /**< Set when the worker is requested to stop */
+    pthread_mutex_t bus_lock; /**< Serializes access to wrapped operations */
+    pthread_mutex_t queue_lock; /**< Protects queue of requests */
+    pthread_cond_t queue_cond; /**< Signalled when a request is queued or the worker is requested to stop */
+    mfrc522_ll_thread_req queue[MFRC522_LL_THREAD_QUEUE_SZ]; /**< Queue of requests */
+    size queue_head; /**< Index of the oldest request */
+    size queue_num; /**< Number of queued requests */
+} mfrc522_ll_thread;
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public variables ------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Low-level operations table to be passed to the driver, i.e. assigned to 'll_ops' field of driver configuration.
+ *
+ * The table wraps synchronous operations passed to 'mfrc522_ll_thread_start()' and adds asynchronous transfer function
+ * on top of them. Asynchronous requests are performed by a worker thread, which invokes completion callbacks. Bus
+ * access is serialized, thus synchronous operations can be mixed with asynchronous ones. Each instance of the backend
+ * runs its own worker thread.
+ *
+ * IRQ wait and clock functions are forwarded to wrapped operations. If wrapped operations do not provide them, the
+ * clock falls back to CLOCK_MONOTONIC and the IRQ pin is reported active after a short delay, so the driver keeps
+ * checking interrupt request registers.
+ */
+extern const mfrc522_ll_ops mfrc522_ll_thread_ops;
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Function to start a worker thread of an instance.
+ *
+ * The function has to be called before the driver is initialized. The instance shall be zero-initialized or stopped
+ * before the call.
+ *
+ * @param thr Pointer to an instance of the backend.
+ * @param ops Synchronous low-level operations to be wrapped, e.g. 'mfrc522_ll_spidev_ops'. Must outlive the instance.
+ * @param ctx Low-level context passed to wrapped operations, e.g. an instance of spidev backend. Can be NULL.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_init_err if NULL pointer was passed, the worker is already running or cannot be started
+ *         - mfrc522_ll_status_ok on success
+ */
+mfrc522_ll_status
+mfrc522_ll_thread_start(mfrc522_ll_thread* thr, const mfrc522_ll_ops* ops, void* ctx);
+
+/**
+ * Function to stop a worker thread of an instance. Pending requests are completed before the function returns.
+ * Does nothing if the worker is not running.
+ *
+ * @param thr Pointer to an instance of the backend. Can be NULL.
+ */
+void
+mfrc522_ll_thread_stop(mfrc522_ll_thread* thr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //MFRC522_MFRC522_LL_THREAD_H
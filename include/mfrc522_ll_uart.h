@@ -0,0 +1,128 @@
+#ifndef MFRC522_MFRC522_LL_UART_H
+#define MFRC522_MFRC522_LL_UART_H
+
+#include <termios.h>
+#include "type.h"
+#include "mfrc522_ll.h"
+
+#if !MFRC522_LL_PTR
+#error "MFRC522 driver: UART backend requires MFRC522_LL_PTR low-level communication method!"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------ */
+/* ---------------------------- Macros ------------------------ */
+/* ------------------------------------------------------------ */
+
+/**
+ * Baud rate used by a device after power-up or reset
+ */
+#define MFRC522_LL_UART_RESET_BAUD 9600
+
+/**
+ * Highest baud rate supported by both a device and Linux termios interface
+ */
+#define MFRC522_LL_UART_MAX_BAUD 921600
+
+/**
+ * Default time in milliseconds to wait for the next byte sent by a device
+ */
+#define MFRC522_LL_UART_DEF_TIMEOUT 20
+
+/**
+ * Size of internal TX buffer used by a single write call. A write transfer of N bytes occupies 2 * N bytes (each data
+ * byte is preceded by address byte), whereas a read transfer of N bytes occupies N bytes
+ */
+#define MFRC522_LL_UART_BUF_SZ 256
+
+/* ------------------------------------------------------------ */
+/* -------------------------- Data types ---------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Function used to apply termios settings. Has the same semantics as tcsetattr() library call
+ */
+typedef int (*mfrc522_ll_uart_tcsetattr)(int fd, int actions, const struct termios* tio);
+
+/**
+ * Configuration of UART backend
+ */
+typedef struct mfrc522_ll_uart_conf_
+{
+    const char* path; /**< Path to serial device, e.g. /dev/ttyS0 */
+    u32 max_baud; /**< Upper limit for negotiated baud rate. Zero selects MFRC522_LL_UART_MAX_BAUD */
+    u32 timeout; /**< Time in milliseconds to wait for the next byte. Zero selects MFRC522_LL_UART_DEF_TIMEOUT */
+    mfrc522_ll_uart_tcsetattr tcsetattr_fn; /**< Function used to apply termios settings. NULL selects tcsetattr() */
+} mfrc522_ll_uart_conf;
+
+/**
+ * Instance of UART backend. A pointer to the instance shall be passed to the driver as low-level context, i.e.
+ * assigned to 'll_ctx' field of driver configuration. Fields are managed by the backend, do not modify them manually
+ */
+typedef struct mfrc522_ll_uart_
+{
+    int fd; /**< File descriptor of opened device. Negative if no device is opened */
+    u32 baud; /**< Baud rate agreed with a device */
+    mfrc522_ll_uart_conf conf; /**< Configuration of the instance */
+} mfrc522_ll_uart;
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public variables ------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Low-level operations table to be passed to the driver, i.e. assigned to 'll_ops' field of driver configuration.
+ *
+ * Low-level init function opens serial device and looks for a baud rate a device currently uses (starting from
+ * MFRC522_LL_UART_RESET_BAUD). Then the highest baud rate accepted by both sides is negotiated through SerialSpeedReg
+ * and host side is reconfigured to match it. A rate is requested from a device only if host side applied it before.
+ * The table provides scatter-gather transfer function, thus batched register operations are sent in one write call.
+ * The table is shared by all instances of the backend.
+ */
+extern const mfrc522_ll_ops mfrc522_ll_uart_ops;
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+/**
+ * Function to set up an instance of UART backend.
+ *
+ * The function has to be called before the driver is initialized. It only stores the configuration, the device is
+ * opened and the baud rate is negotiated when low-level init function is called. An instance which has already been
+ * opened shall be closed before it is set up again.
+ *
+ * @param dev Pointer to an instance of the backend.
+ * @param conf Pointer to a configuration structure. Path string must outlive the instance.
+ * @return An instance of mfrc522_ll_status. Valid return codes are:
+ *         - mfrc522_ll_status_init_err if NULL pointer or NULL path were passed
+ *         - mfrc522_ll_status_ok on success
+ */
+mfrc522_ll_status
+mfrc522_ll_uart_setup(mfrc522_ll_uart* dev, const mfrc522_ll_uart_conf* conf);
+
+/**
+ * Function to get currently used baud rate.
+ *
+ * @param dev Pointer to an instance of the backend. Can be NULL.
+ * @return Baud rate agreed with a device. Zero is returned if no device is opened.
+ */
+u32
+mfrc522_ll_uart_baud(const mfrc522_ll_uart* dev);
+
+/**
+ * Function to close serial device opened by an instance of the backend. Does nothing if no device is opened.
+ *
+ * @param dev Pointer to an instance of the backend. Can be NULL.
+ */
+void
+mfrc522_ll_uart_close(mfrc522_ll_uart* dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //MFRC522_MFRC522_LL_UART_H
@@ -14,6 +14,21 @@ extern "C" {
 /* Invalid ATQA response */
 #define MFRC522_PICC_ATQA_INV 0xFFFF
 
+/* Initial value of CRC_A as defined in ISO/IEC 14443-3 */
+#define MFRC522_PICC_CRC_A_PRESET 0x6363
+
+/* Cascade tag. Indicates that UID is not complete and the next cascade level follows */
+#define MFRC522_PICC_CASCADE_TAG 0x88
+
+/* Bit of SAK set when UID is not complete */
+#define MFRC522_PICC_SAK_CASCADE 0x04
+
+/* Number of cascade levels, i.e. CL1, CL2 and CL3 */
+#define MFRC522_PICC_CASCADE_LEVELS 3
+
+/* Size of the longest (triple size) UID */
+#define MFRC522_PICC_UID_MAX_SZ 10
+
 /* ------------------------------------------------------------ */
 /* -------------------------- Data types ---------------------- */
 /* ------------------------------------------------------------ */
@@ -114,6 +129,8 @@ typedef enum mfrc522_picc_cmd_
     mfrc522_picc_cmd_select_cl1 = 0x7093, /**< Select CL1 */
     mfrc522_picc_cmd_anticoll_cl2 = 0x2095, /**< Anticollision CL2 */
     mfrc522_picc_cmd_select_cl2 = 0x7095, /**< Select CL2 */
+    mfrc522_picc_cmd_anticoll_cl3 = 0x2097, /**< Anticollision CL3 */
+    mfrc522_picc_cmd_select_cl3 = 0x7097, /**< Select CL3 */
     mfrc522_picc_cmd_halt = 0x0050, /**< Halt */
     mfrc522_picc_cmd_auth_key_a = 0x60, /**< Authenticate with Key A */
     mfrc522_picc_cmd_auth_key_b = 0x61, /** Authenticate with Key B */
@@ -127,6 +144,16 @@ typedef enum mfrc522_picc_cmd_
     mfrc522_picc_cmd_transfer = 0xB0 /**< MIFARE transfer */
 } mfrc522_picc_cmd;
 
+/**
+ * Unique identifier of a PICC together with its final SAK
+ */
+typedef struct mfrc522_picc_uid_
+{
+    u8 bytes[MFRC522_PICC_UID_MAX_SZ]; /**< UID without cascade tags */
+    u8 sz; /**< Size of UID: 4 (single), 7 (double) or 10 (triple). Zero if UID is not known */
+    u8 sak; /**< SAK returned at the last cascade level */
+} mfrc522_picc_uid;
+
 /**
  * Key types
  */
@@ -199,6 +226,21 @@ mfrc522_picc_get_trailer_accb(const mfrc522_picc_trailer_acc* acc_cond, mfrc522_
 bool
 mfrc522_picc_get_block_accb(const mfrc522_picc_block_acc* acc_cond, mfrc522_picc_accb* out);
 
+/**
+ * Calculate CRC_A of a frame in software.
+ *
+ * The result is the same as the one computed by CRC coprocessor with 6363h preset (refer to 'mfrc522_drv_crc_init()'),
+ * but no bus transfers are needed. Least significant byte of the result is transmitted first.
+ *
+ * The function returns the preset value, when 'data' is NULL.
+ *
+ * @param data Pointer to frame bytes.
+ * @param sz Number of frame bytes.
+ * @return CRC_A of the frame.
+ */
+u16
+mfrc522_picc_crc_a(const u8* data, size sz);
+
 /**
  * Get transport (default) access bits configuration for section trailer block.
  *
@@ -55,6 +55,7 @@ MFRC522_REG_FIELD_CREATE(VERSION_CHIPTYPE, 0x0F, 4);
  * Bit fields for Command register
  */
 MFRC522_REG_FIELD_CREATE(COMMAND_CMD, 0x0F, 0);
+MFRC522_REG_FIELD_CREATE(COMMAND_POWER_DOWN, 0x01, 4);
 MFRC522_REG_FIELD_CREATE(COMMAND_RCVOFF, 0x01, 5);
 
 /**
@@ -62,6 +63,7 @@ MFRC522_REG_FIELD_CREATE(COMMAND_RCVOFF, 0x01, 5);
  */
 MFRC522_REG_FIELD_CREATE(TMODE_TPHI, 0x0F, 0);
 MFRC522_REG_FIELD_CREATE(TMODE_TAUTO_RESTART, 0x01, 4);
+MFRC522_REG_FIELD_CREATE(TMODE_TAUTO, 0x01, 7);
 
 /**
  * Bit fields for Demod register
@@ -121,6 +123,7 @@ MFRC522_REG_FIELD_CREATE(TXCONTROL_TX2RFEN, 0x01, 1);
  * Bit fields for BitFraming register
  */
 MFRC522_REG_FIELD_CREATE(BITFRAMING_START, 0x01, 7);
+MFRC522_REG_FIELD_CREATE(BITFRAMING_RX_ALIGN, 0x07, 4);
 MFRC522_REG_FIELD_CREATE(BITFRAMING_TX_LASTBITS, 0x07, 0);
 
 /**
@@ -128,6 +131,28 @@ MFRC522_REG_FIELD_CREATE(BITFRAMING_TX_LASTBITS, 0x07, 0);
  */
 MFRC522_REG_FIELD_CREATE(STATUS2_CRYPTO_ON, 0x01, 3);
 
+/**
+ * Bit fields for TxMode register
+ */
+MFRC522_REG_FIELD_CREATE(TXMODE_TX_CRC_EN, 0x01, 7);
+
+/**
+ * Bit fields for RxMode register
+ */
+MFRC522_REG_FIELD_CREATE(RXMODE_RX_CRC_EN, 0x01, 7);
+
+/**
+ * Bit fields for Error register
+ */
+MFRC522_REG_FIELD_CREATE(ERROR_CRC_ERR, 0x01, 2);
+MFRC522_REG_FIELD_CREATE(ERROR_COLL_ERR, 0x01, 3);
+
+/**
+ * Bit fields for Coll register
+ */
+MFRC522_REG_FIELD_CREATE(COLL_POS, 0x1F, 0);
+MFRC522_REG_FIELD_CREATE(COLL_POS_NOT_VALID, 0x01, 5);
+
 /* ------------------------------------------------------------ */
 /* ------------------------ Data types ------------------------ */
 /* ------------------------------------------------------------ */
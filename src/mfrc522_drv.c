@@ -14,6 +14,73 @@
 #define IRQ_ALL_COM_MASK 0x7F
 #define IRQ_ALL_DIV_MASK 0x14
 
+/* Bit representing a register in 64-bit register masks */
+#define REG_BIT(REG) (((u64)1) << (REG))
+
+/* Registers which are modified only by the host, thus their values can be shadowed */
+#define REG_CACHEABLE_MASK ( \
+    REG_BIT(mfrc522_reg_com_irq_en) | REG_BIT(mfrc522_reg_div_irq_en) | REG_BIT(mfrc522_reg_water_level) | \
+    REG_BIT(mfrc522_reg_bit_framing) | REG_BIT(mfrc522_reg_mode) | REG_BIT(mfrc522_reg_tx_mode) | \
+    REG_BIT(mfrc522_reg_rx_mode) | REG_BIT(mfrc522_reg_tx_control) | REG_BIT(mfrc522_reg_tx_ask) | \
+    REG_BIT(mfrc522_reg_tx_sel) | REG_BIT(mfrc522_reg_rx_sel) | REG_BIT(mfrc522_reg_rx_threshold) | \
+    REG_BIT(mfrc522_reg_demod) | REG_BIT(mfrc522_reg_mf_tx) | REG_BIT(mfrc522_reg_mf_rx) | \
+    REG_BIT(mfrc522_reg_serial_speed) | REG_BIT(mfrc522_reg_mod_width) | REG_BIT(mfrc522_reg_rf_cfg) | \
+    REG_BIT(mfrc522_reg_gs_n) | REG_BIT(mfrc522_reg_cw_gs) | REG_BIT(mfrc522_reg_mod_gs) | \
+    REG_BIT(mfrc522_reg_tim_mode) | REG_BIT(mfrc522_reg_tim_prescaler) | REG_BIT(mfrc522_reg_tim_reload_hi) | \
+    REG_BIT(mfrc522_reg_tim_reload_lo) | REG_BIT(mfrc522_reg_test_sel1) | REG_BIT(mfrc522_reg_test_sel2) | \
+    REG_BIT(mfrc522_reg_test_pin_en) | REG_BIT(mfrc522_reg_auto_test) | REG_BIT(mfrc522_reg_analog_test) | \
+    REG_BIT(mfrc522_reg_test_dac1) | REG_BIT(mfrc522_reg_test_dac2))
+
+/* Registers captured by a snapshot. BitFramingReg is set up for every frame, baud rate is owned by low-level layer */
+#define REG_SNAPSHOT_MASK (REG_CACHEABLE_MASK & ~(REG_BIT(mfrc522_reg_bit_framing) | REG_BIT(mfrc522_reg_serial_speed)))
+
+/* Number of bits set in a 64-bit value. Usable in constant expressions */
+#define BIT_COUNT_2(X) ((X) - (((X) >> 1) & 0x5555555555555555ULL))
+#define BIT_COUNT_4(X) ((BIT_COUNT_2(X) & 0x3333333333333333ULL) + ((BIT_COUNT_2(X) >> 2) & 0x3333333333333333ULL))
+#define BIT_COUNT_8(X) ((BIT_COUNT_4(X) + (BIT_COUNT_4(X) >> 4)) & 0x0F0F0F0F0F0F0F0FULL)
+#define BIT_COUNT(X) ((BIT_COUNT_8(X) * 0x0101010101010101ULL) >> 56)
+
+/* Maximum number of writes collected in a single batch by script interpreter */
+#define SCRIPT_BATCH_MAX 16
+
+/* Initial delay between subsequent reads while executing poll operation */
+#define SCRIPT_POLL_DELAY 5
+
+/* Backoff cap of poll operations in microseconds */
+#define SCRIPT_POLL_MAX_DELAY 80
+
+/* Maximum number of transfers performed at once during transceive */
+#define TRANSCEIVE_XFERS_MAX 9
+
+/* Registers modified for the time of transceive command. Shadowed values are dropped if they cannot be restored */
+#define TRANSCEIVE_RESTORE_MASK ( \
+    REG_BIT(mfrc522_reg_bit_framing) | REG_BIT(mfrc522_reg_com_irq_en) | REG_BIT(mfrc522_reg_tx_mode) | \
+    REG_BIT(mfrc522_reg_rx_mode) | REG_BIT(mfrc522_reg_tim_mode))
+
+/* Number of CRC_A bytes */
+#define CRC_A_SZ 2
+
+/* Delay between subsequent reads of IRQ registers while transceive is limited by the timer */
+#define TRANSCEIVE_TIM_POLL_DELAY 100
+
+/* Interrupts routed to IRQ pin while waiting for transceive completion */
+#define TRANSCEIVE_IRQ_EN_MASK ((1 << mfrc522_reg_irq_rx) | (1 << mfrc522_reg_irq_idle) | (1 << mfrc522_reg_irq_err))
+
+/* ------------------------------------------------------------ */
+/* ---------------------- Private data types ------------------ */
+/* ------------------------------------------------------------ */
+
+/* Transfers collected by script interpreter */
+typedef struct script_batch_
+{
+    mfrc522_ll_xfer xfers[SCRIPT_BATCH_MAX];
+    u8 vals[SCRIPT_BATCH_MAX]; /* Storage for bytes to write */
+    size num;
+} script_batch;
+
+/* Snapshot storage has to fit all captured registers exactly. Array size gets negative otherwise */
+typedef char snapshot_sz_check[(BIT_COUNT(REG_SNAPSHOT_MASK) == MFRC522_DRV_SNAPSHOT_SZ) ? 1 : -1];
+
 /* ------------------------------------------------------------ */
 /* ----------------------- Private functions ------------------ */
 /* ------------------------------------------------------------ */
@@ -24,7 +91,7 @@ delay(const mfrc522_drv_conf* conf, u32 period)
 {
 #if MFRC522_LL_PTR
 #if MFRC522_LL_DELAY
-    conf->ll_delay(period);
+    conf->ll_ops->delay(conf->ll_ctx, period);
 #else
     /* Make compiler happy */
     (void)conf;
@@ -32,8 +99,7 @@ delay(const mfrc522_drv_conf* conf, u32 period)
 #endif
 #elif MFRC522_LL_DEF
 #if MFRC522_LL_DELAY
-    (void)conf; /* Make compiler happy */
-    mfrc522_ll_delay(period);
+    mfrc522_ll_delay(conf->ll_ctx, period);
 #else
     /* Make compiler happy */
     (void)conf;
@@ -42,6 +108,94 @@ delay(const mfrc522_drv_conf* conf, u32 period)
 #endif
 }
 
+/* Check whether low-level layer is able to wait for IRQ pin */
+static inline bool
+irq_wait_supported(const mfrc522_drv_conf* conf)
+{
+#if MFRC522_LL_PTR
+    return NULL != conf->ll_ops->wait_irq;
+#elif MFRC522_LL_IRQ
+    /* Make compiler happy */
+    (void)conf;
+    return true;
+#else
+    /* Make compiler happy */
+    (void)conf;
+    return false;
+#endif
+}
+
+/* Private implementation of IRQ wait function. Shall be called only if the wait is supported by low-level layer */
+static inline mfrc522_ll_status
+irq_wait(const mfrc522_drv_conf* conf, u32 timeout)
+{
+#if MFRC522_LL_PTR
+    return conf->ll_ops->wait_irq(conf->ll_ctx, timeout);
+#elif MFRC522_LL_IRQ
+    return mfrc522_ll_wait_irq(conf->ll_ctx, timeout);
+#else
+    /* Make compiler happy */
+    (void)conf;
+    (void)timeout;
+    return mfrc522_ll_status_recv_err;
+#endif
+}
+
+/* Check whether low-level layer provides monotonic clock */
+static inline bool
+clock_supported(const mfrc522_drv_conf* conf)
+{
+#if MFRC522_LL_PTR
+    return NULL != conf->ll_ops->now;
+#elif MFRC522_LL_CLOCK
+    /* Make compiler happy */
+    (void)conf;
+    return true;
+#else
+    /* Make compiler happy */
+    (void)conf;
+    return false;
+#endif
+}
+
+/* Private implementation of clock function. Shall be called only if the clock is supported by low-level layer */
+static inline u32
+clock_now(const mfrc522_drv_conf* conf)
+{
+#if MFRC522_LL_PTR
+    return conf->ll_ops->now(conf->ll_ctx);
+#elif MFRC522_LL_CLOCK
+    return mfrc522_ll_now(conf->ll_ctx);
+#else
+    /* Make compiler happy */
+    (void)conf;
+    return 0;
+#endif
+}
+
+/* Check whether deadline of read_until call can be measured */
+static inline bool
+deadline_supported(const mfrc522_drv_conf* conf)
+{
+#if MFRC522_LL_DELAY
+    /* Make compiler happy */
+    (void)conf;
+    return true;
+#else
+    return clock_supported(conf);
+#endif
+}
+
+/* Bound read_until call with a time budget. Retry count is used only if the budget cannot be measured by the clock */
+static inline void
+deadline_set(const mfrc522_drv_conf* conf, mfrc522_drv_read_until_conf* ru_conf, u32 budget)
+{
+    ru_conf->timeout = budget;
+    if (clock_supported(conf)) {
+        ru_conf->retry_cnt = MFRC522_DRV_RETRY_CNT_INF;
+    }
+}
+
 /* Calculate real number of retry count */
 static inline u32
 get_real_retry_count(u32 rc)
@@ -52,849 +206,2408 @@ get_real_retry_count(u32 rc)
     return rc;
 }
 
-/* Function to read valid number of RX bytes during transceive command */
-static mfrc522_drv_status
-get_valid_rx_bytes(const mfrc522_drv_conf* conf, u8* rx_bytes)
+/* Store a register value in the shadow cache (if used) */
+static inline void
+reg_cache_store(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8 val)
 {
-    u8 valid_bits;
-    mfrc522_drv_status status;
-    status = mfrc522_drv_read_masked(conf, mfrc522_reg_control, &valid_bits, MFRC522_REG_FIELD(CONTROL_RX_LASTBITS));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-
-    /* In current use cases the whole byte shall be valid. Thus return zero by now */
-    if (UNLIKELY(valid_bits)) {
-        *rx_bytes = 0;
-        return mfrc522_drv_status_ok;
+    mfrc522_drv_reg_cache* cache = conf->reg_cache;
+    if (NULL == cache) {
+        return;
     }
 
-    /* Read FIFO level */
-    status = mfrc522_drv_read(conf, mfrc522_reg_fifo_level, rx_bytes);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    /* Soft reset brings all registers back to their reset values */
+    if ((mfrc522_reg_command == addr) &&
+        (mfrc522_reg_cmd_soft_reset == (val & MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD)))) {
+        cache->valid = 0;
+        return;
+    }
 
-    return mfrc522_drv_status_ok;
+    if (mfrc522_drv_reg_cacheable(addr)) {
+        cache->regs[addr] = val;
+        cache->valid |= REG_BIT(addr);
+    }
 }
 
-/* Handle getting ATQA */
-static inline mfrc522_drv_status
-verify_atqa(const mfrc522_drv_conf* conf, const u8* rx_data, u16* atqa)
+/* Forget shadowed values of registers given as a bitmask */
+static inline void
+reg_cache_drop(const mfrc522_drv_conf* conf, u64 regs)
 {
-    *atqa = rx_data[0] | (rx_data[1] << 8);
-
-    /* Verify ATQA if enabled */
-    if (NULL != conf->atqa_verify_fn) {
-        return (conf->atqa_verify_fn(*atqa)) ? mfrc522_drv_status_ok : mfrc522_drv_status_picc_vrf_err;
+    if (NULL != conf->reg_cache) {
+        conf->reg_cache->valid &= ~regs;
     }
-    return mfrc522_drv_status_ok;
 }
 
-/* Helper function to get IRQ number used as the exit criterion during transceive command */
-static inline mfrc522_reg_irq
-get_awaited_irq_num(mfrc522_reg_cmd cmd)
+/* Get a register value from the shadow cache. Returns false if the value is not known */
+static inline bool
+reg_cache_lookup(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8* val)
 {
-    return (mfrc522_reg_cmd_transceive == cmd) ? mfrc522_reg_irq_rx : mfrc522_reg_irq_idle;
+    const mfrc522_drv_reg_cache* cache = conf->reg_cache;
+    if ((NULL == cache) || !mfrc522_drv_reg_cacheable(addr) || !(cache->valid & REG_BIT(addr))) {
+        return false;
+    }
+    *val = cache->regs[addr];
+    return true;
 }
 
-/* ------------------------------------------------------------ */
-/* ----------------------- Public functions ------------------- */
-/* ------------------------------------------------------------ */
-
-mfrc522_drv_status
-mfrc522_drv_init(mfrc522_drv_conf* conf)
+/* Store values transferred by a sequence of transfers in the shadow cache (if used) */
+static inline void
+reg_cache_update(const mfrc522_drv_conf* conf, const mfrc522_ll_xfer* xfers, size num)
 {
-    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    for (size i = 0; i < num; ++i) {
+        if (xfers[i].bytes) {
+            reg_cache_store(conf, xfers[i].addr, (NULL != xfers[i].tx) ? xfers[i].tx[xfers[i].bytes - 1]
+                                                                       : xfers[i].rx[xfers[i].bytes - 1]);
+        }
+    }
+}
 
-    /* In case 'pointer' low-level calls are used check for NULL also */
+/* Perform a sequence of transfers. Fall back to single calls if scatter-gather is not supported by low-level layer */
+static mfrc522_drv_status
+ll_transfer(const mfrc522_drv_conf* conf, const mfrc522_ll_xfer* xfers, size num)
+{
+    mfrc522_ll_status ll_status = mfrc522_ll_status_ok;
+#if MFRC522_LL_DEF && MFRC522_LL_BATCH
+    ll_status = mfrc522_ll_transfer_multi(conf->ll_ctx, xfers, num);
+#else
 #if MFRC522_LL_PTR
-    NOT_NULL(conf->ll_init, mfrc522_drv_status_nullptr);
-    NOT_NULL(conf->ll_send, mfrc522_drv_status_nullptr);
-    NOT_NULL(conf->ll_recv, mfrc522_drv_status_nullptr);
-#if MFRC522_LL_DELAY
-    NOT_NULL(conf->ll_delay, mfrc522_drv_status_nullptr);
+    if (NULL != conf->ll_ops->transfer_multi) {
+        ll_status = conf->ll_ops->transfer_multi(conf->ll_ctx, xfers, num);
+    } else
 #endif
-#endif
-
-    /* Initialize low-level interface to begin with */
-    mfrc522_ll_status init_status;
+    {
+        for (size i = 0; (i < num) && (mfrc522_ll_status_ok == ll_status); ++i) {
+            const mfrc522_ll_xfer* xfer = &xfers[i];
 #if MFRC522_LL_PTR
-    init_status = conf->ll_init();
+            if (NULL != xfer->tx) {
+                ll_status = conf->ll_ops->send(conf->ll_ctx, xfer->addr, xfer->bytes, xfer->tx);
+            } else if (1 == xfer->bytes) {
+                ll_status = conf->ll_ops->recv(conf->ll_ctx, xfer->addr, xfer->rx);
+            } else {
+                ll_status = conf->ll_ops->recv_mul(conf->ll_ctx, xfer->addr, xfer->bytes, xfer->rx);
+            }
 #else
-    init_status = mfrc522_ll_init();
+            if (NULL != xfer->tx) {
+                ll_status = mfrc522_ll_send(conf->ll_ctx, xfer->addr, xfer->bytes, xfer->tx);
+            } else if (1 == xfer->bytes) {
+                ll_status = mfrc522_ll_recv(conf->ll_ctx, xfer->addr, xfer->rx);
+            } else {
+                ll_status = mfrc522_ll_recv_mul(conf->ll_ctx, xfer->addr, xfer->bytes, xfer->rx);
+            }
 #endif
-    if (UNLIKELY(mfrc522_ll_status_ok != init_status)) {
-        return mfrc522_drv_status_ll_err;
+        }
     }
-
-    /* Try to get chip version from a device */
-    if (UNLIKELY(mfrc522_drv_status_ok != mfrc522_drv_read(conf, mfrc522_reg_version, &conf->chip_version))) {
-        conf->chip_version = MFRC522_REG_VERSION_INVALID;
+#endif
+    if (UNLIKELY(mfrc522_ll_status_ok != ll_status)) {
         return mfrc522_drv_status_ll_err;
     }
 
-    /* Chiptype 9xh stands for MFRC522 */
-    if (MFRC522_CONF_CHIP_TYPE != (conf->chip_version & MFRC522_REG_FIELD_MSK_REAL(VERSION_CHIPTYPE))) {
-        return mfrc522_drv_status_dev_err;
-    }
+    reg_cache_update(conf, xfers, num);
     return mfrc522_drv_status_ok;
 }
 
-mfrc522_drv_status
-mfrc522_drv_write_masked(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8 val, u8 mask, u8 pos)
+#if MFRC522_LL_PTR || MFRC522_LL_ASYNC
+/* Completion of asynchronous register operation */
+static void
+async_complete(void* arg, mfrc522_ll_status ll_status)
 {
-    NOT_NULL(conf, mfrc522_drv_status_nullptr);
-
-    mfrc522_drv_status status;
-    u8 buff;
-    status = mfrc522_drv_read(conf, addr, &buff);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    /* Register shadow cache is not touched here, since completion context may race with the caller */
+    mfrc522_drv_async_req* req = arg;
+    req->cb((mfrc522_ll_status_ok == ll_status) ? mfrc522_drv_status_ok : mfrc522_drv_status_ll_err, req->arg);
+}
+#endif
 
-    buff &= ~(mask << pos);
-    buff |= ((val & mask) << pos);
+/* Pass a request to asynchronous low-level transfer function. Perform it at once if the function is not available */
+static mfrc522_drv_status
+async_submit(mfrc522_drv_async_req* req)
+{
+#if MFRC522_LL_PTR || MFRC522_LL_ASYNC
+    /* Value of the register is not known until completion, which is not allowed to update the cache */
+    if (mfrc522_drv_reg_cacheable(req->xfer.addr)) {
+        reg_cache_drop(req->conf, REG_BIT(req->xfer.addr));
+    }
+#endif
 
-    status = mfrc522_drv_write_byte(conf, addr, buff);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+#if MFRC522_LL_PTR
+    const mfrc522_ll_ops* ops = req->conf->ll_ops;
+    if (NULL != ops->submit) {
+        mfrc522_ll_status ll_status = ops->submit(req->conf->ll_ctx, &req->xfer, 1, async_complete, req);
+        return (mfrc522_ll_status_ok == ll_status) ? mfrc522_drv_status_ok : mfrc522_drv_status_ll_err;
+    }
+#elif MFRC522_LL_ASYNC
+    mfrc522_ll_status ll_status = mfrc522_ll_submit(req->conf->ll_ctx, &req->xfer, 1, async_complete, req);
+    return (mfrc522_ll_status_ok == ll_status) ? mfrc522_drv_status_ok : mfrc522_drv_status_ll_err;
+#endif
 
+    /* Low-level layer cannot perform transfers in the background, thus the request is completed at once */
+    req->cb(ll_transfer(req->conf, &req->xfer, 1), req->arg);
     return mfrc522_drv_status_ok;
 }
 
-mfrc522_drv_status
-mfrc522_drv_read_masked(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8* out, u8 mask, u8 pos)
+/* Perform all transfers collected so far */
+static mfrc522_drv_status
+script_batch_flush(const mfrc522_drv_conf* conf, script_batch* batch)
 {
-    NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(out, mfrc522_drv_status_nullptr);
+    if (!batch->num) {
+        return mfrc522_drv_status_ok;
+    }
 
-    u8 buff;
-    mfrc522_drv_status status = mfrc522_drv_read(conf, addr, &buff);
+    mfrc522_drv_status status = ll_transfer(conf, batch->xfers, batch->num);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    batch->num = 0;
+    return mfrc522_drv_status_ok;
+}
 
-    buff &= (mask << pos);
-    buff >>= pos;
-    *out = buff;
+/* Get a free slot in a batch. Pending transfers are performed if the batch is full */
+static mfrc522_drv_status
+script_batch_slot(const mfrc522_drv_conf* conf, script_batch* batch, u8 addr, mfrc522_ll_xfer** xfer)
+{
+    if (SCRIPT_BATCH_MAX == batch->num) {
+        mfrc522_drv_status status = script_batch_flush(conf, batch);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    }
 
+    *xfer = &batch->xfers[batch->num++];
+    (*xfer)->addr = addr;
+    (*xfer)->bytes = 1;
+    (*xfer)->tx = NULL;
+    (*xfer)->rx = NULL;
     return mfrc522_drv_status_ok;
 }
 
-mfrc522_drv_status
-mfrc522_drv_read_until(const mfrc522_drv_conf* conf, mfrc522_drv_read_until_conf* ru_conf)
+/* Add single write to a batch */
+static mfrc522_drv_status
+script_batch_add_write(const mfrc522_drv_conf* conf, script_batch* batch, u8 addr, u8 val)
 {
-    NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(ru_conf, mfrc522_drv_status_nullptr);
+    /* Host-owned registers have no side effects when written, thus the recent value replaces one sent just before.
+     * Earlier writes are not merged, because a transfer queued in between (e.g. SoftReset) must not be overtaken */
+    if (mfrc522_drv_reg_cacheable(addr) && batch->num) {
+        mfrc522_ll_xfer* last = &batch->xfers[batch->num - 1];
+        if ((addr == last->addr) && (NULL != last->tx)) {
+            batch->vals[batch->num - 1] = val;
+            return mfrc522_drv_status_ok;
+        }
+    }
 
-    /* Calculate real retry count */
-    u32 rc = get_real_retry_count(ru_conf->retry_cnt);
+    mfrc522_ll_xfer* xfer;
+    mfrc522_drv_status status = script_batch_slot(conf, batch, addr, &xfer);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* Handle infinite retry count case */
-    u8 rc_decrement_step = (ru_conf->retry_cnt == MFRC522_DRV_RETRY_CNT_INF) ? 0 : 1;
+    size idx = (size)(xfer - batch->xfers);
+    batch->vals[idx] = val;
+    xfer->tx = &batch->vals[idx];
+    return mfrc522_drv_status_ok;
+}
 
-    /* Read register first time */
-    mfrc522_drv_status status = mfrc522_drv_read(conf, ru_conf->addr, &ru_conf->payload);
+/* Add single read to a batch */
+static mfrc522_drv_status
+script_batch_add_read(const mfrc522_drv_conf* conf, script_batch* batch, u8 addr, u8* out)
+{
+    mfrc522_ll_xfer* xfer;
+    mfrc522_drv_status status = script_batch_slot(conf, batch, addr, &xfer);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    while ((ru_conf->exp_payload != (ru_conf->payload & ru_conf->mask))) {
-        if (!rc) {
-            return mfrc522_drv_status_dev_rtr_err;
-        }
-        rc -= rc_decrement_step;
-        delay(conf, ru_conf->delay); /* Wait for a while and check again */
-
-        status = mfrc522_drv_read(conf, ru_conf->addr, &ru_conf->payload);
-        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    }
+    xfer->rx = out;
     return mfrc522_drv_status_ok;
 }
 
-mfrc522_drv_status
-mfrc522_drv_soft_reset(const mfrc522_drv_conf* conf)
+/* Writes to CommandReg may change host-owned registers (e.g. SoftReset), so values known before are not valid behind */
+static inline bool
+script_entry_barrier(const mfrc522_drv_script_entry* entry)
 {
-    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    return (mfrc522_reg_command == entry->addr) &&
+           ((mfrc522_drv_script_op_write == entry->op) || (mfrc522_drv_script_op_write_masked == entry->op));
+}
 
-    /* Populate read settings */
-    mfrc522_drv_read_until_conf ruc;
-    ruc.addr = mfrc522_reg_command;
-    ruc.mask = MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD);
-    ruc.exp_payload = mfrc522_reg_cmd_idle;
-    ruc.delay = 100; /* Give 100us delay */
-    ruc.retry_cnt = MFRC522_DRV_DEF_RETRY_CNT;
+/* Get values of host-owned registers modified by script entries up to the next barrier. Host-owned registers cannot
+ * change on their own, so those modified partially are read at once before any write is sent */
+static mfrc522_drv_status
+script_prefetch(const mfrc522_drv_conf* conf, script_batch* batch, const mfrc522_drv_script_entry* script, size sz,
+                u8* known_vals)
+{
+    u64 known = 0;
+    for (size i = 0; (i < sz) && !script_entry_barrier(&script[i]); ++i) {
+        const mfrc522_drv_script_entry* entry = &script[i];
+        if (!mfrc522_drv_reg_cacheable(entry->addr) || (known & REG_BIT(entry->addr))) {
+            continue;
+        }
+        if (mfrc522_drv_script_op_write == entry->op) {
+            known_vals[entry->addr] = entry->val;
+            known |= REG_BIT(entry->addr);
+        } else if (mfrc522_drv_script_op_write_masked == entry->op) {
+            if (!reg_cache_lookup(conf, entry->addr, &known_vals[entry->addr])) {
+                mfrc522_drv_status status = script_batch_add_read(conf, batch, entry->addr, &known_vals[entry->addr]);
+                ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+            }
+            known |= REG_BIT(entry->addr);
+        }
+    }
+    return script_batch_flush(conf, batch);
+}
 
-    /* Send SoftReset command. Do not care of other bits - they will be set to defaults afterwards */
-    mfrc522_drv_status res = mfrc522_drv_write_byte(conf, mfrc522_reg_command, mfrc522_reg_cmd_soft_reset);
-    ERROR_IF_NEQ(res, mfrc522_drv_status_ok);
+/* Check low-level operations and initialize low-level interface. Shadowed register values are invalidated */
+static mfrc522_drv_status
+ll_init(mfrc522_drv_conf* conf)
+{
+    /* In case 'pointer' low-level calls are used check for NULL also */
+#if MFRC522_LL_PTR
+    NOT_NULL(conf->ll_ops, mfrc522_drv_status_nullptr);
+    NOT_NULL(conf->ll_ops->init, mfrc522_drv_status_nullptr);
+    NOT_NULL(conf->ll_ops->send, mfrc522_drv_status_nullptr);
+    NOT_NULL(conf->ll_ops->recv, mfrc522_drv_status_nullptr);
+    NOT_NULL(conf->ll_ops->recv_mul, mfrc522_drv_status_nullptr);
+#if MFRC522_LL_DELAY
+    NOT_NULL(conf->ll_ops->delay, mfrc522_drv_status_nullptr);
+#endif
+    /* The table may come from a different version of the library */
+    if (UNLIKELY(MFRC522_LL_OPS_VERSION != conf->ll_ops->version)) {
+        return mfrc522_drv_status_ll_err;
+    }
+#endif
 
-    /* Wait until Idle command is active back */
-    res = mfrc522_drv_read_until(conf, &ruc);
-    ERROR_IF_NEQ(res, mfrc522_drv_status_ok);
+    /* Initialize low-level interface to begin with */
+    mfrc522_ll_status init_status;
+#if MFRC522_LL_PTR
+    init_status = conf->ll_ops->init(conf->ll_ctx);
+#else
+    init_status = mfrc522_ll_init(conf->ll_ctx);
+#endif
+    if (UNLIKELY(mfrc522_ll_status_ok != init_status)) {
+        return mfrc522_drv_status_ll_err;
+    }
 
+    /* Nothing is known about device's registers at this stage */
+    mfrc522_drv_reg_cache_invalidate(conf);
     return mfrc522_drv_status_ok;
 }
 
-mfrc522_drv_status
-mfrc522_drv_tim_set(mfrc522_drv_tim_conf* tim_conf, u16 period)
+/* Prepare transfers of all registers captured by a snapshot. Either 'tx' or 'rx' points to snapshot storage */
+static void
+snapshot_xfers(mfrc522_ll_xfer* xfers, const u8* tx, u8* rx)
 {
-    NOT_NULL(tim_conf, mfrc522_drv_status_nullptr);
-    if (UNLIKELY(0 == period || period > MFRC522_DRV_TIM_MAX_PERIOD)) {
-        return mfrc522_drv_status_tim_prd_err;
+    size idx = 0;
+    for (u8 addr = 0; addr < MFRC522_DRV_REG_NUM; ++addr) {
+        if (REG_SNAPSHOT_MASK & REG_BIT(addr)) {
+            xfers[idx].addr = addr;
+            xfers[idx].bytes = 1;
+            xfers[idx].tx = (NULL != tx) ? &tx[idx] : NULL;
+            xfers[idx].rx = (NULL != rx) ? &rx[idx] : NULL;
+            ++idx;
+        }
     }
+}
 
-    /*
-     * The formula used to calculate reload value (with TPrescaler == 1694):
-     * TReload = 4 * period - 1
-     */
-    tim_conf->prescaler = TIMER_PRESCALER;
-    tim_conf->prescaler_type = mfrc522_drv_tim_psl_even;
-    tim_conf->reload_val = (4 * period) - 1;
-#if MFRC522_CONF_TIM_RELOAD_FIXED
-    ++tim_conf->reload_val;
-#endif
+/* Handle getting ATQA */
+static inline mfrc522_drv_status
+verify_atqa(const mfrc522_drv_conf* conf, const u8* rx_data, u16* atqa)
+{
+    *atqa = rx_data[0] | (rx_data[1] << 8);
 
+    /* Verify ATQA if enabled */
+    if (NULL != conf->atqa_verify_fn) {
+        return (conf->atqa_verify_fn(*atqa)) ? mfrc522_drv_status_ok : mfrc522_drv_status_picc_vrf_err;
+    }
     return mfrc522_drv_status_ok;
 }
 
-mfrc522_drv_status
-mfrc522_drv_tim_start(const mfrc522_drv_conf* conf, const mfrc522_drv_tim_conf* tim_conf)
+/* Helper function to get IRQ number used as the exit criterion during transceive command */
+static inline mfrc522_reg_irq
+get_awaited_irq_num(mfrc522_reg_cmd cmd)
 {
-    NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(tim_conf, mfrc522_drv_status_nullptr);
+    return (mfrc522_reg_cmd_transceive == cmd) ? mfrc522_reg_irq_rx : mfrc522_reg_irq_idle;
+}
 
-    /* Write to prescaler Lo and Hi registers */
-    u8 prescaler_lo = (u8)(tim_conf->prescaler & 0x00FF);
+/* Update state of transceive operation according to current IRQ states */
+static void
+transceive_check_irqs(mfrc522_drv_transceive_op* op, u16 irq_states)
+{
+    bool timer = (0 != op->tr_conf.timeout);
+    if (mfrc522_drv_irq_pending(irq_states, mfrc522_reg_irq_err)) {
+        op->result = mfrc522_drv_status_transceive_err;
+    } else if (mfrc522_drv_irq_pending(irq_states, get_awaited_irq_num(op->tr_conf.command))) {
+        op->result = mfrc522_drv_status_ok;
+    } else if (timer && mfrc522_drv_irq_pending(irq_states, mfrc522_reg_irq_timer)) {
+        op->result = mfrc522_drv_status_transceive_timeout;
+    } else {
+        return; /* Nothing happened yet */
+    }
+    op->state = mfrc522_drv_transceive_state_done;
+}
+
+/* Start transceive command. Transceive configuration has to be already stored in the operation */
+static mfrc522_drv_status
+transceive_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op, bool irq_pin)
+{
+    const mfrc522_drv_transceive_conf* tr_conf = &op->tr_conf;
+    op->state = mfrc522_drv_transceive_state_idle;
+    bool cmd_error = (mfrc522_reg_cmd_transceive != tr_conf->command) &&
+                     (mfrc522_reg_cmd_authent != tr_conf->command);
+    bool framing_error = (tr_conf->tx_last_bits > MFRC522_REG_FIELD_MSK(BITFRAMING_TX_LASTBITS)) ||
+                         (tr_conf->rx_align > MFRC522_REG_FIELD_MSK(BITFRAMING_RX_ALIGN));
+    if (UNLIKELY(cmd_error || framing_error)) {
+        return mfrc522_drv_status_nok;
+    }
+    op->tr_conf.rx_len = 0;
+    op->tr_conf.rx_last_bits = 0;
+    op->tr_conf.coll_pos = 0;
+
+    /* Arm the timer to measure frame waiting time from the end of transmission */
+    mfrc522_drv_status status;
+    bool timer = (0 != tr_conf->timeout);
+    if (timer) {
+        mfrc522_drv_tim_conf tim_conf = MFRC522_DRV_TIM_CONF_DEFAULT;
+        status = mfrc522_drv_tim_set(&tim_conf, tr_conf->timeout);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        tim_conf.periodic = false;
+        tim_conf.auto_start = true;
+        status = mfrc522_drv_tim_start(conf, &tim_conf);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    }
+
+    /* Get current values of the registers which are modified partially */
+    op->com_irq_en = 0;
+    op->tx_mode = 0;
+    op->rx_mode = 0;
+    mfrc522_ll_xfer xfers[TRANSCEIVE_XFERS_MAX];
+    size num = 0;
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_command, 1, NULL, &op->command};
+    if (!reg_cache_lookup(conf, mfrc522_reg_bit_framing, &op->bit_framing)) {
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_bit_framing, 1, NULL, &op->bit_framing};
+    }
+    if (irq_pin && !reg_cache_lookup(conf, mfrc522_reg_com_irq_en, &op->com_irq_en)) {
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_com_irq_en, 1, NULL, &op->com_irq_en};
+    }
+    if (tr_conf->hw_crc && !reg_cache_lookup(conf, mfrc522_reg_tx_mode, &op->tx_mode)) {
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_tx_mode, 1, NULL, &op->tx_mode};
+    }
+    if (tr_conf->hw_crc && !reg_cache_lookup(conf, mfrc522_reg_rx_mode, &op->rx_mode)) {
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_rx_mode, 1, NULL, &op->rx_mode};
+    }
+    status = ll_transfer(conf, xfers, num);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Clear all IRQs, flush the FIFO buffer, store actual data, invoke the command and start transmission at once */
+    const u8 irq_com = IRQ_ALL_COM_MASK;
+    const u8 irq_div = IRQ_ALL_DIV_MASK;
+    const u8 fifo_flush = MFRC522_REG_FIELD_MSK_REAL(FIFOLEVEL_FLUSH);
+    const u8 com_irq_en_wait = (op->com_irq_en & MFRC522_REG_FIELD_MSK_REAL(COMIEN_IRQ_INV)) |
+                               TRANSCEIVE_IRQ_EN_MASK | (timer << mfrc522_reg_irq_timer);
+    op->command = (op->command & ~MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD)) | tr_conf->command;
+    op->bit_framing &= ~MFRC522_REG_FIELD_MSK_REAL(BITFRAMING_START);
+    const u8 bit_framing_start = (op->bit_framing & ~MFRC522_REG_FIELD_MSK_REAL(BITFRAMING_RX_ALIGN) &
+                                  ~MFRC522_REG_FIELD_MSK_REAL(BITFRAMING_TX_LASTBITS)) |
+                                 (tr_conf->rx_align << MFRC522_REG_FIELD_POS(BITFRAMING_RX_ALIGN)) |
+                                 (tr_conf->tx_last_bits << MFRC522_REG_FIELD_POS(BITFRAMING_TX_LASTBITS)) |
+                                 MFRC522_REG_FIELD_MSK_REAL(BITFRAMING_START);
+    const u8 tx_mode_crc = op->tx_mode | MFRC522_REG_FIELD_MSK_REAL(TXMODE_TX_CRC_EN);
+    const u8 rx_mode_crc = op->rx_mode | MFRC522_REG_FIELD_MSK_REAL(RXMODE_RX_CRC_EN);
+    num = 0;
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_com_irq, 1, &irq_com, NULL};
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_div_irq, 1, &irq_div, NULL};
+    if (irq_pin) {
+        /* Only completion and error interrupts may activate IRQ pin. Keep pin polarity untouched */
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_com_irq_en, 1, &com_irq_en_wait, NULL};
+    }
+    if (tr_conf->hw_crc) {
+        /* The device appends CRC to TX data and checks CRC of RX data */
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_tx_mode, 1, &tx_mode_crc, NULL};
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_rx_mode, 1, &rx_mode_crc, NULL};
+    }
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_fifo_level, 1, &fifo_flush, NULL};
+    if (tr_conf->tx_data_sz) {
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_fifo_data, tr_conf->tx_data_sz, tr_conf->tx_data, NULL};
+    }
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_command, 1, &op->command, NULL};
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_bit_framing, 1, &bit_framing_start, NULL};
+    status = ll_transfer(conf, xfers, num);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    op->poll_limit = get_real_retry_count(MFRC522_DRV_DEF_RETRY_CNT);
+    op->poll_delay = 1;
+    if (timer) {
+        /* The timer decides when to give up. Poll limit is only a guard in case TimerIRq never comes */
+        op->poll_limit = get_real_retry_count(MFRC522_DRV_DEF_RETRY_CNT +
+                                              (2000 * (u32)tr_conf->timeout) / TRANSCEIVE_TIM_POLL_DELAY);
+        op->poll_delay = TRANSCEIVE_TIM_POLL_DELAY;
+    }
+    op->budget = 0;
+    if (clock_supported(conf)) {
+        /* Time budget replaces poll limit */
+        op->started = clock_now(conf);
+        op->budget = MFRC522_CONF_DEADLINE_TRANSCEIVE + 2000 * (u32)tr_conf->timeout;
+    }
+    op->irq_pin = irq_pin;
+    op->polls = 0;
+    op->result = mfrc522_drv_status_transceive_timeout;
+    op->state = mfrc522_drv_transceive_state_busy;
+
+    return mfrc522_drv_status_ok;
+}
+
+/* End transmission of the data, enter Idle state and restore registers modified by transceive command. Registers of
+ * unknown state are no longer trusted by the shadow cache when the device cannot be accessed */
+static mfrc522_drv_status
+transceive_restore(const mfrc522_drv_conf* conf, const mfrc522_drv_transceive_op* op)
+{
+    const u8 command = (op->command & ~MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD)) | mfrc522_reg_cmd_idle;
+    mfrc522_ll_xfer xfers[5];
+    size num = 0;
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_bit_framing, 1, &op->bit_framing, NULL};
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_command, 1, &command, NULL};
+    if (op->irq_pin) {
+        /* Restore interrupts routed to IRQ pin */
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_com_irq_en, 1, &op->com_irq_en, NULL};
+    }
+    if (op->tr_conf.hw_crc) {
+        /* Restore CRC settings */
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_tx_mode, 1, &op->tx_mode, NULL};
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_rx_mode, 1, &op->rx_mode, NULL};
+    }
+    mfrc522_drv_status status = ll_transfer(conf, xfers, num);
+    if (UNLIKELY(mfrc522_drv_status_ok != status)) {
+        reg_cache_drop(conf, TRANSCEIVE_RESTORE_MASK);
+    }
+    return status;
+}
+
+/* Enter or leave soft power-down. The other bits of CommandReg are taken from a given value */
+static mfrc522_drv_status
+power_down_set(const mfrc522_drv_conf* conf, u8 command, bool enable)
+{
+    const u8 val = (command & ~MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD) &
+                    ~MFRC522_REG_FIELD_MSK_REAL(COMMAND_POWER_DOWN)) |
+                   (enable << MFRC522_REG_FIELD_POS(COMMAND_POWER_DOWN)) | mfrc522_reg_cmd_idle;
+    mfrc522_drv_status status = mfrc522_drv_write_byte(conf, mfrc522_reg_command, val);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    if (enable) {
+        return mfrc522_drv_status_ok;
+    }
+
+    /* PowerDown bit is read as set until the oscillator is stable */
+    mfrc522_drv_read_until_conf ru_conf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+    ru_conf.addr = mfrc522_reg_command;
+    ru_conf.mask = MFRC522_REG_FIELD_MSK_REAL(COMMAND_POWER_DOWN);
+    ru_conf.exp_payload = 0;
+    ru_conf.delay = 10;
+    ru_conf.retry_cnt = MFRC522_DRV_DEF_RETRY_CNT;
+    ru_conf.max_delay = 160;
+    deadline_set(conf, &ru_conf, MFRC522_CONF_DEADLINE_WAKE_UP);
+    return mfrc522_drv_read_until(conf, &ru_conf);
+}
+
+/* Build REQA frame. TX last bits are set, since REQA is a bit oriented frame (7-bit) */
+static void
+reqa_prepare(mfrc522_drv_transceive_conf* tr_conf, u8* tx, u8* rx)
+{
+    tx[0] = mfrc522_picc_cmd_reqa;
+    *tr_conf = (mfrc522_drv_transceive_conf)MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    tr_conf->tx_data = tx;
+    tr_conf->tx_data_sz = 1;
+    tr_conf->rx_data = rx;
+    tr_conf->rx_data_sz = 2;
+    tr_conf->command = mfrc522_reg_cmd_transceive;
+    tr_conf->timeout = MFRC522_DRV_FWT_ISO14443_3;
+    tr_conf->tx_last_bits = 7;
+}
+
+/* Handle REQA response */
+static mfrc522_drv_status
+reqa_complete(const mfrc522_drv_conf* conf, mfrc522_drv_status status, const u8* rx, u16* atqa)
+{
+    switch (status) {
+        case mfrc522_drv_status_transceive_timeout:
+        case mfrc522_drv_status_transceive_err:
+        case mfrc522_drv_status_transceive_rx_mism:
+            *atqa = MFRC522_PICC_ATQA_INV;
+            return status;
+        case mfrc522_drv_status_ok:
+            /* Nothing to do here. Just exit the switch statement */
+            break;
+        default: /* Low-level error, etc. */
+            return status;
+    }
+
+    /* Verify ATQA */
+    status = verify_atqa(conf, rx, atqa);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    return mfrc522_drv_status_ok;
+}
+
+/* Build ANTICOLLISION frame of a given cascade level. TX buffer has to hold 2 bytes */
+static void
+anticollision_prepare(mfrc522_drv_transceive_conf* tr_conf, mfrc522_picc_cmd cmd, u8* tx, u8* rx)
+{
+    tx[0] = cmd & 0xFF;
+    tx[1] = (cmd & 0xFF00) >> 8;
+
+    *tr_conf = (mfrc522_drv_transceive_conf)MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    tr_conf->tx_data = tx;
+    tr_conf->tx_data_sz = 2;
+    tr_conf->rx_data = rx;
+    tr_conf->rx_data_sz = 5;
+    tr_conf->command = mfrc522_reg_cmd_transceive;
+    tr_conf->timeout = MFRC522_DRV_FWT_ISO14443_3;
+}
+
+/* Verify checksum of serial data */
+static mfrc522_drv_status
+anticollision_complete(mfrc522_drv_status status, const u8* serial)
+{
+    if (mfrc522_drv_status_ok == status) {
+        u8 checksum = 0;
+        for (size i = 0; i < 4; ++i) {
+            checksum ^= serial[i];
+        }
+        if (UNLIKELY(serial[4] != checksum)) {
+            return mfrc522_drv_status_anticoll_chksum_err;
+        }
+    }
+
+    return status;
+}
+
+/* Get UID CLn followed by BCC. On a collision a bit set to one is chosen and the frame is sent again with all bits
+ * known so far, so that only PICCs matching them answer. The number of known bits grows with each frame */
+static mfrc522_drv_status
+anticollision_resolve(const mfrc522_drv_conf* conf, mfrc522_picc_cmd cmd, u8* serial)
+{
+    mfrc522_drv_transceive_conf tr_conf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    u8 tx[6]; /* SEL, NVB and up to 4 bytes of UID CLn */
+    u8 rx[5];
+    size known = 0; /* Number of valid bits of UID CLn and BCC */
+    memset(serial, 0, 5);
+
+    for (;;) {
+        const size known_bytes = known / 8;
+        const u8 known_bits = known % 8;
+        const size tx_bytes = known_bytes + (known_bits ? 1 : 0);
+
+        /* High nibble of NVB counts whole bytes of the frame, low one the remaining bits */
+        tx[0] = cmd & 0xFF;
+        tx[1] = (u8)(((2 + known_bytes) << 4) | known_bits);
+        memcpy(&tx[2], serial, tx_bytes);
+        tr_conf.tx_data = tx;
+        tr_conf.tx_data_sz = 2 + tx_bytes;
+        tr_conf.rx_data = rx;
+        tr_conf.rx_data_sz = 5 - known_bytes;
+        tr_conf.command = mfrc522_reg_cmd_transceive;
+        tr_conf.timeout = MFRC522_DRV_FWT_ISO14443_3;
+        tr_conf.tx_last_bits = known_bits;
+        tr_conf.rx_align = known_bits;
+        tr_conf.rx_var_len = true;
+        mfrc522_drv_status status = mfrc522_drv_transceive(conf, &tr_conf);
+        if (UNLIKELY((mfrc522_drv_status_ok != status) && (mfrc522_drv_status_collision != status))) {
+            return status;
+        }
+
+        /* The first received bit is aligned to the first unknown one, so the bits below come from TX data */
+        const u8 below = (u8)((1 << known_bits) - 1);
+        serial[known_bytes] = (serial[known_bytes] & below) | (rx[0] & ~below);
+        memcpy(&serial[known_bytes + 1], &rx[1], (tr_conf.rx_len > 1) ? (tr_conf.rx_len - 1) : 0);
+
+        if (mfrc522_drv_status_ok == status) {
+            if (UNLIKELY((tr_conf.rx_len != tr_conf.rx_data_sz) || tr_conf.rx_last_bits)) {
+                return mfrc522_drv_status_transceive_rx_mism;
+            }
+            return anticollision_complete(status, serial);
+        }
+
+        /* UID CLn of PICCs differs, so collided bits of BCC mean that the response is garbled */
+        const size coll = known_bytes * 8 + tr_conf.coll_pos - 1;
+        if (UNLIKELY((0 == tr_conf.coll_pos) || (coll < known) || (coll >= 32))) {
+            return mfrc522_drv_status_collision;
+        }
+        serial[coll / 8] = (serial[coll / 8] & (u8)((1 << (coll % 8)) - 1)) | (u8)(1 << (coll % 8));
+        known = coll + 1;
+    }
+}
+
+/* Compute CRC_A of a PICC frame either in software or by the coprocessor, depending on device configuration */
+static mfrc522_drv_status
+frame_crc(const mfrc522_drv_conf* conf, const u8* data, size sz, u16* crc)
+{
+    if (mfrc522_drv_crc_mode_sw == conf->crc_mode) {
+        *crc = mfrc522_picc_crc_a(data, sz);
+        return mfrc522_drv_status_ok;
+    }
+
+    mfrc522_drv_status status = mfrc522_drv_fifo_store_mul(conf, data, sz);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    return mfrc522_drv_crc_compute(conf, crc);
+}
+
+/* Build SELECT frame of a cascade level with CRC appended (unless the device appends it). TX buffer holds 9 bytes */
+static mfrc522_drv_status
+select_prepare(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_conf* tr_conf, mfrc522_picc_cmd cmd,
+               const u8* serial, u8* tx, u8* rx)
+{
+    tx[0] = cmd & 0xFF;
+    tx[1] = (cmd & 0xFF00) >> 8;
+    memcpy(&tx[2], serial, 5);
+
+    *tr_conf = (mfrc522_drv_transceive_conf)MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    tr_conf->tx_data = tx;
+    tr_conf->tx_data_sz = 7;
+    tr_conf->rx_data = rx;
+    tr_conf->rx_data_sz = 1;
+    tr_conf->command = mfrc522_reg_cmd_transceive;
+    tr_conf->timeout = MFRC522_DRV_FWT_ISO14443_3;
+    tr_conf->hw_crc = (mfrc522_drv_crc_mode_hw == conf->crc_mode);
+    if (tr_conf->hw_crc) {
+        return mfrc522_drv_status_ok;
+    }
+
+    /* Compute and append CRC */
+    u16 crc;
+    mfrc522_drv_status status = frame_crc(conf, &tx[0], 7, &crc);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    tx[7] = crc & 0xFF;
+    tx[8] = (crc & 0xFF00) >> 8;
+    tr_conf->tx_data_sz += CRC_A_SZ;
+    tr_conf->rx_data_sz += CRC_A_SZ;
+
+    return mfrc522_drv_status_ok;
+}
+
+/* Verify CRC of SAK response (unless the device verified it) */
+static mfrc522_drv_status
+select_complete(const mfrc522_drv_conf* conf, mfrc522_drv_status status, const u8* rx, u8* sak)
+{
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    if (mfrc522_drv_crc_mode_hw == conf->crc_mode) {
+        *sak = rx[0];
+        return mfrc522_drv_status_ok;
+    }
+
+    u16 crc;
+    status = frame_crc(conf, &rx[0], 1, &crc);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    u16 crc_from_picc = rx[1] | (rx[2] << 8);
+    if (UNLIKELY(crc_from_picc != crc)) {
+        return mfrc522_drv_status_crc_err;
+    }
+
+    *sak = rx[0];
+    return mfrc522_drv_status_ok;
+}
+
+/* Build MFAuthent command data. TX buffer has to hold 12 bytes */
+static void
+authenticate_prepare(mfrc522_drv_transceive_conf* tr_conf, const mfrc522_drv_auth_conf* auth_conf, u8* tx)
+{
+    tx[0] = auth_conf->key_type;
+    tx[1] = mfrc522_picc_block_descriptor(auth_conf->sector, auth_conf->block);
+    memcpy(&tx[2], auth_conf->key, 6);
+    memcpy(&tx[8], auth_conf->serial, 4);
+
+    *tr_conf = (mfrc522_drv_transceive_conf)MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    tr_conf->tx_data = tx;
+    tr_conf->tx_data_sz = 12;
+    tr_conf->rx_data = NULL;
+    tr_conf->rx_data_sz = 0; /* No data is expected on RX side */
+    tr_conf->command = mfrc522_reg_cmd_authent;
+    tr_conf->timeout = MFRC522_DRV_FWT_MIFARE_AUTH;
+}
+
+/* Check if crypto is enabled */
+static mfrc522_drv_status
+authenticate_complete(const mfrc522_drv_conf* conf, mfrc522_drv_status status)
+{
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    u8 crypto;
+    status = mfrc522_drv_read_masked(conf, mfrc522_reg_status2, &crypto, MFRC522_REG_FIELD(STATUS2_CRYPTO_ON));
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    return (!crypto) ? mfrc522_drv_status_crypto_err : mfrc522_drv_status_ok;
+}
+
+/* Build HLTA frame with CRC appended (unless the device appends it). TX buffer has to hold 4 bytes */
+static mfrc522_drv_status
+halt_prepare(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_conf* tr_conf, u8* tx)
+{
+    tx[0] = mfrc522_picc_cmd_halt & 0xFF;
+    tx[1] = (mfrc522_picc_cmd_halt & 0xFF00) >> 8;
+
+    *tr_conf = (mfrc522_drv_transceive_conf)MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    tr_conf->tx_data = tx;
+    tr_conf->tx_data_sz = 2;
+    tr_conf->rx_data = NULL;
+    tr_conf->rx_data_sz = 0;
+    tr_conf->command = mfrc522_reg_cmd_transceive;
+    tr_conf->timeout = MFRC522_DRV_FWT_ISO14443_3;
+    tr_conf->hw_crc = (mfrc522_drv_crc_mode_hw == conf->crc_mode);
+    if (tr_conf->hw_crc) {
+        return mfrc522_drv_status_ok;
+    }
+
+    /* Compute and append CRC */
+    u16 crc;
+    mfrc522_drv_status status = frame_crc(conf, &tx[0], 2, &crc);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    tx[2] = crc & 0xFF;
+    tx[3] = (crc & 0xFF00) >> 8;
+    tr_conf->tx_data_sz += CRC_A_SZ;
+
+    return mfrc522_drv_status_ok;
+}
+
+/* Handle HLTA outcome and turn off the crypto unit */
+static mfrc522_drv_status
+halt_complete(const mfrc522_drv_conf* conf, mfrc522_drv_status status)
+{
+    /* This is intentional! Halt command succeeded when timeout occurs during reception of the data */
+    if (UNLIKELY(mfrc522_drv_status_ok == status)) {
+        return mfrc522_drv_status_halt_err;
+    } else if (mfrc522_drv_status_transceive_timeout != status) {
+        return status; /* Just forward the error */
+    }
+
+    status = mfrc522_drv_write_masked(conf, mfrc522_reg_status2, 0, MFRC522_REG_FIELD(STATUS2_CRYPTO_ON));
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    return mfrc522_drv_status_ok;
+}
+
+/* Send the probe frame once and collect a response. Outputs have to be initialized by the caller */
+static mfrc522_drv_status
+probe_exchange(const mfrc522_drv_conf* conf, const mfrc522_drv_probe_ctx* probe, bool* present, u16* atqa)
+{
+    /*
+     * Clear all IRQs, store the frame and start transmission at once. Transceive command is invoked again, since
+     * the receiver keeps waiting for data if nothing was received during the previous probe
+     */
+    const u8 irq_com = IRQ_ALL_COM_MASK;
+    const u8 bit_framing_start = probe->bit_framing | MFRC522_REG_FIELD_MSK_REAL(BITFRAMING_START);
+    const mfrc522_ll_xfer start[] = {
+        {mfrc522_reg_com_irq, 1, &irq_com, NULL},
+        {mfrc522_reg_command, 1, &probe->command, NULL},
+        {mfrc522_reg_fifo_data, 1, &probe->frame, NULL},
+        {mfrc522_reg_bit_framing, 1, &bit_framing_start, NULL}
+    };
+    mfrc522_drv_status status = ll_transfer(conf, start, SIZE_ARRAY(start));
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Only ComIrqReg is read until anything is received or frame waiting time expires */
+    const u8 done = (1 << mfrc522_reg_irq_rx) | (1 << mfrc522_reg_irq_err) | (1 << mfrc522_reg_irq_timer);
+    u32 started = clock_supported(conf) ? clock_now(conf) : 0;
+    u32 budget = clock_supported(conf) ? MFRC522_CONF_DEADLINE_TRANSCEIVE + 2000 * (u32)MFRC522_DRV_FWT_ISO14443_3 : 0;
+    u8 irq = 0;
+    for (u32 polls = 0; !(irq & done); ++polls) {
+        bool expired = budget ? ((u32)(clock_now(conf) - started) >= budget) : (polls >= probe->poll_limit);
+        if (UNLIKELY(expired)) {
+            return mfrc522_drv_status_ok; /* TimerIRq never came. Treat the PICC as absent */
+        }
+        if (polls) {
+            delay(conf, TRANSCEIVE_TIM_POLL_DELAY); /* Make some delay */
+        }
+        status = mfrc522_drv_read(conf, mfrc522_reg_com_irq, &irq);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    }
+    if (!(irq & ((1 << mfrc522_reg_irq_rx) | (1 << mfrc522_reg_irq_err)))) {
+        return mfrc522_drv_status_ok; /* Nothing received within frame waiting time */
+    }
+    *present = true;
+
+    /* Fetch ATQA unless responses of several PICCs collided */
+    u8 level = 0;
+    u8 rx[2];
+    if (!(irq & (1 << mfrc522_reg_irq_err))) {
+        const mfrc522_ll_xfer fetch[] = {
+            {mfrc522_reg_fifo_level, 1, NULL, &level},
+            {mfrc522_reg_fifo_data, SIZE_ARRAY(rx), NULL, &rx[0]}
+        };
+        status = ll_transfer(conf, fetch, SIZE_ARRAY(fetch));
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    }
+    if (UNLIKELY(SIZE_ARRAY(rx) != level)) {
+        /* Do not let leftovers of invalid response get into the next one */
+        return mfrc522_drv_fifo_flush(conf);
+    }
+
+    return verify_atqa(conf, &rx[0], atqa);
+}
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+mfrc522_drv_status
+mfrc522_drv_conf_init(mfrc522_drv_conf* conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+
+    /* Zero stands for a default value of every field */
+    memset(conf, 0, sizeof(*conf));
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_init(mfrc522_drv_conf* conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+
+    /* Register shadow cache is an opt-in attached after initialization */
+    conf->reg_cache = NULL;
+
+    mfrc522_drv_status status = ll_init(conf);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Try to get chip version from a device */
+    if (UNLIKELY(mfrc522_drv_status_ok != mfrc522_drv_read(conf, mfrc522_reg_version, &conf->chip_version))) {
+        conf->chip_version = MFRC522_REG_VERSION_INVALID;
+        return mfrc522_drv_status_ll_err;
+    }
+
+    /* Chiptype 9xh stands for MFRC522 */
+    if (MFRC522_CONF_CHIP_TYPE != (conf->chip_version & MFRC522_REG_FIELD_MSK_REAL(VERSION_CHIPTYPE))) {
+        return mfrc522_drv_status_dev_err;
+    }
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_write(const mfrc522_drv_conf* conf, mfrc522_reg addr, size sz, const u8* payload)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(payload, mfrc522_drv_status_nullptr);
+
+    mfrc522_ll_status ll_status;
+#if MFRC522_LL_PTR
+    ll_status = conf->ll_ops->send(conf->ll_ctx, addr, sz, payload);
+#elif MFRC522_LL_DEF
+    ll_status = mfrc522_ll_send(conf->ll_ctx, addr, sz, payload);
+#endif
+    if (UNLIKELY(mfrc522_ll_status_ok != ll_status)) {
+        return mfrc522_drv_status_ll_err;
+    }
+
+    /* The same register is written several times in case of multiple bytes. Hence only the last one is kept */
+    if (sz) {
+        reg_cache_store(conf, addr, payload[sz - 1]);
+    }
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_read(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8* payload)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(payload, mfrc522_drv_status_nullptr);
+
+    mfrc522_ll_status ll_status;
+#if MFRC522_LL_PTR
+    ll_status = conf->ll_ops->recv(conf->ll_ctx, addr, payload);
+#elif MFRC522_LL_DEF
+    ll_status = mfrc522_ll_recv(conf->ll_ctx, addr, payload);
+#endif
+    if (UNLIKELY(mfrc522_ll_status_ok != ll_status)) {
+        return mfrc522_drv_status_ll_err;
+    }
+
+    reg_cache_store(conf, addr, *payload);
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_read_mul(const mfrc522_drv_conf* conf, mfrc522_reg addr, size sz, u8* payload)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(payload, mfrc522_drv_status_nullptr);
+
+    mfrc522_ll_status ll_status;
+#if MFRC522_LL_PTR
+    ll_status = conf->ll_ops->recv_mul(conf->ll_ctx, addr, sz, payload);
+#elif MFRC522_LL_DEF
+    ll_status = mfrc522_ll_recv_mul(conf->ll_ctx, addr, sz, payload);
+#endif
+    if (UNLIKELY(mfrc522_ll_status_ok != ll_status)) {
+        return mfrc522_drv_status_ll_err;
+    }
+
+    if (sz) {
+        reg_cache_store(conf, addr, payload[sz - 1]);
+    }
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_read_regs(const mfrc522_drv_conf* conf, const mfrc522_reg* addrs, size num, u8* out)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(addrs, mfrc522_drv_status_nullptr);
+    NOT_NULL(out, mfrc522_drv_status_nullptr);
+
+    mfrc522_ll_xfer xfers[SCRIPT_BATCH_MAX];
+    while (num) {
+        size chunk = (num > SCRIPT_BATCH_MAX) ? SCRIPT_BATCH_MAX : num;
+        for (size i = 0; i < chunk; ++i) {
+            xfers[i].addr = addrs[i];
+            xfers[i].bytes = 1;
+            xfers[i].tx = NULL;
+            xfers[i].rx = &out[i];
+        }
+
+        mfrc522_drv_status status = ll_transfer(conf, xfers, chunk);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        addrs += chunk;
+        out += chunk;
+        num -= chunk;
+    }
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_write_masked(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8 val, u8 mask, u8 pos)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+
+    mfrc522_drv_status status;
+    u8 buff;
+    /* Read the register only if its value is not known */
+    if (!reg_cache_lookup(conf, addr, &buff)) {
+        status = mfrc522_drv_read(conf, addr, &buff);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    }
+
+    buff &= ~(mask << pos);
+    buff |= ((val & mask) << pos);
+
+    status = mfrc522_drv_write_byte(conf, addr, buff);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_read_masked(const mfrc522_drv_conf* conf, mfrc522_reg addr, u8* out, u8 mask, u8 pos)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(out, mfrc522_drv_status_nullptr);
+
+    u8 buff;
+    mfrc522_drv_status status = mfrc522_drv_read(conf, addr, &buff);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    buff &= (mask << pos);
+    buff >>= pos;
+    *out = buff;
+
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_write_async(const mfrc522_drv_conf* conf, mfrc522_drv_async_req* req, mfrc522_reg addr, size sz,
+                        const u8* payload, mfrc522_drv_async_cb cb, void* arg)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(req, mfrc522_drv_status_nullptr);
+    NOT_NULL(payload, mfrc522_drv_status_nullptr);
+    NOT_NULL(cb, mfrc522_drv_status_nullptr);
+
+    req->conf = conf;
+    req->xfer.addr = addr;
+    req->xfer.bytes = sz;
+    req->xfer.tx = payload;
+    req->xfer.rx = NULL;
+    req->cb = cb;
+    req->arg = arg;
+    return async_submit(req);
+}
+
+mfrc522_drv_status
+mfrc522_drv_read_mul_async(const mfrc522_drv_conf* conf, mfrc522_drv_async_req* req, mfrc522_reg addr, size sz,
+                           u8* payload, mfrc522_drv_async_cb cb, void* arg)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(req, mfrc522_drv_status_nullptr);
+    NOT_NULL(payload, mfrc522_drv_status_nullptr);
+    NOT_NULL(cb, mfrc522_drv_status_nullptr);
+
+    req->conf = conf;
+    req->xfer.addr = addr;
+    req->xfer.bytes = sz;
+    req->xfer.tx = NULL;
+    req->xfer.rx = payload;
+    req->cb = cb;
+    req->arg = arg;
+    return async_submit(req);
+}
+
+mfrc522_drv_status
+mfrc522_drv_read_until(const mfrc522_drv_conf* conf, mfrc522_drv_read_until_conf* ru_conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(ru_conf, mfrc522_drv_status_nullptr);
+
+    /* Calculate real retry count */
+    u32 rc = get_real_retry_count(ru_conf->retry_cnt);
+
+    /* Handle infinite retry count case */
+    u8 rc_decrement_step = (ru_conf->retry_cnt == MFRC522_DRV_RETRY_CNT_INF) ? 0 : 1;
+
+    /* Elapsed time is measured by the clock if possible. Otherwise requested delays are summed up */
+    u32 timeout = deadline_supported(conf) ? ru_conf->timeout : 0;
+    bool clock = (0 != timeout) && clock_supported(conf);
+    u32 start = clock ? clock_now(conf) : 0;
+    u32 slept = 0;
+
+    /* Do not disturb the device while it is surely busy */
+    if (ru_conf->first_delay) {
+        delay(conf, ru_conf->first_delay);
+        slept += ru_conf->first_delay;
+    }
+
+    /* Read register first time */
+    mfrc522_drv_status status = mfrc522_drv_read(conf, ru_conf->addr, &ru_conf->payload);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    u32 period = ru_conf->delay;
+    while ((ru_conf->exp_payload != (ru_conf->payload & ru_conf->mask))) {
+        if (!rc) {
+            return mfrc522_drv_status_dev_rtr_err;
+        }
+
+        /* Unsigned subtraction handles wrap-around of the clock */
+        if (timeout && ((clock ? (u32)(clock_now(conf) - start) : slept) >= timeout)) {
+            return mfrc522_drv_status_dev_rtr_err;
+        }
+        rc -= rc_decrement_step;
+        delay(conf, period); /* Wait for a while and check again */
+        slept += period;
+
+        /* Back off exponentially up to the cap */
+        if (period < ru_conf->max_delay) {
+            period = (period > ru_conf->max_delay / 2) ? ru_conf->max_delay : (period ? 2 * period : 1);
+        }
+
+        status = mfrc522_drv_read(conf, ru_conf->addr, &ru_conf->payload);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    }
+    return mfrc522_drv_status_ok;
+}
+
+bool
+mfrc522_drv_reg_cacheable(mfrc522_reg addr)
+{
+    return (addr < MFRC522_DRV_REG_NUM) && (REG_CACHEABLE_MASK & REG_BIT(addr));
+}
+
+mfrc522_drv_status
+mfrc522_drv_reg_cache_attach(mfrc522_drv_conf* conf, mfrc522_drv_reg_cache* cache)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+
+    conf->reg_cache = cache;
+    return mfrc522_drv_reg_cache_invalidate(conf);
+}
+
+mfrc522_drv_status
+mfrc522_drv_reg_cache_invalidate(const mfrc522_drv_conf* conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+
+    if (NULL != conf->reg_cache) {
+        conf->reg_cache->valid = 0;
+    }
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_snapshot(const mfrc522_drv_conf* conf, mfrc522_drv_reg_snapshot* snap)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(snap, mfrc522_drv_status_nullptr);
+
+    mfrc522_ll_xfer xfers[MFRC522_DRV_SNAPSHOT_SZ];
+    snapshot_xfers(xfers, NULL, snap->regs);
+    return ll_transfer(conf, xfers, MFRC522_DRV_SNAPSHOT_SZ);
+}
+
+mfrc522_drv_status
+mfrc522_drv_restore(const mfrc522_drv_conf* conf, const mfrc522_drv_reg_snapshot* snap)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(snap, mfrc522_drv_status_nullptr);
+
+    mfrc522_ll_xfer xfers[MFRC522_DRV_SNAPSHOT_SZ];
+    snapshot_xfers(xfers, snap->regs, NULL);
+    return ll_transfer(conf, xfers, MFRC522_DRV_SNAPSHOT_SZ);
+}
+
+mfrc522_drv_status
+mfrc522_drv_snapshot_diff(const mfrc522_drv_reg_snapshot* snap, const mfrc522_drv_reg_snapshot* ref, u64* diff)
+{
+    NOT_NULL(snap, mfrc522_drv_status_nullptr);
+    NOT_NULL(ref, mfrc522_drv_status_nullptr);
+    NOT_NULL(diff, mfrc522_drv_status_nullptr);
+
+    *diff = 0;
+    size idx = 0;
+    for (u8 addr = 0; addr < MFRC522_DRV_REG_NUM; ++addr) {
+        if (REG_SNAPSHOT_MASK & REG_BIT(addr)) {
+            if (snap->regs[idx] != ref->regs[idx]) {
+                *diff |= REG_BIT(addr);
+            }
+            ++idx;
+        }
+    }
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_snapshot_get(const mfrc522_drv_reg_snapshot* snap, mfrc522_reg addr, u8* val)
+{
+    NOT_NULL(snap, mfrc522_drv_status_nullptr);
+    NOT_NULL(val, mfrc522_drv_status_nullptr);
+
+    if (UNLIKELY((addr >= MFRC522_DRV_REG_NUM) || !(REG_SNAPSHOT_MASK & REG_BIT(addr)))) {
+        return mfrc522_drv_status_nok;
+    }
+
+    /* Snapshot stores registers in order of addresses, so the index is a number of captured registers below */
+    size idx = 0;
+    for (u8 i = 0; i < addr; ++i) {
+        idx += (REG_SNAPSHOT_MASK & REG_BIT(i)) ? 1 : 0;
+    }
+    *val = snap->regs[idx];
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_script_exec(const mfrc522_drv_conf* conf, const mfrc522_drv_script_entry* script, size sz)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(script, mfrc522_drv_status_nullptr);
+
+    u8 known_vals[MFRC522_DRV_REG_NUM];
+    script_batch batch;
+    batch.num = 0;
+
+    mfrc522_drv_status status = script_prefetch(conf, &batch, script, sz, known_vals);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    for (size i = 0; i < sz; ++i) {
+        const mfrc522_drv_script_entry* entry = &script[i];
+        bool cacheable = mfrc522_drv_reg_cacheable(entry->addr);
+        u8 val;
+
+        switch (entry->op) {
+            case mfrc522_drv_script_op_write:
+                val = entry->val;
+                break;
+            case mfrc522_drv_script_op_write_masked:
+                if (cacheable) {
+                    val = known_vals[entry->addr];
+                } else {
+                    /* Pending writes may affect the register, so the read is queued behind them */
+                    status = script_batch_add_read(conf, &batch, entry->addr, &val);
+                    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+                    status = script_batch_flush(conf, &batch);
+                    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+                }
+                val = (val & ~entry->mask) | (entry->val & entry->mask);
+                break;
+            case mfrc522_drv_script_op_poll: {
+                status = script_batch_flush(conf, &batch);
+                ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+                mfrc522_drv_read_until_conf ruc = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+                ruc.addr = (mfrc522_reg)entry->addr;
+                ruc.mask = entry->mask;
+                ruc.exp_payload = entry->val;
+                ruc.delay = SCRIPT_POLL_DELAY;
+                ruc.retry_cnt = MFRC522_DRV_DEF_RETRY_CNT;
+                ruc.max_delay = SCRIPT_POLL_MAX_DELAY;
+                deadline_set(conf, &ruc, MFRC522_CONF_DEADLINE_CMD);
+                status = mfrc522_drv_read_until(conf, &ruc);
+                ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+                continue;
+            }
+            default:
+                return mfrc522_drv_status_nok;
+        }
+
+        if (cacheable) {
+            known_vals[entry->addr] = val;
+        }
+        status = script_batch_add_write(conf, &batch, entry->addr, val);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+        /* Registers modified behind a barrier are read once it is sent */
+        if (script_entry_barrier(entry)) {
+            status = script_batch_flush(conf, &batch);
+            ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+            status = script_prefetch(conf, &batch, &script[i + 1], sz - i - 1, known_vals);
+            ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        }
+    }
+
+    return script_batch_flush(conf, &batch);
+}
+
+mfrc522_drv_status
+mfrc522_drv_soft_reset(const mfrc522_drv_conf* conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+
+    /* Populate read settings */
+    mfrc522_drv_read_until_conf ruc = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+    ruc.addr = mfrc522_reg_command;
+    ruc.mask = MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD);
+    ruc.exp_payload = mfrc522_reg_cmd_idle;
+    ruc.delay = 25;
+    ruc.retry_cnt = MFRC522_DRV_DEF_RETRY_CNT;
+    ruc.first_delay = 50; /* Oscillator restarts after reset, so the device is busy for tens of microseconds */
+    ruc.max_delay = 400;
+    deadline_set(conf, &ruc, MFRC522_CONF_DEADLINE_SOFT_RESET);
+
+    /* Send SoftReset command. Do not care of other bits - they will be set to defaults afterwards */
+    mfrc522_drv_status res = mfrc522_drv_write_byte(conf, mfrc522_reg_command, mfrc522_reg_cmd_soft_reset);
+    ERROR_IF_NEQ(res, mfrc522_drv_status_ok);
+
+    /* Wait until Idle command is active back */
+    res = mfrc522_drv_read_until(conf, &ruc);
+    ERROR_IF_NEQ(res, mfrc522_drv_status_ok);
+
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_tim_set(mfrc522_drv_tim_conf* tim_conf, u16 period)
+{
+    NOT_NULL(tim_conf, mfrc522_drv_status_nullptr);
+    if (UNLIKELY(0 == period || period > MFRC522_DRV_TIM_MAX_PERIOD)) {
+        return mfrc522_drv_status_tim_prd_err;
+    }
+
+    /*
+     * The formula used to calculate reload value (with TPrescaler == 1694):
+     * TReload = 4 * period - 1
+     */
+    tim_conf->prescaler = TIMER_PRESCALER;
+    tim_conf->prescaler_type = mfrc522_drv_tim_psl_even;
+    tim_conf->reload_val = (4 * period) - 1;
+#if MFRC522_CONF_TIM_RELOAD_FIXED
+    ++tim_conf->reload_val;
+#endif
+
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_tim_start(const mfrc522_drv_conf* conf, const mfrc522_drv_tim_conf* tim_conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(tim_conf, mfrc522_drv_status_nullptr);
+
+    u8 prescaler_lo = (u8)(tim_conf->prescaler & 0x00FF);
     u8 prescaler_hi = (u8)((tim_conf->prescaler & 0x0F00) >> 8);
-    mfrc522_drv_status status = mfrc522_drv_write_byte(conf, mfrc522_reg_tim_prescaler, prescaler_lo);
+    u8 prescaler_type = (tim_conf->prescaler_type == mfrc522_drv_tim_psl_even);
+    u8 reload_lo = (u8)(tim_conf->reload_val & 0x00FF);
+    u8 reload_hi = (u8)((tim_conf->reload_val & 0xFF00) >> 8);
+
+    const mfrc522_drv_script_entry script[] = {
+        /* Write to prescaler Lo and Hi registers */
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_prescaler, prescaler_lo),
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_tim_mode, prescaler_hi, TMODE_TPHI),
+        /* Enable/disable periodicity and automatic start flags. Consecutive writes of TModeReg are sent as one */
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_tim_mode, tim_conf->periodic, TMODE_TAUTO_RESTART),
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_tim_mode, tim_conf->auto_start, TMODE_TAUTO),
+        /* Write to prescaler type register */
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_demod, prescaler_type, DEMOD_TPE),
+        /* Write to reload Lo and Hi registers */
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_reload_lo, reload_lo),
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_reload_hi, reload_hi),
+        /* Immediately start timer. It has to be the last entry, since it is skipped in case of automatic start */
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_control, 1, CONTROL_TSTART)
+    };
+    return mfrc522_drv_script_exec(conf, script, SIZE_ARRAY(script) - (tim_conf->auto_start ? 1 : 0));
+}
+
+mfrc522_drv_status
+mfrc522_drv_tim_stop(const mfrc522_drv_conf* conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+
+    mfrc522_drv_status status;
+    status = mfrc522_drv_write_masked(conf, mfrc522_reg_control, 1, MFRC522_REG_FIELD(CONTROL_TSTOP));
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_irq_init(const mfrc522_drv_conf* conf, const mfrc522_drv_irq_conf* irq_conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(irq_conf, mfrc522_drv_status_nullptr);
+
+    const mfrc522_drv_script_entry script[] = {
+        /* Clear all interrupt flags */
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_com_irq, IRQ_ALL_COM_MASK),
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_div_irq, IRQ_ALL_DIV_MASK),
+        /* Update IRQ flags */
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_com_irq_en, irq_conf->irq_signal_inv, COMIEN_IRQ_INV),
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_div_irq_en, irq_conf->irq_push_pull, DIVIEN_IRQ_PUSHPULL)
+    };
+    return mfrc522_drv_script_exec(conf, script, SIZE_ARRAY(script));
+}
+
+mfrc522_drv_status
+mfrc522_drv_irq_clr(const mfrc522_drv_conf* conf, mfrc522_reg_irq irq)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+
+    mfrc522_drv_status status;
+
+    /* Clear all interrupts if special flag was passed */
+    if (mfrc522_reg_irq_all == irq) {
+        status = mfrc522_drv_write_byte(conf, mfrc522_reg_com_irq, IRQ_ALL_COM_MASK);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        status = mfrc522_drv_write_byte(conf, mfrc522_reg_div_irq, IRQ_ALL_DIV_MASK);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    } else {
+        /* Find correct register to clear interrupt flag in */
+        u8 reg;
+        if (irq & MFRC522_REG_IRQ_DIV) {
+            irq &= ~MFRC522_REG_IRQ_DIV;
+            reg = mfrc522_reg_div_irq;
+        } else {
+            reg = mfrc522_reg_com_irq;
+        }
+        status = mfrc522_drv_write_byte(conf, reg, 1 << irq);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    }
+
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_irq_en(const mfrc522_drv_conf* conf, mfrc522_reg_irq irq, bool enable)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    ERROR_IF_EQ(irq, mfrc522_reg_irq_all, mfrc522_drv_status_nok);
+
+    /* Find correct register to enable interrupt */
+    u8 reg;
+    if (irq & MFRC522_REG_IRQ_DIV) {
+        irq &= ~MFRC522_REG_IRQ_DIV;
+        reg = mfrc522_reg_div_irq_en;
+    } else {
+        reg = mfrc522_reg_com_irq_en;
+    }
+    mfrc522_drv_status status = mfrc522_drv_write_masked(conf, reg, enable, 0x01, irq);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_tim_mode, prescaler_hi, MFRC522_REG_FIELD(TMODE_TPHI));
+
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_irq_states(const mfrc522_drv_conf* conf, u16* out)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(out, mfrc522_drv_status_nullptr);
+
+    static const mfrc522_reg regs[] = {mfrc522_reg_com_irq, mfrc522_reg_div_irq};
+    u8 irq[SIZE_ARRAY(regs)];
+    mfrc522_drv_status status = mfrc522_drv_read_regs(conf, regs, SIZE_ARRAY(regs), irq);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* Write to prescaler type register */
-    u8 prescaler_type = (tim_conf->prescaler_type == mfrc522_drv_tim_psl_even);
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_demod, prescaler_type, MFRC522_REG_FIELD(DEMOD_TPE));
+    *out = irq[0] | (irq[1] << 8);
+
+    return mfrc522_drv_status_ok;
+}
+
+bool
+mfrc522_drv_irq_pending(u16 irq_states, mfrc522_reg_irq irq)
+{
+    /* If 'mfrc522_reg_irq_all' was passed return an error and exit */
+    ERROR_IF_EQ(irq, mfrc522_reg_irq_all, false);
+
+    if (irq & MFRC522_REG_IRQ_DIV) {
+        irq &= ~MFRC522_REG_IRQ_DIV;
+        irq += 8;
+    }
+    return (irq_states & (1 << irq)) ? true : false;
+}
+
+mfrc522_drv_status
+mfrc522_drv_self_test(mfrc522_drv_conf* conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+
+    mfrc522_drv_status status;
+
+    /* Step 1 - Perform a soft reset */
+    status = mfrc522_drv_soft_reset(conf);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* Write to reload Lo and Hi registers */
-    u8 reload_lo = (u8)(tim_conf->reload_val & 0x00FF);
-    u8 reload_hi = (u8)((tim_conf->reload_val & 0xFF00) >> 8);
-    status = mfrc522_drv_write_byte(conf, mfrc522_reg_tim_reload_lo, reload_lo);
+    /* Step 2 - Clear the internal buffer by writing 25 bytes of 00h */
+    status = mfrc522_drv_fifo_store(conf, 0x00);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_mem);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Step 3 - Enable the self test by writing 09h to the AutoTestReg register */
+    status = mfrc522_drv_write_masked(conf, mfrc522_reg_auto_test, 0x09, MFRC522_REG_FIELD(AUTOTEST_SELFTEST));
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Step 4 - Write 00h to the FIFO buffer */
+    status = mfrc522_drv_fifo_store(conf, 0x00);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Step 5 - Start the self test with the CalcCRC command */
+    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_crc);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Step 6 - Wait until FIFO buffer contains 64 bytes */
+    mfrc522_drv_read_until_conf rc = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+    rc.addr = mfrc522_reg_fifo_level;
+    rc.mask = 0xFF;
+    rc.exp_payload = 0x40; /* 64 bytes */
+    rc.delay = 100;
+    rc.retry_cnt = MFRC522_DRV_DEF_RETRY_CNT;
+    rc.max_delay = 800;
+    deadline_set(conf, &rc, MFRC522_CONF_DEADLINE_SELF_TEST);
+
+    status = mfrc522_drv_read_until(conf, &rc);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Step 7 - Read content from the FIFO buffer and store it inside device's configuration structure */
+    status = mfrc522_drv_fifo_read_mul(conf, conf->self_test_out, MFRC522_DRV_SELF_TEST_FIFO_SZ);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Step 8 - Compare output bytes with expected ones */
+    u8 expected[MFRC522_DRV_SELF_TEST_FIFO_SZ] = {MFRC522_CONF_SELF_TEST_FIFO_OUT};
+    if (UNLIKELY(memcmp(expected, conf->self_test_out, MFRC522_DRV_SELF_TEST_FIFO_SZ))) {
+        return mfrc522_drv_status_self_test_err;
+    }
+
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_bringup(mfrc522_drv_conf* conf, const mfrc522_drv_bringup_conf* bu_conf, bool* warm)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(bu_conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(bu_conf->image, mfrc522_drv_status_nullptr);
+    NOT_NULL(warm, mfrc522_drv_status_nullptr);
+
+    *warm = false;
+
+    /* Other registers may change on their own, so they tell nothing about a configuration applied by a host */
+    for (size i = 0; i < bu_conf->image_sz; ++i) {
+        const mfrc522_drv_script_entry* entry = &bu_conf->image[i];
+        if (UNLIKELY(((mfrc522_drv_script_op_write != entry->op) &&
+                      (mfrc522_drv_script_op_write_masked != entry->op)) ||
+                     !mfrc522_drv_reg_cacheable(entry->addr))) {
+            return mfrc522_drv_status_nok;
+        }
+    }
+
+    mfrc522_drv_status status = ll_init(conf);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Chip identity, state of a command and current contents of the image are fetched in one batch */
+    u8 command;
+    u8 current[MFRC522_DRV_REG_NUM];
+    u64 requested = 0;
+    script_batch batch;
+    batch.num = 0;
+
+    status = script_batch_add_read(conf, &batch, mfrc522_reg_version, &conf->chip_version);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    status = script_batch_add_read(conf, &batch, mfrc522_reg_command, &command);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    for (size i = 0; i < bu_conf->image_sz; ++i) {
+        u8 addr = bu_conf->image[i].addr;
+        if (!(requested & REG_BIT(addr))) {
+            status = script_batch_add_read(conf, &batch, addr, &current[addr]);
+            ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+            requested |= REG_BIT(addr);
+        }
+    }
+    status = script_batch_flush(conf, &batch);
+    if (UNLIKELY(mfrc522_drv_status_ok != status)) {
+        conf->chip_version = MFRC522_REG_VERSION_INVALID;
+        return mfrc522_drv_status_ll_err;
+    }
+
+    /* Chiptype 9xh stands for MFRC522 */
+    if (MFRC522_CONF_CHIP_TYPE != (conf->chip_version & MFRC522_REG_FIELD_MSK_REAL(VERSION_CHIPTYPE))) {
+        return mfrc522_drv_status_dev_err;
+    }
+
+    /* A device left idle and already holding the image (e.g. after a restart of a host process) is taken over as is */
+    u8 busy_msk = MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD) | MFRC522_REG_FIELD_MSK_REAL(COMMAND_POWER_DOWN);
+    if (!bu_conf->force_reset && (mfrc522_reg_cmd_idle == (command & busy_msk))) {
+        u8 target[MFRC522_DRV_REG_NUM];
+        memcpy(target, current, sizeof(target));
+        for (size i = 0; i < bu_conf->image_sz; ++i) {
+            const mfrc522_drv_script_entry* entry = &bu_conf->image[i];
+            target[entry->addr] = (target[entry->addr] & ~entry->mask) | (entry->val & entry->mask);
+        }
+
+        bool configured = true;
+        for (size i = 0; i < bu_conf->image_sz; ++i) {
+            configured = configured && (target[bu_conf->image[i].addr] == current[bu_conf->image[i].addr]);
+        }
+        if (configured) {
+            *warm = true;
+            return mfrc522_drv_status_ok;
+        }
+    }
+
+    /* Self test starts with a soft reset, so there is no need to perform it twice */
+    if (mfrc522_drv_bringup_self_test_run == bu_conf->self_test) {
+        status = mfrc522_drv_self_test(conf);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+        /* CalcCRC command keeps running and self test mode is still enabled after the procedure */
+        static const mfrc522_drv_script_entry script[] = {
+            MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_command, mfrc522_reg_cmd_idle, COMMAND_CMD),
+            MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_auto_test, 0x00, AUTOTEST_SELFTEST),
+        };
+        status = mfrc522_drv_script_exec(conf, script, SIZE_ARRAY(script));
+    } else {
+        status = mfrc522_drv_soft_reset(conf);
+    }
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    return mfrc522_drv_script_exec(conf, bu_conf->image, bu_conf->image_sz);
+}
+
+mfrc522_drv_status
+mfrc522_drv_invoke_cmd(const mfrc522_drv_conf* conf, mfrc522_reg_cmd cmd)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+
+    /* Write to command register */
+    mfrc522_drv_status status;
+    status = mfrc522_drv_write_masked(conf, mfrc522_reg_command, cmd, MFRC522_REG_FIELD(COMMAND_CMD));
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    mfrc522_drv_read_until_conf ru_conf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+    ru_conf.addr = mfrc522_reg_command;
+    ru_conf.mask = MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD);
+    ru_conf.exp_payload = mfrc522_reg_cmd_idle;
+    ru_conf.delay = 5; /* Give some delay */
+    ru_conf.retry_cnt = MFRC522_DRV_DEF_RETRY_CNT;
+    ru_conf.max_delay = 80;
+    deadline_set(conf, &ru_conf, MFRC522_CONF_DEADLINE_CMD);
+
+    switch (cmd) {
+        /* These commands terminate automatically. Wait until Idle command is active back */
+        case mfrc522_reg_cmd_idle:
+        case mfrc522_reg_cmd_mem:
+        case mfrc522_reg_cmd_rand:
+        case mfrc522_reg_cmd_soft_reset:
+            status = mfrc522_drv_read_until(conf, &ru_conf);
+            ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        default:
+            break;
+    }
+
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_crc_init(const mfrc522_drv_conf* conf, const mfrc522_drv_crc_conf* crc_conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(crc_conf, mfrc522_drv_status_nullptr);
+
+    /* Write to the registers associated with CRC coprocessor */
+    const mfrc522_drv_script_entry script[] = {
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_mode, crc_conf->preset, MODE_CRC_PRESET),
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_mode, crc_conf->msb_first, MODE_CRC_MSBFIRST)
+    };
+    return mfrc522_drv_script_exec(conf, script, SIZE_ARRAY(script));
+}
+
+mfrc522_drv_status
+mfrc522_drv_crc_compute(const mfrc522_drv_conf* conf, u16* out)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(out, mfrc522_drv_status_nullptr);
+
+    /* Start computing CRC */
+    mfrc522_drv_status status;
+    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_crc);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Wait until ready bit is set */
+    mfrc522_drv_read_until_conf ru_conf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+    ru_conf.addr = mfrc522_reg_status1;
+    ru_conf.exp_payload = 1 << MFRC522_REG_FIELD_POS(STATUS1_CRC_READY);
+    ru_conf.mask = MFRC522_REG_FIELD_MSK_REAL(STATUS1_CRC_READY);
+    ru_conf.retry_cnt = MFRC522_DRV_DEF_RETRY_CNT;
+    ru_conf.delay = 1; /* CRC of a frame is ready within a few microseconds */
+    ru_conf.max_delay = 16;
+    deadline_set(conf, &ru_conf, MFRC522_CONF_DEADLINE_CRC);
+    status = mfrc522_drv_read_until(conf, &ru_conf);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* CRC command does not terminate itself. Thus activate Idle command back */
+    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_idle);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    status = mfrc522_drv_write_byte(conf, mfrc522_reg_tim_reload_hi, reload_hi);
+
+    /* Read computed value and write into the buffer */
+    static const mfrc522_reg regs[] = {mfrc522_reg_crc_result_lsb, mfrc522_reg_crc_result_msb};
+    u8 crc[SIZE_ARRAY(regs)];
+    status = mfrc522_drv_read_regs(conf, regs, SIZE_ARRAY(regs), crc);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    *out = crc[0] | (crc[1] << 8);
 
-    /* Enable/disable periodicity flag */
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_tim_mode,
-                                      tim_conf->periodic, MFRC522_REG_FIELD(TMODE_TAUTO_RESTART));
+    return mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_generate_rand(const mfrc522_drv_conf* conf, u8* out, size num_rand)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(out, mfrc522_drv_status_nullptr);
+    if (num_rand > MFRC522_DRV_RAND_BYTES) {
+        num_rand = MFRC522_DRV_RAND_BYTES;
+    }
+
+    mfrc522_drv_status status;
+    /* Invoke 'Random' command */
+    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_rand);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    /* Copy bytes from internal buffer into the FIFO buffer */
+    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_mem);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* Immediately start timer */
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_control, 1, MFRC522_REG_FIELD(CONTROL_TSTART));
+    /* Copy data from the FIFO buffer */
+    size rand_bytes_idx[MFRC522_DRV_RAND_BYTES] = {MFRC522_CONF_RAND_BYTE_IDX};
+    u8 rand_bytes[MFRC522_DRV_RAND_BYTES];
+    u8 buff[MFRC522_DRV_RAND_TOTAL];
+    status = mfrc522_drv_fifo_read_mul(conf, buff, MFRC522_DRV_RAND_TOTAL);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
+    size current_idx = 0;
+    for (size i = 0; i < MFRC522_DRV_RAND_TOTAL; ++i) {
+        for (size j = 0; j < MFRC522_DRV_RAND_BYTES; ++j) {
+            if (i == rand_bytes_idx[j]) {
+                rand_bytes[current_idx++] = buff[i];
+            }
+        }
+    }
+
+    /* Copy requested number of random bytes into the final buffer */
+    memcpy(out, rand_bytes, num_rand);
+
     return mfrc522_drv_status_ok;
 }
 
-mfrc522_drv_status
-mfrc522_drv_tim_stop(const mfrc522_drv_conf* conf)
+bool
+mfrc522_drv_check_error(u8 error_reg, mfrc522_reg_err err)
 {
-    NOT_NULL(conf, mfrc522_drv_status_nullptr);
-
-    mfrc522_drv_status status;
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_control, 1, MFRC522_REG_FIELD(CONTROL_TSTOP));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-
-    return mfrc522_drv_status_ok;
+    if (mfrc522_reg_err_any == err) {
+        return (0 != error_reg);
+    }
+    return (error_reg & (1 << err)) ? true : false;
 }
 
 mfrc522_drv_status
-mfrc522_drv_irq_init(const mfrc522_drv_conf* conf, const mfrc522_drv_irq_conf* irq_conf)
+mfrc522_drv_ext_itf_init(const mfrc522_drv_conf* conf, const mfrc522_drv_ext_itf_conf* itf_conf)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(irq_conf, mfrc522_drv_status_nullptr);
-
-    /* Clear all interrupt flags */
-    mfrc522_drv_irq_clr(conf, mfrc522_reg_irq_all);
-
-    /* Update IRQ flags */
-    mfrc522_drv_status status = mfrc522_drv_write_masked(conf, mfrc522_reg_com_irq_en,
-                                                         irq_conf->irq_signal_inv, MFRC522_REG_FIELD(COMIEN_IRQ_INV));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_div_irq_en,
-                                      irq_conf->irq_push_pull, MFRC522_REG_FIELD(DIVIEN_IRQ_PUSHPULL));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    NOT_NULL(itf_conf, mfrc522_drv_status_nullptr);
 
-    return mfrc522_drv_status_ok;
+    static const mfrc522_drv_script_entry script[] = {
+        /* Force a 100% ASK modulation */
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_tx_ask, 1, TXASK_FORCE_ASK),
+        /* Configure TX RF */
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_tx_control, 1, TXCONTROL_TX1RFEN),
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_tx_control, 1, TXCONTROL_TX2RFEN),
+        /* Switch on analog part of the receiver */
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_command, 0, COMMAND_RCVOFF)
+    };
+    return mfrc522_drv_script_exec(conf, script, SIZE_ARRAY(script));
 }
 
 mfrc522_drv_status
-mfrc522_drv_irq_clr(const mfrc522_drv_conf* conf, mfrc522_reg_irq irq)
+mfrc522_drv_transceive(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_conf* tr_conf)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(tr_conf, mfrc522_drv_status_nullptr);
 
-    mfrc522_drv_status status;
+    mfrc522_drv_transceive_op op;
+    op.tr_conf = *tr_conf;
+    mfrc522_drv_status status = transceive_start(conf, &op, irq_wait_supported(conf));
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* Clear all interrupts if special flag was passed */
-    if (mfrc522_reg_irq_all == irq) {
-        status = mfrc522_drv_write_byte(conf, mfrc522_reg_com_irq, IRQ_ALL_COM_MASK);
-        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-        status = mfrc522_drv_write_byte(conf, mfrc522_reg_div_irq, IRQ_ALL_DIV_MASK);
-        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    if (op.irq_pin) {
+        /* The bus stays free until the device signals completion. IRQ registers are read once per wake-up. A wake-up
+         * which does not complete the operation (e.g. a stale edge) is followed by a wait for the rest of the budget.
+         * Without a clock the number of wake-ups is bounded by poll limit */
+        status = mfrc522_drv_status_in_progress;
+        while (mfrc522_drv_status_in_progress == status) {
+            u32 timeout = MFRC522_CONF_IRQ_WAIT_TIMEOUT;
+            if (op.budget) {
+                u32 elapsed = (u32)(clock_now(conf) - op.started);
+                timeout = (elapsed < op.budget) ? (op.budget - elapsed) : 0;
+            }
+
+            mfrc522_ll_status ll_status = irq_wait(conf, timeout);
+            if (mfrc522_ll_status_timeout == ll_status) {
+                op.state = mfrc522_drv_transceive_state_done; /* No response if the pin is still inactive */
+                break;
+            }
+            if (UNLIKELY(mfrc522_ll_status_ok != ll_status)) {
+                status = mfrc522_drv_status_ll_err; /* Interrupts routed to IRQ pin are restored below */
+                break;
+            }
+            status = mfrc522_drv_transceive_poll(conf, &op);
+        }
     } else {
-        /* Find correct register to clear interrupt flag in */
-        u8 reg;
-        if (irq & MFRC522_REG_IRQ_DIV) {
-            irq &= ~MFRC522_REG_IRQ_DIV;
-            reg = mfrc522_reg_div_irq;
-        } else {
-            reg = mfrc522_reg_com_irq;
+        status = mfrc522_drv_transceive_poll(conf, &op);
+        while (mfrc522_drv_status_in_progress == status) {
+            delay(conf, op.poll_delay); /* Make some delay */
+            status = mfrc522_drv_transceive_poll(conf, &op);
         }
-        status = mfrc522_drv_write_byte(conf, reg, 1 << irq);
-        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
     }
 
-    return mfrc522_drv_status_ok;
+    /* Registers modified by the command are restored even if polling or waiting for IRQ pin failed */
+    if (UNLIKELY((mfrc522_drv_status_ok != status) && (mfrc522_drv_status_in_progress != status))) {
+        transceive_restore(conf, &op);
+        return status;
+    }
+
+    status = mfrc522_drv_transceive_finish(conf, &op);
+    tr_conf->rx_len = op.tr_conf.rx_len;
+    tr_conf->rx_last_bits = op.tr_conf.rx_last_bits;
+    tr_conf->coll_pos = op.tr_conf.coll_pos;
+    return status;
 }
 
 mfrc522_drv_status
-mfrc522_drv_irq_en(const mfrc522_drv_conf* conf, mfrc522_reg_irq irq, bool enable)
+mfrc522_drv_transceive_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op,
+                             const mfrc522_drv_transceive_conf* tr_conf)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    ERROR_IF_EQ(irq, mfrc522_reg_irq_all, mfrc522_drv_status_nok);
-
-    /* Find correct register to enable interrupt */
-    u8 reg;
-    if (irq & MFRC522_REG_IRQ_DIV) {
-        irq &= ~MFRC522_REG_IRQ_DIV;
-        reg = mfrc522_reg_div_irq_en;
-    } else {
-        reg = mfrc522_reg_com_irq_en;
-    }
-    mfrc522_drv_status status = mfrc522_drv_write_masked(conf, reg, enable, 0x01, irq);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
+    NOT_NULL(tr_conf, mfrc522_drv_status_nullptr);
 
-    return mfrc522_drv_status_ok;
+    op->tr_conf = *tr_conf;
+    return transceive_start(conf, op, false);
 }
 
 mfrc522_drv_status
-mfrc522_drv_irq_states(const mfrc522_drv_conf* conf, u16* out)
+mfrc522_drv_transceive_poll(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(out, mfrc522_drv_status_nullptr);
-
-    u8 com_irq;
-    u8 div_irq;
-    mfrc522_drv_status status = mfrc522_drv_read(conf, mfrc522_reg_com_irq, &com_irq);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    status = mfrc522_drv_read(conf, mfrc522_reg_div_irq, &div_irq);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-
-    *out = com_irq | (div_irq << 8);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
 
-    return mfrc522_drv_status_ok;
-}
+    switch (op->state) {
+        case mfrc522_drv_transceive_state_busy:
+            break;
+        case mfrc522_drv_transceive_state_done:
+            return mfrc522_drv_status_ok;
+        default: /* Not started */
+            return mfrc522_drv_status_nok;
+    }
 
-bool
-mfrc522_drv_irq_pending(u16 irq_states, mfrc522_reg_irq irq)
-{
-    /* If 'mfrc522_reg_irq_all' was passed return an error and exit */
-    ERROR_IF_EQ(irq, mfrc522_reg_irq_all, false);
+    u16 irq_states;
+    mfrc522_drv_status status = mfrc522_drv_irq_states(conf, &irq_states);
+    if (UNLIKELY(mfrc522_drv_status_ok != status)) {
+        op->result = status;
+        op->state = mfrc522_drv_transceive_state_done;
+        return status;
+    }
 
-    if (irq & MFRC522_REG_IRQ_DIV) {
-        irq &= ~MFRC522_REG_IRQ_DIV;
-        irq += 8;
+    transceive_check_irqs(op, irq_states);
+    ++op->polls;
+    bool expired = op->budget ? ((u32)(clock_now(conf) - op->started) >= op->budget) : (op->polls >= op->poll_limit);
+    if (mfrc522_drv_transceive_state_busy == op->state && expired) {
+        /* Result is already set to timeout */
+        op->state = mfrc522_drv_transceive_state_done;
     }
-    return (irq_states & (1 << irq)) ? true : false;
+
+    return (mfrc522_drv_transceive_state_done == op->state) ? mfrc522_drv_status_ok : mfrc522_drv_status_in_progress;
 }
 
 mfrc522_drv_status
-mfrc522_drv_self_test(mfrc522_drv_conf* conf)
+mfrc522_drv_transceive_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
+    if (UNLIKELY(mfrc522_drv_transceive_state_done != op->state)) {
+        return mfrc522_drv_status_nok;
+    }
+    op->state = mfrc522_drv_transceive_state_idle;
 
-    mfrc522_drv_status status;
-
-    /* Step 1 - Perform a soft reset */
-    status = mfrc522_drv_soft_reset(conf);
+    const mfrc522_drv_transceive_conf* tr_conf = &op->tr_conf;
+    mfrc522_drv_status status = transceive_restore(conf, op);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* Step 2 - Clear the internal buffer by writing 25 bytes of 00h */
-    status = mfrc522_drv_fifo_store(conf, 0x00);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_mem);
+    mfrc522_drv_read_until_conf ru_conf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+    ru_conf.addr = mfrc522_reg_command;
+    ru_conf.mask = MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD);
+    ru_conf.exp_payload = mfrc522_reg_cmd_idle;
+    ru_conf.delay = 5; /* Give some delay */
+    ru_conf.retry_cnt = MFRC522_DRV_DEF_RETRY_CNT;
+    ru_conf.max_delay = 80;
+    deadline_set(conf, &ru_conf, MFRC522_CONF_DEADLINE_CMD);
+    status = mfrc522_drv_read_until(conf, &ru_conf);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* Step 3 - Enable the self test by writing 09h to the AutoTestReg register */
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_auto_test, 0x09, MFRC522_REG_FIELD(AUTOTEST_SELFTEST));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    /* Tell wrong CRC of RX data and bit collisions apart from other errors */
+    bool collision = false;
+    if ((tr_conf->hw_crc || tr_conf->rx_var_len) && mfrc522_drv_status_transceive_err == op->result) {
+        u8 error;
+        u8 coll = 0;
+        const mfrc522_ll_xfer err_xfers[] = {
+            {mfrc522_reg_error, 1, NULL, &error},
+            {mfrc522_reg_coll, 1, NULL, &coll},
+        };
+        status = ll_transfer(conf, err_xfers, tr_conf->rx_var_len ? 2 : 1);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        if (tr_conf->hw_crc && (error & MFRC522_REG_FIELD_MSK_REAL(ERROR_CRC_ERR))) {
+            return mfrc522_drv_status_crc_err;
+        }
 
-    /* Step 4 - Write 00h to the FIFO buffer */
-    status = mfrc522_drv_fifo_store(conf, 0x00);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        /* Position of the collision is counted from the first received bit. Zero stands for the 32nd bit */
+        collision = tr_conf->rx_var_len && (error & MFRC522_REG_FIELD_MSK_REAL(ERROR_COLL_ERR)) &&
+                    !(coll & MFRC522_REG_FIELD_MSK_REAL(COLL_POS_NOT_VALID));
+        if (collision) {
+            u8 pos = coll & MFRC522_REG_FIELD_MSK_REAL(COLL_POS);
+            op->tr_conf.coll_pos = tr_conf->rx_align + (pos ? pos : 32);
+        }
+    }
 
-    /* Step 5 - Start the self test with the CalcCRC command */
-    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_crc);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    /* Response is missing, at least one error bit is present or polling failed */
+    if (!collision) {
+        ERROR_IF_NEQ(op->result, mfrc522_drv_status_ok);
+    }
 
-    /* Step 6 - Wait until FIFO buffer contains 64 bytes */
-    mfrc522_drv_read_until_conf rc;
-    rc.addr = mfrc522_reg_fifo_level;
-    rc.mask = 0xFF;
-    rc.exp_payload = 0x40; /* 64 bytes */
-    rc.delay = 100;
-    rc.retry_cnt = MFRC522_DRV_DEF_RETRY_CNT;
+    /* Get RX data if desired */
+    if (0 != tr_conf->rx_data_sz) {
+        /* Get valid bits of the last byte and RX data size at once */
+        u8 control;
+        u8 rx_bytes;
+        const mfrc522_ll_xfer rx_xfers[] = {
+            {mfrc522_reg_control, 1, NULL, &control},
+            {mfrc522_reg_fifo_level, 1, NULL, &rx_bytes}
+        };
+        status = ll_transfer(conf, rx_xfers, SIZE_ARRAY(rx_xfers));
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    status = mfrc522_drv_read_until(conf, &rc);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        /* Incomplete last byte is accepted only if length of RX data is not known in advance */
+        u8 rx_last_bits = (control & MFRC522_REG_FIELD_MSK_REAL(CONTROL_RX_LASTBITS)) >>
+                          MFRC522_REG_FIELD_POS(CONTROL_RX_LASTBITS);
+        if (UNLIKELY(rx_last_bits && !tr_conf->rx_var_len)) {
+            return mfrc522_drv_status_transceive_rx_mism;
+        }
 
-    /* Step 7 - Read content from the FIFO buffer and store it inside device's configuration structure */
-    u8 buff;
-    for (size i = 0; i < 64; ++i) {
-        status = mfrc522_drv_fifo_read(conf, &buff);
+        if (collision) {
+            /* Bits following the collision are not valid anyway */
+            rx_bytes = (rx_bytes > tr_conf->rx_data_sz) ? tr_conf->rx_data_sz : rx_bytes;
+        } else if (tr_conf->rx_var_len) {
+            /* Response of any length fitting into RX buffer is valid */
+            if (UNLIKELY(0 == rx_bytes || rx_bytes > tr_conf->rx_data_sz)) {
+                return mfrc522_drv_status_transceive_rx_mism;
+            }
+        } else {
+            /* RX data size error. Checked CRC may be left behind the data, it is not read then */
+            bool crc_left = tr_conf->hw_crc && (rx_bytes == tr_conf->rx_data_sz + CRC_A_SZ);
+            if (UNLIKELY(rx_bytes != tr_conf->rx_data_sz && !crc_left)) {
+                return mfrc522_drv_status_transceive_rx_mism;
+            }
+            rx_bytes = tr_conf->rx_data_sz;
+        }
+
+        /* Get FIFO contents */
+        status = mfrc522_drv_fifo_read_mul(conf, tr_conf->rx_data, rx_bytes);
         ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-        conf->self_test_out[i] = buff;
+        op->tr_conf.rx_len = rx_bytes;
+        op->tr_conf.rx_last_bits = rx_last_bits;
     }
 
-    /* Step 8 - Compare output bytes with expected ones */
-    u8 expected[MFRC522_DRV_SELF_TEST_FIFO_SZ] = {MFRC522_CONF_SELF_TEST_FIFO_OUT};
-    if (UNLIKELY(memcmp(expected, conf->self_test_out, MFRC522_DRV_SELF_TEST_FIFO_SZ))) {
-        return mfrc522_drv_status_self_test_err;
+    return collision ? mfrc522_drv_status_collision : mfrc522_drv_status_ok;
+}
+
+mfrc522_drv_status
+mfrc522_drv_transceive_irq_en(const mfrc522_drv_conf* conf, bool enable)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+
+    static const mfrc522_reg_irq irqs[] = {
+        mfrc522_reg_irq_rx, mfrc522_reg_irq_idle, mfrc522_reg_irq_err, mfrc522_reg_irq_timer
+    };
+    for (size i = 0; i < SIZE_ARRAY(irqs); ++i) {
+        mfrc522_drv_status status = mfrc522_drv_irq_en(conf, irqs[i], enable);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
     }
 
     return mfrc522_drv_status_ok;
 }
 
 mfrc522_drv_status
-mfrc522_drv_invoke_cmd(const mfrc522_drv_conf* conf, mfrc522_reg_cmd cmd)
+mfrc522_drv_reqa(const mfrc522_drv_conf* conf, u16* atqa)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(atqa, mfrc522_drv_status_nullptr);
 
-    /* Write to command register */
-    mfrc522_drv_status status;
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_command, cmd, MFRC522_REG_FIELD(COMMAND_CMD));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    u8 reqa;
+    u8 response[2];
+    mfrc522_drv_transceive_conf tr_conf;
+    reqa_prepare(&tr_conf, &reqa, &response[0]);
 
-    mfrc522_drv_read_until_conf ru_conf;
-    ru_conf.addr = mfrc522_reg_command;
-    ru_conf.mask = MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD);
-    ru_conf.exp_payload = mfrc522_reg_cmd_idle;
-    ru_conf.delay = 5; /* Give some delay */
-    ru_conf.retry_cnt = MFRC522_DRV_DEF_RETRY_CNT;
+    /* Handle transmission/reception of the data */
+    mfrc522_drv_status status = mfrc522_drv_transceive(conf, &tr_conf);
+    return reqa_complete(conf, status, &response[0], atqa);
+}
 
-    switch (cmd) {
-        /* These commands terminate automatically. Wait until Idle command is active back */
-        case mfrc522_reg_cmd_idle:
-        case mfrc522_reg_cmd_mem:
-        case mfrc522_reg_cmd_rand:
-        case mfrc522_reg_cmd_soft_reset:
-            status = mfrc522_drv_read_until(conf, &ru_conf);
-            ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-        default:
-            break;
-    }
+mfrc522_drv_status
+mfrc522_drv_anticollision(const mfrc522_drv_conf* conf, u8* serial)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(serial, mfrc522_drv_status_nullptr);
 
-    return mfrc522_drv_status_ok;
+    /* Transceive the data */
+    u8 tx[2];
+    mfrc522_drv_transceive_conf tr_conf;
+    anticollision_prepare(&tr_conf, mfrc522_picc_cmd_anticoll_cl1, &tx[0], serial);
+    mfrc522_drv_status status = mfrc522_drv_transceive(conf, &tr_conf);
+
+    /* Compute checksum */
+    return anticollision_complete(status, serial);
 }
 
 mfrc522_drv_status
-mfrc522_drv_crc_init(const mfrc522_drv_conf* conf, const mfrc522_drv_crc_conf* crc_conf)
+mfrc522_drv_select(const mfrc522_drv_conf* conf, const u8* serial, u8* sak)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(crc_conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(serial, mfrc522_drv_status_nullptr);
+    NOT_NULL(sak, mfrc522_drv_status_nullptr);
 
-    /* Write to the registers associated with CRC coprocessor */
-    mfrc522_drv_status status;
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_mode, crc_conf->preset, MFRC522_REG_FIELD(MODE_CRC_PRESET));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_mode,
-                                      crc_conf->msb_first, MFRC522_REG_FIELD(MODE_CRC_MSBFIRST));
+    /* Build TX data */
+    u8 tx[9];
+    u8 rx[3];
+    mfrc522_drv_transceive_conf tr_conf;
+    mfrc522_drv_status status = select_prepare(conf, &tr_conf, mfrc522_picc_cmd_select_cl1, serial, &tx[0], &rx[0]);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    return mfrc522_drv_status_ok;
+    /* Transceive the data */
+    status = mfrc522_drv_transceive(conf, &tr_conf);
+    return select_complete(conf, status, &rx[0], sak);
 }
 
 mfrc522_drv_status
-mfrc522_drv_crc_compute(const mfrc522_drv_conf* conf, u16* out)
+mfrc522_drv_select_uid(const mfrc522_drv_conf* conf, mfrc522_picc_uid* uid)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(out, mfrc522_drv_status_nullptr);
+    NOT_NULL(uid, mfrc522_drv_status_nullptr);
+
+    static const mfrc522_picc_cmd anticoll_cmds[MFRC522_PICC_CASCADE_LEVELS] = {
+        mfrc522_picc_cmd_anticoll_cl1, mfrc522_picc_cmd_anticoll_cl2, mfrc522_picc_cmd_anticoll_cl3};
+    static const mfrc522_picc_cmd select_cmds[MFRC522_PICC_CASCADE_LEVELS] = {
+        mfrc522_picc_cmd_select_cl1, mfrc522_picc_cmd_select_cl2, mfrc522_picc_cmd_select_cl3};
+
+    /* Known UID lets SELECT frames be built without asking a PICC, so ANTICOLLISION frames are skipped */
+    const bool known = (0 != uid->sz);
+    if (known && (4 != uid->sz) && (7 != uid->sz) && (10 != uid->sz)) {
+        return mfrc522_drv_status_nok;
+    }
 
-    /* Start computing CRC */
     mfrc522_drv_status status;
-    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_crc);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    mfrc522_drv_transceive_conf tr_conf;
+    u8 tx[9];
+    u8 rx[3];
+    u8 serial[5]; /* UID CLn followed by BCC */
+    size offset = 0; /* Number of UID bytes completed at previous cascade levels */
+
+    for (size level = 0; level < MFRC522_PICC_CASCADE_LEVELS; ++level) {
+        if (known) {
+            /* The last 4 bytes of UID are sent as they are, otherwise 3 bytes are preceded by cascade tag */
+            const bool last = (4 == (uid->sz - offset));
+            serial[0] = last ? uid->bytes[offset] : MFRC522_PICC_CASCADE_TAG;
+            memcpy(&serial[1], &uid->bytes[last ? (offset + 1) : offset], 3);
+            serial[4] = serial[0] ^ serial[1] ^ serial[2] ^ serial[3];
+        } else {
+            status = anticollision_resolve(conf, anticoll_cmds[level], serial);
+            ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        }
 
-    /* Wait until ready bit is set */
-    mfrc522_drv_read_until_conf ru_conf;
-    ru_conf.addr = mfrc522_reg_status1;
-    ru_conf.exp_payload = 1 << MFRC522_REG_FIELD_POS(STATUS1_CRC_READY);
-    ru_conf.mask = MFRC522_REG_FIELD_MSK_REAL(STATUS1_CRC_READY);
-    ru_conf.retry_cnt = MFRC522_DRV_DEF_RETRY_CNT;
-    ru_conf.delay = 1;
-    status = mfrc522_drv_read_until(conf, &ru_conf);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        u8 sak;
+        status = select_prepare(conf, &tr_conf, select_cmds[level], serial, &tx[0], &rx[0]);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        status = mfrc522_drv_transceive(conf, &tr_conf);
+        status = select_complete(conf, status, &rx[0], &sak);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* CRC command does not terminate itself. Thus activate Idle command back */
-    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_idle);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        /* Cascade bit of SAK tells whether UID is complete. Cascade tag never starts UID CLn of the last level */
+        const bool complete = !(sak & MFRC522_PICC_SAK_CASCADE);
+        if (UNLIKELY((complete == (MFRC522_PICC_CASCADE_TAG == serial[0])) ||
+                     (known && (complete != (4 == (uid->sz - offset)))))) {
+            return mfrc522_drv_status_cascade_err;
+        }
 
-    /* Read computed value and write into the buffer */
-    u8 crc_lo;
-    u8 crc_hi;
-    status = mfrc522_drv_read(conf, mfrc522_reg_crc_result_lsb, &crc_lo);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    status = mfrc522_drv_read(conf, mfrc522_reg_crc_result_msb, &crc_hi);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    *out = crc_lo | (crc_hi << 8);
+        if (complete) {
+            if (!known) {
+                memcpy(&uid->bytes[offset], &serial[0], 4);
+                uid->sz = (u8)(offset + 4);
+            }
+            uid->sak = sak;
+            return mfrc522_drv_status_ok;
+        }
+
+        if (!known) {
+            memcpy(&uid->bytes[offset], &serial[1], 3);
+        }
+        offset += 3;
+    }
+
+    /* SAK of CL3 still indicates an incomplete UID */
+    return mfrc522_drv_status_cascade_err;
+}
+
+mfrc522_drv_status
+mfrc522_drv_inventory(const mfrc522_drv_conf* conf, mfrc522_picc_uid* uids, size max, size* found)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(uids, mfrc522_drv_status_nullptr);
+    NOT_NULL(found, mfrc522_drv_status_nullptr);
+
+    *found = 0;
+    while (*found < max) {
+        /* Halted PICCs do not answer REQA, so silence means that all of them have been enumerated */
+        u16 atqa;
+        mfrc522_drv_status status = mfrc522_drv_reqa(conf, &atqa);
+        if (mfrc522_drv_status_transceive_timeout == status) {
+            break;
+        }
+
+        /* ATQA of different PICCs may collide */
+        if (UNLIKELY((mfrc522_drv_status_ok != status) && (mfrc522_drv_status_transceive_err != status) &&
+                     (mfrc522_drv_status_transceive_rx_mism != status))) {
+            return status;
+        }
+
+        mfrc522_picc_uid* uid = &uids[*found];
+        uid->sz = 0;
+        status = mfrc522_drv_select_uid(conf, uid);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        ++*found;
+
+        status = mfrc522_drv_halt(conf);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    }
 
     return mfrc522_drv_status_ok;
 }
 
 mfrc522_drv_status
-mfrc522_drv_generate_rand(const mfrc522_drv_conf* conf, u8* out, size num_rand)
+mfrc522_drv_authenticate(const mfrc522_drv_conf* conf, const mfrc522_drv_auth_conf* auth_conf)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(out, mfrc522_drv_status_nullptr);
-    if (num_rand > MFRC522_DRV_RAND_BYTES) {
-        num_rand = MFRC522_DRV_RAND_BYTES;
-    }
+    NOT_NULL(auth_conf, mfrc522_drv_status_nullptr);
 
-    mfrc522_drv_status status;
-    /* Invoke 'Random' command */
-    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_rand);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    /* Copy bytes from internal buffer into the FIFO buffer */
-    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_mem);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    /* Build TX data */
+    u8 tx[12];
+    mfrc522_drv_transceive_conf tr_conf;
+    authenticate_prepare(&tr_conf, auth_conf, &tx[0]);
 
-    /* Copy data from the FIFO buffer */
-    size rand_bytes_idx[MFRC522_DRV_RAND_BYTES] = {MFRC522_CONF_RAND_BYTE_IDX};
-    u8 rand_bytes[MFRC522_DRV_RAND_BYTES];
-    u8 buff;
-    size current_idx = 0;
-    for (size i = 0; i < MFRC522_DRV_RAND_TOTAL; ++i) {
-        status = mfrc522_drv_fifo_read(conf, &buff);
-        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-        for (size j = 0; j < MFRC522_DRV_RAND_BYTES; ++j) {
-            if (i == rand_bytes_idx[j]) {
-                rand_bytes[current_idx++] = buff;
-            }
-        }
-    }
+    /* Transceive the data */
+    mfrc522_drv_status status = mfrc522_drv_transceive(conf, &tr_conf);
+    return authenticate_complete(conf, status);
+}
 
-    /* Copy requested number of random bytes into the final buffer */
-    memcpy(out, rand_bytes, num_rand);
+mfrc522_drv_status
+mfrc522_drv_halt(const mfrc522_drv_conf* conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
 
-    return mfrc522_drv_status_ok;
+    /* TX data */
+    u8 tx[4];
+    mfrc522_drv_transceive_conf tr_conf;
+    mfrc522_drv_status status = halt_prepare(conf, &tr_conf, &tx[0]);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+
+    /* Transceive the data */
+    status = mfrc522_drv_transceive(conf, &tr_conf);
+    return halt_complete(conf, status);
 }
 
-bool
-mfrc522_drv_check_error(u8 error_reg, mfrc522_reg_err err)
+mfrc522_drv_status
+mfrc522_drv_reqa_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op)
 {
-    if (mfrc522_reg_err_any == err) {
-        return (0 != error_reg);
-    }
-    return (error_reg & (1 << err)) ? true : false;
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
+
+    op->state = mfrc522_drv_transceive_state_idle;
+    reqa_prepare(&op->tr_conf, &op->tx[0], &op->rx[0]);
+
+    return transceive_start(conf, op, false);
 }
 
 mfrc522_drv_status
-mfrc522_drv_ext_itf_init(const mfrc522_drv_conf* conf, const mfrc522_drv_ext_itf_conf* itf_conf)
+mfrc522_drv_reqa_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op, u16* atqa)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(itf_conf, mfrc522_drv_status_nullptr);
-
-    /* Force a 100% ASK modulation */
-    mfrc522_drv_status status;
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_tx_ask, 1, MFRC522_REG_FIELD(TXASK_FORCE_ASK));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
+    NOT_NULL(atqa, mfrc522_drv_status_nullptr);
 
-    /* Configure TX RF */
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_tx_control, 1, MFRC522_REG_FIELD(TXCONTROL_TX1RFEN));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_tx_control, 1, MFRC522_REG_FIELD(TXCONTROL_TX2RFEN));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    mfrc522_drv_status status = mfrc522_drv_transceive_finish(conf, op);
+    return reqa_complete(conf, status, &op->rx[0], atqa);
+}
 
-    /* Switch on analog part of the receiver */
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_command, 0, MFRC522_REG_FIELD(COMMAND_RCVOFF));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+mfrc522_drv_status
+mfrc522_drv_anticollision_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
 
-    return mfrc522_drv_status_ok;
+    anticollision_prepare(&op->tr_conf, mfrc522_picc_cmd_anticoll_cl1, &op->tx[0], &op->rx[0]);
+    return transceive_start(conf, op, false);
 }
 
 mfrc522_drv_status
-mfrc522_drv_transceive(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_conf* tr_conf)
+mfrc522_drv_anticollision_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op, u8* serial)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(tr_conf, mfrc522_drv_status_nullptr);
-    bool cmd_error = (mfrc522_reg_cmd_transceive != tr_conf->command) &&
-                     (mfrc522_reg_cmd_authent != tr_conf->command);
-    if (UNLIKELY(cmd_error)) {
-        return mfrc522_drv_status_nok;
-    }
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
+    NOT_NULL(serial, mfrc522_drv_status_nullptr);
 
-    /* Clear all IRQs */
-    mfrc522_drv_status status = mfrc522_drv_irq_clr(conf, mfrc522_reg_irq_all);
+    mfrc522_drv_status status = mfrc522_drv_transceive_finish(conf, op);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* Flush the FIFO buffer and store actual data */
-    status = mfrc522_drv_fifo_flush(conf);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    status = mfrc522_drv_fifo_store_mul(conf, tr_conf->tx_data, tr_conf->tx_data_sz);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    memcpy(serial, &op->rx[0], 5);
+    return anticollision_complete(status, serial);
+}
 
-    /* Invoke transceive command */
-    status = mfrc522_drv_invoke_cmd(conf, tr_conf->command);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+mfrc522_drv_status
+mfrc522_drv_select_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op, const u8* serial)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
+    NOT_NULL(serial, mfrc522_drv_status_nullptr);
 
-    /* Start transmission of the data */
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_bit_framing, 1, MFRC522_REG_FIELD(BITFRAMING_START));
+    op->state = mfrc522_drv_transceive_state_idle;
+    mfrc522_drv_status status =
+        select_prepare(conf, &op->tr_conf, mfrc522_picc_cmd_select_cl1, serial, &op->tx[0], &op->rx[0]);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    u16 irq_states;
-    bool exit_irq;
-    bool error;
-    size retry_total_num = get_real_retry_count(MFRC522_DRV_DEF_RETRY_CNT);
-    size retries;
-    for (retries = 0; retries < retry_total_num; ++retries) {
-        status = mfrc522_drv_irq_states(conf, &irq_states);
-        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    return transceive_start(conf, op, false);
+}
 
-        exit_irq = mfrc522_drv_irq_pending(irq_states, get_awaited_irq_num(tr_conf->command));
-        error = mfrc522_drv_irq_pending(irq_states, mfrc522_reg_irq_err);
-        if (exit_irq || error) {
-            break;
-        }
-        delay(conf, 1); /* Make some delay */
-    }
+mfrc522_drv_status
+mfrc522_drv_select_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op, u8* sak)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
+    NOT_NULL(sak, mfrc522_drv_status_nullptr);
 
-    /* End transmission of the data */
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_bit_framing, 0, MFRC522_REG_FIELD(BITFRAMING_START));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    mfrc522_drv_status status = mfrc522_drv_transceive_finish(conf, op);
+    return select_complete(conf, status, &op->rx[0], sak);
+}
 
-    /* Enter Idle state */
-    status = mfrc522_drv_invoke_cmd(conf, mfrc522_reg_cmd_idle);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+mfrc522_drv_status
+mfrc522_drv_authenticate_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op,
+                               const mfrc522_drv_auth_conf* auth_conf)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
+    NOT_NULL(auth_conf, mfrc522_drv_status_nullptr);
 
-    /* In case when response is missing */
-    if (UNLIKELY(retry_total_num == retries)) {
-        return mfrc522_drv_status_transceive_timeout;
-    }
+    authenticate_prepare(&op->tr_conf, auth_conf, &op->tx[0]);
+    return transceive_start(conf, op, false);
+}
 
-    /* In case when at least one error bit is present */
-    if (UNLIKELY(error)) {
-        return mfrc522_drv_status_transceive_err;
-    }
+mfrc522_drv_status
+mfrc522_drv_authenticate_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
 
-    /* Get RX data if desired */
-    if (0 != tr_conf->rx_data_sz) {
-        /* Get RX data size */
-        u8 valid_rx_bytes;
-        status = get_valid_rx_bytes(conf, &valid_rx_bytes);
-        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    mfrc522_drv_status status = mfrc522_drv_transceive_finish(conf, op);
+    return authenticate_complete(conf, status);
+}
 
-        /* RX data size error */
-        if (UNLIKELY(valid_rx_bytes != tr_conf->rx_data_sz)) {
-            return mfrc522_drv_status_transceive_rx_mism;
-        }
+mfrc522_drv_status
+mfrc522_drv_halt_start(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
 
-        /* Get FIFO contents */
-        for (size i = 0; i < tr_conf->rx_data_sz; ++i) {
-            status = mfrc522_drv_fifo_read(conf, &tr_conf->rx_data[i]);
-            ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-        }
-    }
+    op->state = mfrc522_drv_transceive_state_idle;
+    mfrc522_drv_status status = halt_prepare(conf, &op->tr_conf, &op->tx[0]);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    return mfrc522_drv_status_ok;
+    return transceive_start(conf, op, false);
 }
 
 mfrc522_drv_status
-mfrc522_drv_reqa(const mfrc522_drv_conf* conf, u16* atqa)
+mfrc522_drv_halt_finish(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(atqa, mfrc522_drv_status_nullptr);
+    NOT_NULL(op, mfrc522_drv_status_nullptr);
 
-    /* REQA is a bit oriented frame (7-bit), thus set proper register */
-    mfrc522_drv_status status;
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_bit_framing, 0x07, MFRC522_REG_FIELD(BITFRAMING_TX_LASTBITS));
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    mfrc522_drv_status status = mfrc522_drv_transceive_finish(conf, op);
+    return halt_complete(conf, status);
+}
 
-    /* Handle transmission/reception of the data */
-    u8 reqa = mfrc522_picc_cmd_reqa;
-    u8 response[2];
+mfrc522_drv_status
+mfrc522_drv_probe_init(const mfrc522_drv_conf* conf, mfrc522_drv_probe_ctx* probe, mfrc522_picc_cmd frame)
+{
+    NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(probe, mfrc522_drv_status_nullptr);
 
-    mfrc522_drv_transceive_conf tr_conf;
-    tr_conf.tx_data = &reqa;
-    tr_conf.tx_data_sz = 1;
-    tr_conf.rx_data = &response[0];
-    tr_conf.rx_data_sz = 2;
-    tr_conf.command = mfrc522_reg_cmd_transceive;
-    status = mfrc522_drv_transceive(conf, &tr_conf);
+    probe->active = false;
+    if (UNLIKELY(mfrc522_picc_cmd_reqa != frame && mfrc522_picc_cmd_wupa != frame)) {
+        return mfrc522_drv_status_nok;
+    }
 
-    switch (status) {
-        case mfrc522_drv_status_transceive_timeout:
-        case mfrc522_drv_status_transceive_err:
-        case mfrc522_drv_status_transceive_rx_mism:
-            *atqa = MFRC522_PICC_ATQA_INV;
-            return status;
-        case mfrc522_drv_status_ok:
-            /* Nothing to do here. Just exit the switch statement */
-            break;
-        default: /* Low-level error, etc. */
-            return status;
+    /* Get current values of the registers which are modified partially */
+    mfrc522_ll_xfer xfers[3];
+    size num = 0;
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_command, 1, NULL, &probe->command_prev};
+    if (!reg_cache_lookup(conf, mfrc522_reg_bit_framing, &probe->bit_framing_prev)) {
+        xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_bit_framing, 1, NULL, &probe->bit_framing_prev};
     }
+    mfrc522_drv_status status = ll_transfer(conf, xfers, num);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* Restore TX last bits config */
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_bit_framing, 0x00, MFRC522_REG_FIELD(BITFRAMING_TX_LASTBITS));
+    /* Response of a PICC has to come within frame waiting time measured from the end of transmission */
+    mfrc522_drv_tim_conf tim_conf = MFRC522_DRV_TIM_CONF_DEFAULT;
+    status = mfrc522_drv_tim_set(&tim_conf, MFRC522_DRV_FWT_ISO14443_3);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    tim_conf.periodic = false;
+    tim_conf.auto_start = true;
+    status = mfrc522_drv_tim_start(conf, &tim_conf);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* Verify ATQA */
-    status = verify_atqa(conf, &response[0], atqa);
+    /* Enter Transceive state with 7-bit frames. Transmission is started by each probe */
+    probe->frame = frame;
+    probe->command = (probe->command_prev & ~MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD)) | mfrc522_reg_cmd_transceive;
+    probe->bit_framing = (probe->bit_framing_prev & ~MFRC522_REG_FIELD_MSK_REAL(BITFRAMING_START) &
+                          ~MFRC522_REG_FIELD_MSK_REAL(BITFRAMING_RX_ALIGN) &
+                          ~MFRC522_REG_FIELD_MSK_REAL(BITFRAMING_TX_LASTBITS)) |
+                         (7 << MFRC522_REG_FIELD_POS(BITFRAMING_TX_LASTBITS));
+    const u8 fifo_flush = MFRC522_REG_FIELD_MSK_REAL(FIFOLEVEL_FLUSH);
+    num = 0;
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_fifo_level, 1, &fifo_flush, NULL};
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_bit_framing, 1, &probe->bit_framing, NULL};
+    xfers[num++] = (mfrc522_ll_xfer){mfrc522_reg_command, 1, &probe->command, NULL};
+    status = ll_transfer(conf, xfers, num);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
+    /* Poll limit is only a guard in case TimerIRq never comes */
+    probe->poll_limit = get_real_retry_count(MFRC522_DRV_DEF_RETRY_CNT +
+                                             (2000 * (u32)MFRC522_DRV_FWT_ISO14443_3) / TRANSCEIVE_TIM_POLL_DELAY);
+    probe->ready = true; /* A PICC may have been left in READY state by frames sent before */
+    probe->active = true;
+
     return mfrc522_drv_status_ok;
 }
 
 mfrc522_drv_status
-mfrc522_drv_anticollision(const mfrc522_drv_conf* conf, u8* serial)
+mfrc522_drv_probe(const mfrc522_drv_conf* conf, mfrc522_drv_probe_ctx* probe, bool* present, u16* atqa)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(serial, mfrc522_drv_status_nullptr);
-
-    mfrc522_drv_status status;
-
-    /* TX data consist of two bytes */
-    u8 tx[2];
-    tx[0] = mfrc522_picc_cmd_anticoll_cl1 & 0xFF;
-    tx[1] = (mfrc522_picc_cmd_anticoll_cl1 & 0xFF00) >> 8;
+    NOT_NULL(probe, mfrc522_drv_status_nullptr);
+    NOT_NULL(present, mfrc522_drv_status_nullptr);
+    NOT_NULL(atqa, mfrc522_drv_status_nullptr);
 
-    /* Transceive the data */
-    mfrc522_drv_transceive_conf tr_conf;
-    tr_conf.tx_data = &tx[0];
-    tr_conf.tx_data_sz = SIZE_ARRAY(tx);
-    tr_conf.rx_data = serial;
-    tr_conf.rx_data_sz = 5;
-    tr_conf.command = mfrc522_reg_cmd_transceive;
-    status = mfrc522_drv_transceive(conf, &tr_conf);
+    *present = false;
+    *atqa = MFRC522_PICC_ATQA_INV;
+    if (UNLIKELY(!probe->active)) {
+        return mfrc522_drv_status_nok;
+    }
 
-    /* Compute checksum */
-    if (mfrc522_drv_status_ok == status) {
-        u8 checksum = 0;
-        for (size i = 0; i < 4; ++i) {
-            checksum ^= serial[i];
-        }
-        if (UNLIKELY(serial[4] != checksum)) {
-            return mfrc522_drv_status_anticoll_chksum_err;
-        }
+    mfrc522_drv_status status = probe_exchange(conf, probe, present, atqa);
+    if (mfrc522_drv_status_ok == status && !*present && probe->ready) {
+        /* A PICC in READY state goes back to IDLE silently, thus the same frame has to be sent once again */
+        status = probe_exchange(conf, probe, present, atqa);
     }
+    probe->ready = *present;
 
     return status;
 }
 
 mfrc522_drv_status
-mfrc522_drv_select(const mfrc522_drv_conf* conf, const u8* serial, u8* sak)
+mfrc522_drv_probe_deinit(const mfrc522_drv_conf* conf, mfrc522_drv_probe_ctx* probe)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(serial, mfrc522_drv_status_nullptr);
-    NOT_NULL(sak, mfrc522_drv_status_nullptr);
-
-    /* Build TX data */
-    u16 crc;
-    u8 tx[9];
-    tx[0] = mfrc522_picc_cmd_select_cl1 & 0xFF;
-    tx[1] = (mfrc522_picc_cmd_select_cl1 & 0xFF00) >> 8;
-    memcpy(&tx[2], serial, 5);
-    /* Compute and append CRC */
-    mfrc522_drv_status status = mfrc522_drv_fifo_store_mul(conf, &tx[0], 7);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    status = mfrc522_drv_crc_compute(conf, &crc);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    tx[7] = crc & 0xFF;
-    tx[8] = (crc & 0xFF00) >> 8;
-
-    /* Transceive the data */
-    u8 rx[3];
-    mfrc522_drv_transceive_conf tr_conf;
-    tr_conf.tx_data = &tx[0];
-    tr_conf.tx_data_sz = SIZE_ARRAY(tx);
-    tr_conf.rx_data = &rx[0];
-    tr_conf.rx_data_sz = SIZE_ARRAY(rx);
-    tr_conf.command = mfrc522_reg_cmd_transceive;
-    status = mfrc522_drv_transceive(conf, &tr_conf);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-
-    /* Calculate CRC of SAK response */
-    status = mfrc522_drv_fifo_store(conf, rx[0]);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    status = mfrc522_drv_crc_compute(conf, &crc);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-
-    u16 crc_from_picc = rx[1] | (rx[2] << 8);
-    if (UNLIKELY(crc_from_picc != crc)) {
-        return mfrc522_drv_status_crc_err;
+    NOT_NULL(probe, mfrc522_drv_status_nullptr);
+    if (UNLIKELY(!probe->active)) {
+        return mfrc522_drv_status_nok;
     }
-
-    *sak = rx[0];
-    return mfrc522_drv_status_ok;
+    probe->active = false;
+
+    /* Leave Transceive state and restore frame settings */
+    const u8 command = (probe->command_prev & ~MFRC522_REG_FIELD_MSK_REAL(COMMAND_CMD)) | mfrc522_reg_cmd_idle;
+    const u8 bit_framing = probe->bit_framing_prev & ~MFRC522_REG_FIELD_MSK_REAL(BITFRAMING_START);
+    const mfrc522_ll_xfer xfers[] = {
+        {mfrc522_reg_command, 1, &command, NULL},
+        {mfrc522_reg_bit_framing, 1, &bit_framing, NULL}
+    };
+    return ll_transfer(conf, xfers, SIZE_ARRAY(xfers));
 }
 
 mfrc522_drv_status
-mfrc522_drv_authenticate(const mfrc522_drv_conf* conf, const mfrc522_drv_auth_conf* auth_conf)
+mfrc522_drv_power_down(const mfrc522_drv_conf* conf, bool enable)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
-    NOT_NULL(auth_conf, mfrc522_drv_status_nullptr);
-
-    /* Build TX data */
-    u8 tx[12];
-    tx[0] = auth_conf->key_type;
-    tx[1] = mfrc522_picc_block_descriptor(auth_conf->sector, auth_conf->block);
-    memcpy(&tx[2], auth_conf->key, 6);
-    memcpy(&tx[8], auth_conf->serial, 4);
-
-    /* Transceive the data */
-    mfrc522_drv_transceive_conf tr_conf;
-    tr_conf.tx_data = &tx[0];
-    tr_conf.tx_data_sz = SIZE_ARRAY(tx);
-    tr_conf.rx_data = NULL;
-    tr_conf.rx_data_sz = 0; /* No data is expected on RX side */
-    tr_conf.command = mfrc522_reg_cmd_authent;
-    mfrc522_drv_status status = mfrc522_drv_transceive(conf, &tr_conf);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    /* Check if crypto is enabled */
-    u8 crypto;
-    status = mfrc522_drv_read_masked(conf, mfrc522_reg_status2, &crypto, MFRC522_REG_FIELD(STATUS2_CRYPTO_ON));
+    u8 command;
+    mfrc522_drv_status status = mfrc522_drv_read(conf, mfrc522_reg_command, &command);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    return (!crypto) ? mfrc522_drv_status_crypto_err : mfrc522_drv_status_ok;
+    return power_down_set(conf, command, enable);
 }
 
 mfrc522_drv_status
-mfrc522_drv_halt(const mfrc522_drv_conf* conf)
+mfrc522_drv_lpcd(const mfrc522_drv_conf* conf, const mfrc522_drv_lpcd_conf* lpcd_conf, u16* atqa)
 {
     NOT_NULL(conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(lpcd_conf, mfrc522_drv_status_nullptr);
+    NOT_NULL(atqa, mfrc522_drv_status_nullptr);
 
-    /* TX data */
-    u8 tx[4];
-    tx[0] = mfrc522_picc_cmd_halt & 0xFF;
-    tx[1] = (mfrc522_picc_cmd_halt & 0xFF00) >> 8;
-    mfrc522_drv_status status = mfrc522_drv_fifo_store_mul(conf, &tx[0], 2);
-    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    u16 crc;
-    status = mfrc522_drv_crc_compute(conf, &crc);
+#if MFRC522_LL_DELAY
+    /* Registers are retained in soft power-down, thus the probe is configured only once */
+    mfrc522_drv_probe_ctx probe;
+    mfrc522_drv_status status = mfrc522_drv_probe_init(conf, &probe, lpcd_conf->frame);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
-    tx[2] = crc & 0xFF;
-    tx[3] = (crc & 0xFF00) >> 8;
 
-    /* Transceive the data */
-    mfrc522_drv_transceive_conf tr_conf;
-    tr_conf.tx_data = &tx[0];
-    tr_conf.tx_data_sz = SIZE_ARRAY(tx);
-    tr_conf.rx_data = NULL;
-    tr_conf.rx_data_sz = 0;
-    tr_conf.command = mfrc522_reg_cmd_transceive;
-    status = mfrc522_drv_transceive(conf, &tr_conf);
-    /* This is intentional! Halt command succeeded when timeout occurs during reception of the data */
-    if (UNLIKELY(mfrc522_drv_status_ok == status)) {
-        return mfrc522_drv_status_halt_err;
-    } else if (mfrc522_drv_status_transceive_timeout != status) {
-        return status; /* Just forward the error */
+    u32 cycle = 0;
+    for (;;) {
+        bool present;
+        status = mfrc522_drv_probe(conf, &probe, &present, atqa);
+        if (present || mfrc522_drv_status_ok != status) {
+            /* Hand the PICC over with the device powered up */
+            mfrc522_drv_status deinit_status = mfrc522_drv_probe_deinit(conf, &probe);
+            ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+            return deinit_status;
+        }
+        if (lpcd_conf->max_cycles && ++cycle >= lpcd_conf->max_cycles) {
+            break;
+        }
+
+        /* Sleep, then give PICCs some time to power up in RF field */
+        status = power_down_set(conf, probe.command_prev, true);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        delay(conf, lpcd_conf->sleep_period);
+        status = power_down_set(conf, probe.command_prev, false);
+        ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+        delay(conf, lpcd_conf->settle_time);
     }
 
-    /* Turn off the crypto unit */
-    status = mfrc522_drv_write_masked(conf, mfrc522_reg_status2, 0, MFRC522_REG_FIELD(STATUS2_CRYPTO_ON));
+    /* Nothing found. Leave the device in power-down */
+    status = mfrc522_drv_probe_deinit(conf, &probe);
+    ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
+    status = power_down_set(conf, probe.command_prev, true);
     ERROR_IF_NEQ(status, mfrc522_drv_status_ok);
 
-    return mfrc522_drv_status_ok;
+    return mfrc522_drv_status_transceive_timeout;
+#else
+    /* Sleep cannot be done without delay function */
+    return mfrc522_drv_status_nok;
+#endif
 }
@@ -0,0 +1,175 @@
+/*
+ * Pollable event sources for Linux hosts. IRQ pin of a device is watched through GPIO character device (uAPI v2),
+ * which reports edges on a file descriptor. Devices without IRQ line get a periodic timerfd instead. Either way
+ * a single epoll loop can service many devices driven by non-blocking driver operations.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/timerfd.h>
+#include <linux/gpio.h>
+#include "mfrc522_ll_event.h"
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Private macros --------------------- */
+/* ------------------------------------------------------------ */
+
+/* Number of GPIO events consumed by a single read */
+#define EVENT_READ_NUM 4
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+static int
+sys_ioctl(int fd, unsigned long req, void* arg)
+{
+    return ioctl(fd, req, arg);
+}
+
+/* Request GPIO line with edge detection. Returns file descriptor of the line or negative value on failure */
+static int
+event_line_open(const mfrc522_ll_event_conf* conf)
+{
+    int chip = open(conf->chip_path, O_RDWR | O_CLOEXEC);
+    if (UNLIKELY(chip < 0)) {
+        return -1;
+    }
+
+    /* Edges are reported on transitions to active level, thus polarity is handled by the kernel */
+    struct gpio_v2_line_request req;
+    memset(&req, 0, sizeof(req));
+    req.offsets[0] = conf->line;
+    req.num_lines = 1;
+    strncpy(req.consumer, MFRC522_LL_EVENT_CONSUMER, sizeof(req.consumer) - 1);
+    req.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING;
+    if (conf->active_low) {
+        req.config.flags |= GPIO_V2_LINE_FLAG_ACTIVE_LOW;
+    }
+    mfrc522_ll_event_ioctl ioctl_fn = (NULL != conf->ioctl_fn) ? conf->ioctl_fn : sys_ioctl;
+    int status = ioctl_fn(chip, GPIO_V2_GET_LINE_IOCTL, &req);
+    close(chip);
+    if (UNLIKELY(status < 0 || req.fd < 0)) {
+        return -1;
+    }
+
+    /* Acknowledging events must never block */
+    if (UNLIKELY(fcntl(req.fd, F_SETFL, fcntl(req.fd, F_GETFL) | O_NONBLOCK) < 0)) {
+        close(req.fd);
+        return -1;
+    }
+    return req.fd;
+}
+
+/* Create periodic timer. Returns file descriptor of the timer or negative value on failure */
+static int
+event_timer_open(const mfrc522_ll_event_conf* conf)
+{
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (UNLIKELY(fd < 0)) {
+        return -1;
+    }
+
+    u32 period = conf->poll_period ? conf->poll_period : MFRC522_LL_EVENT_DEF_POLL_PERIOD;
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = period / 1000000;
+    spec.it_interval.tv_nsec = (long)(period % 1000000) * 1000;
+    spec.it_value = spec.it_interval;
+    if (UNLIKELY(timerfd_settime(fd, 0, &spec, NULL) < 0)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+mfrc522_ll_status
+mfrc522_ll_event_open(mfrc522_ll_event* ev, const mfrc522_ll_event_conf* conf)
+{
+    ERROR_IF_EQ(ev, NULL, mfrc522_ll_status_init_err);
+    ERROR_IF_EQ(conf, NULL, mfrc522_ll_status_init_err);
+
+    ev->fd = -1;
+    ev->irq = false;
+    if (NULL != conf->chip_path) {
+        ev->fd = event_line_open(conf);
+        ev->irq = (ev->fd >= 0);
+    }
+
+    /* Fall back to polling if IRQ line is not available */
+    if (!ev->irq) {
+        ev->fd = event_timer_open(conf);
+    }
+    return (ev->fd >= 0) ? mfrc522_ll_status_ok : mfrc522_ll_status_init_err;
+}
+
+int
+mfrc522_ll_event_fd(const mfrc522_ll_event* ev)
+{
+    return (NULL != ev) ? ev->fd : -1;
+}
+
+mfrc522_ll_status
+mfrc522_ll_event_ack(mfrc522_ll_event* ev)
+{
+    ERROR_IF_EQ(ev, NULL, mfrc522_ll_status_recv_err);
+    if (UNLIKELY(ev->fd < 0)) {
+        return mfrc522_ll_status_recv_err;
+    }
+
+    /* Buffer is large enough for expiration counter of the timer as well */
+    struct gpio_v2_line_event events[EVENT_READ_NUM];
+    bool acked = false;
+    for (;;) {
+        ssize_t num = read(ev->fd, events, sizeof(events));
+        if (num > 0) {
+            acked = true;
+        } else if (num < 0 && EINTR == errno) {
+            continue;
+        } else if (num < 0 && EAGAIN != errno && EWOULDBLOCK != errno) {
+            return mfrc522_ll_status_recv_err;
+        } else {
+            break; /* Nothing more to read */
+        }
+    }
+    return acked ? mfrc522_ll_status_ok : mfrc522_ll_status_timeout;
+}
+
+mfrc522_ll_status
+mfrc522_ll_event_wait(mfrc522_ll_event* ev, u32 timeout)
+{
+    ERROR_IF_EQ(ev, NULL, mfrc522_ll_status_recv_err);
+    if (UNLIKELY(ev->fd < 0)) {
+        return mfrc522_ll_status_recv_err;
+    }
+
+    struct pollfd pfd = {ev->fd, POLLIN, 0};
+    int ready;
+    do {
+        ready = poll(&pfd, 1, (int)((timeout + 999) / 1000));
+    } while (ready < 0 && EINTR == errno);
+
+    if (UNLIKELY(ready < 0)) {
+        return mfrc522_ll_status_recv_err;
+    }
+    return ready ? mfrc522_ll_event_ack(ev) : mfrc522_ll_status_timeout;
+}
+
+void
+mfrc522_ll_event_close(mfrc522_ll_event* ev)
+{
+    if (NULL != ev && ev->fd >= 0) {
+        close(ev->fd);
+        ev->fd = -1;
+        ev->irq = false;
+    }
+}
@@ -0,0 +1,192 @@
+/*
+ * Low-level backend for Linux i2c-dev devices (/dev/i2c-N).
+ *
+ * Each transfer is framed as described in MFRC522 documentation (section 8.1.3): a write is a single message with the
+ * register address followed by payload bytes, whereas a read is a register address write followed by a data read.
+ * Register address is not incremented by a device, thus multiple-byte reads drain the same register (e.g. FIFO).
+ * Batches of transfers are packed into a single I2C_RDWR call.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include "mfrc522_ll_posix.h"
+#include "mfrc522_ll_i2cdev.h"
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Private macros --------------------- */
+/* ------------------------------------------------------------ */
+
+/* Mask for register address sent over I2C */
+#define ADDR_MASK 0x3F
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+static int
+sys_ioctl(int fd, unsigned long req, void* arg)
+{
+    return ioctl(fd, req, arg);
+}
+
+/* Issue one I2C_RDWR call */
+static mfrc522_ll_status
+i2cdev_message(const mfrc522_ll_i2cdev* dev, struct i2c_msg* msgs, size num, bool recv)
+{
+    struct i2c_rdwr_ioctl_data data;
+    data.msgs = msgs;
+    data.nmsgs = (u32)num;
+    if (UNLIKELY(dev->conf.ioctl_fn(dev->fd, I2C_RDWR, &data) < 0)) {
+        return recv ? mfrc522_ll_status_recv_err : mfrc522_ll_status_send_err;
+    }
+    return mfrc522_ll_status_ok;
+}
+
+static mfrc522_ll_status
+i2cdev_transfer_multi(void* ctx, const mfrc522_ll_xfer* xfers, size num)
+{
+    const mfrc522_ll_i2cdev* dev = ctx;
+    struct i2c_msg msgs[MFRC522_LL_I2CDEV_MSG_MAX];
+    u8 tx[MFRC522_LL_I2CDEV_BUF_SZ];
+    mfrc522_ll_status status;
+    size pending = 0;
+    size used = 0;
+    bool recv = false;
+
+    for (size i = 0; i < num; ++i) {
+        const mfrc522_ll_xfer* xfer = &xfers[i];
+        size msg_num = (NULL != xfer->rx) ? 2 : 1;
+        size len = (NULL != xfer->rx) ? 1 : (xfer->bytes + 1);
+        if (UNLIKELY((len > MFRC522_LL_I2CDEV_BUF_SZ) || (xfer->bytes > 0xFFFF))) {
+            return (NULL != xfer->rx) ? mfrc522_ll_status_recv_err : mfrc522_ll_status_send_err;
+        }
+
+        /* Send pending messages if there is no room for the current transfer */
+        if ((pending + msg_num > MFRC522_LL_I2CDEV_MSG_MAX) || (used + len > MFRC522_LL_I2CDEV_BUF_SZ)) {
+            status = i2cdev_message(dev, msgs, pending, recv);
+            ERROR_IF_NEQ(status, mfrc522_ll_status_ok);
+            pending = 0;
+            used = 0;
+            recv = false;
+        }
+
+        u8* tx_buf = &tx[used];
+        tx_buf[0] = xfer->addr & ADDR_MASK;
+        msgs[pending].addr = dev->conf.addr;
+        msgs[pending].flags = 0;
+        msgs[pending].buf = tx_buf;
+        if (NULL != xfer->tx) {
+            memcpy(&tx_buf[1], xfer->tx, xfer->bytes);
+            msgs[pending].len = (u16)len;
+        } else {
+            msgs[pending].len = 1;
+            ++pending;
+            msgs[pending].addr = dev->conf.addr;
+            msgs[pending].flags = I2C_M_RD;
+            msgs[pending].len = (u16)xfer->bytes;
+            msgs[pending].buf = xfer->rx;
+            recv = true;
+        }
+        ++pending;
+        used += len;
+    }
+
+    if (!pending) {
+        return mfrc522_ll_status_ok;
+    }
+    return i2cdev_message(dev, msgs, pending, recv);
+}
+
+static mfrc522_ll_status
+i2cdev_init(void* ctx)
+{
+    mfrc522_ll_i2cdev* dev = ctx;
+    ERROR_IF_EQ(dev, NULL, mfrc522_ll_status_init_err);
+    mfrc522_ll_i2cdev_close(dev);
+
+    dev->fd = open(dev->conf.path, O_RDWR);
+    if (UNLIKELY(dev->fd < 0)) {
+        return mfrc522_ll_status_init_err;
+    }
+
+    /* Combined transactions require plain I2C support from an adapter */
+    unsigned long funcs = 0;
+    if (UNLIKELY((dev->conf.ioctl_fn(dev->fd, I2C_FUNCS, &funcs) < 0) || !(funcs & I2C_FUNC_I2C))) {
+        mfrc522_ll_i2cdev_close(dev);
+        return mfrc522_ll_status_init_err;
+    }
+
+    return mfrc522_ll_status_ok;
+}
+
+static mfrc522_ll_status
+i2cdev_send(void* ctx, u8 addr, size bytes, const u8* payload)
+{
+    mfrc522_ll_xfer xfer = {addr, bytes, payload, NULL};
+    return i2cdev_transfer_multi(ctx, &xfer, 1);
+}
+
+static mfrc522_ll_status
+i2cdev_recv_mul(void* ctx, u8 addr, size bytes, u8* payload)
+{
+    mfrc522_ll_xfer xfer = {addr, bytes, NULL, payload};
+    return i2cdev_transfer_multi(ctx, &xfer, 1);
+}
+
+static mfrc522_ll_status
+i2cdev_recv(void* ctx, u8 addr, u8* payload)
+{
+    return i2cdev_recv_mul(ctx, addr, 1, payload);
+}
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public variables ------------------- */
+/* ------------------------------------------------------------ */
+
+const mfrc522_ll_ops mfrc522_ll_i2cdev_ops = {
+    .version = MFRC522_LL_OPS_VERSION,
+    .init = i2cdev_init,
+    .send = i2cdev_send,
+    .recv = i2cdev_recv,
+    .recv_mul = i2cdev_recv_mul,
+    .delay = mfrc522_ll_posix_delay,
+    .transfer_multi = i2cdev_transfer_multi,
+    .now = mfrc522_ll_posix_now
+};
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+mfrc522_ll_status
+mfrc522_ll_i2cdev_setup(mfrc522_ll_i2cdev* dev, const mfrc522_ll_i2cdev_conf* conf)
+{
+    ERROR_IF_EQ(dev, NULL, mfrc522_ll_status_init_err);
+    ERROR_IF_EQ(conf, NULL, mfrc522_ll_status_init_err);
+    ERROR_IF_EQ(conf->path, NULL, mfrc522_ll_status_init_err);
+
+    dev->fd = -1;
+    dev->conf = *conf;
+    if (NULL == dev->conf.ioctl_fn) {
+        dev->conf.ioctl_fn = sys_ioctl;
+    }
+    if (!dev->conf.addr) {
+        dev->conf.addr = MFRC522_LL_I2CDEV_DEF_ADDR;
+    }
+    return mfrc522_ll_status_ok;
+}
+
+void
+mfrc522_ll_i2cdev_close(mfrc522_ll_i2cdev* dev)
+{
+    if (NULL != dev && dev->fd >= 0) {
+        close(dev->fd);
+        dev->fd = -1;
+    }
+}
@@ -0,0 +1,31 @@
+/*
+ * Time functions shared by Linux backends. They do not touch a device, thus any low-level context is accepted.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+#include "mfrc522_ll_posix.h"
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+void
+mfrc522_ll_posix_delay(void* ctx, u32 period)
+{
+    (void)ctx;
+    struct timespec ts;
+    ts.tv_sec = period / 1000000;
+    ts.tv_nsec = (long)(period % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+}
+
+u32
+mfrc522_ll_posix_now(void* ctx)
+{
+    (void)ctx;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u32)ts.tv_sec * 1000000U + (u32)(ts.tv_nsec / 1000);
+}
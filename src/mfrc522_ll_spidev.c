@@ -0,0 +1,210 @@
+/*
+ * Low-level backend for Linux spidev devices (/dev/spidevX.Y).
+ *
+ * Each transfer is framed as described in MFRC522 documentation (section 8.1.2): the address byte is followed by
+ * payload bytes when writing, or the address byte is repeated for each byte to be read. Batches of transfers are
+ * packed into a single SPI_IOC_MESSAGE call with chip-select toggled between transfers.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+#include "mfrc522_ll_posix.h"
+#include "mfrc522_ll_spidev.h"
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Private macros --------------------- */
+/* ------------------------------------------------------------ */
+
+/* Read flag in SPI address byte */
+#define ADDR_READ 0x80
+
+/* Mask for register address in SPI address byte */
+#define ADDR_MASK 0x7E
+
+/* Encode register address as SPI address byte */
+#define ADDR_ENCODE(ADDR, READ) ((u8)((((ADDR) << 1) & ADDR_MASK) | ((READ) ? ADDR_READ : 0x00)))
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+static int
+sys_ioctl(int fd, unsigned long req, void* arg)
+{
+    return ioctl(fd, req, arg);
+}
+
+/* Issue one SPI_IOC_MESSAGE call and copy received bytes to transfers the messages were built from */
+static mfrc522_ll_status
+spidev_message(const mfrc522_ll_spidev* dev, struct spi_ioc_transfer* msgs, const mfrc522_ll_xfer* xfers, size num)
+{
+    bool recv = false;
+    for (size i = 0; i < num; ++i) {
+        recv |= (NULL != xfers[i].rx);
+    }
+
+    /* Chip-select shall be released after the last transfer */
+    msgs[num - 1].cs_change = 0;
+    if (UNLIKELY(dev->conf.ioctl_fn(dev->fd, SPI_IOC_MESSAGE(num), msgs) < 0)) {
+        return recv ? mfrc522_ll_status_recv_err : mfrc522_ll_status_send_err;
+    }
+
+    /* The first byte is received while address byte is being sent, thus it is always skipped */
+    for (size i = 0; i < num; ++i) {
+        if (NULL != xfers[i].rx) {
+            memcpy(xfers[i].rx, (const u8*)(uintptr_t)msgs[i].rx_buf + 1, xfers[i].bytes);
+        }
+    }
+    return mfrc522_ll_status_ok;
+}
+
+static mfrc522_ll_status
+spidev_transfer_multi(void* ctx, const mfrc522_ll_xfer* xfers, size num)
+{
+    const mfrc522_ll_spidev* dev = ctx;
+    struct spi_ioc_transfer msgs[MFRC522_LL_SPIDEV_XFER_MAX];
+    u8 tx[MFRC522_LL_SPIDEV_BUF_SZ];
+    u8 rx[MFRC522_LL_SPIDEV_BUF_SZ];
+    mfrc522_ll_status status;
+    size first = 0;
+    size used = 0;
+
+    for (size i = 0; i < num; ++i) {
+        const mfrc522_ll_xfer* xfer = &xfers[i];
+        size len = xfer->bytes + 1;
+        if (UNLIKELY(len > MFRC522_LL_SPIDEV_BUF_SZ)) {
+            return (NULL != xfer->rx) ? mfrc522_ll_status_recv_err : mfrc522_ll_status_send_err;
+        }
+
+        /* Send pending transfers if there is no room for the current one */
+        size pending = i - first;
+        if ((MFRC522_LL_SPIDEV_XFER_MAX == pending) || (used + len > MFRC522_LL_SPIDEV_BUF_SZ)) {
+            status = spidev_message(dev, msgs, &xfers[first], pending);
+            ERROR_IF_NEQ(status, mfrc522_ll_status_ok);
+            first = i;
+            used = 0;
+            pending = 0;
+        }
+
+        u8* tx_buf = &tx[used];
+        if (NULL != xfer->tx) {
+            tx_buf[0] = ADDR_ENCODE(xfer->addr, false);
+            memcpy(&tx_buf[1], xfer->tx, xfer->bytes);
+        } else {
+            memset(tx_buf, ADDR_ENCODE(xfer->addr, true), xfer->bytes);
+            tx_buf[xfer->bytes] = 0x00;
+        }
+
+        struct spi_ioc_transfer* msg = &msgs[pending];
+        memset(msg, 0, sizeof(*msg));
+        msg->tx_buf = (uintptr_t)tx_buf;
+        msg->rx_buf = (uintptr_t)&rx[used];
+        msg->len = (u32)len;
+        msg->speed_hz = dev->conf.speed;
+        msg->bits_per_word = 8;
+        msg->cs_change = 1;
+        used += len;
+    }
+
+    if (first == num) {
+        return mfrc522_ll_status_ok;
+    }
+    return spidev_message(dev, msgs, &xfers[first], num - first);
+}
+
+static mfrc522_ll_status
+spidev_init(void* ctx)
+{
+    mfrc522_ll_spidev* dev = ctx;
+    ERROR_IF_EQ(dev, NULL, mfrc522_ll_status_init_err);
+    mfrc522_ll_spidev_close(dev);
+
+    dev->fd = open(dev->conf.path, O_RDWR);
+    if (UNLIKELY(dev->fd < 0)) {
+        return mfrc522_ll_status_init_err;
+    }
+
+    u8 mode = SPI_MODE_0;
+    u8 bits = 8;
+    u32 speed = dev->conf.speed;
+    if (UNLIKELY((dev->conf.ioctl_fn(dev->fd, SPI_IOC_WR_MODE, &mode) < 0) ||
+                 (dev->conf.ioctl_fn(dev->fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0) ||
+                 (dev->conf.ioctl_fn(dev->fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed) < 0))) {
+        mfrc522_ll_spidev_close(dev);
+        return mfrc522_ll_status_init_err;
+    }
+
+    return mfrc522_ll_status_ok;
+}
+
+static mfrc522_ll_status
+spidev_send(void* ctx, u8 addr, size bytes, const u8* payload)
+{
+    mfrc522_ll_xfer xfer = {addr, bytes, payload, NULL};
+    return spidev_transfer_multi(ctx, &xfer, 1);
+}
+
+static mfrc522_ll_status
+spidev_recv_mul(void* ctx, u8 addr, size bytes, u8* payload)
+{
+    mfrc522_ll_xfer xfer = {addr, bytes, NULL, payload};
+    return spidev_transfer_multi(ctx, &xfer, 1);
+}
+
+static mfrc522_ll_status
+spidev_recv(void* ctx, u8 addr, u8* payload)
+{
+    return spidev_recv_mul(ctx, addr, 1, payload);
+}
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public variables ------------------- */
+/* ------------------------------------------------------------ */
+
+const mfrc522_ll_ops mfrc522_ll_spidev_ops = {
+    .version = MFRC522_LL_OPS_VERSION,
+    .init = spidev_init,
+    .send = spidev_send,
+    .recv = spidev_recv,
+    .recv_mul = spidev_recv_mul,
+    .delay = mfrc522_ll_posix_delay,
+    .transfer_multi = spidev_transfer_multi,
+    .now = mfrc522_ll_posix_now
+};
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+mfrc522_ll_status
+mfrc522_ll_spidev_setup(mfrc522_ll_spidev* dev, const mfrc522_ll_spidev_conf* conf)
+{
+    ERROR_IF_EQ(dev, NULL, mfrc522_ll_status_init_err);
+    ERROR_IF_EQ(conf, NULL, mfrc522_ll_status_init_err);
+    ERROR_IF_EQ(conf->path, NULL, mfrc522_ll_status_init_err);
+
+    dev->fd = -1;
+    dev->conf = *conf;
+    if (NULL == dev->conf.ioctl_fn) {
+        dev->conf.ioctl_fn = sys_ioctl;
+    }
+    if (!dev->conf.speed) {
+        dev->conf.speed = MFRC522_LL_SPIDEV_DEF_SPEED;
+    }
+    return mfrc522_ll_status_ok;
+}
+
+void
+mfrc522_ll_spidev_close(mfrc522_ll_spidev* dev)
+{
+    if (NULL != dev && dev->fd >= 0) {
+        close(dev->fd);
+        dev->fd = -1;
+    }
+}
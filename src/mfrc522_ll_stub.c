@@ -11,14 +11,16 @@
 #include "mfrc522_ll.h"
 
 mfrc522_ll_status
-mfrc522_ll_init(void)
+mfrc522_ll_init(void* ctx)
 {
+    (void)ctx;
     return mfrc522_ll_status_ok;
 }
 
 mfrc522_ll_status
-mfrc522_ll_send(u8 addr, size bytes, const u8* payload)
+mfrc522_ll_send(void* ctx, u8 addr, size bytes, const u8* payload)
 {
+    (void)ctx;
     (void)addr;
     (void)bytes;
     (void)payload;
@@ -26,15 +28,76 @@ mfrc522_ll_send(u8 addr, size bytes, const u8* payload)
 }
 
 mfrc522_ll_status
-mfrc522_ll_recv(u8 addr, u8* payload)
+mfrc522_ll_recv(void* ctx, u8 addr, u8* payload)
 {
+    (void)ctx;
     (void)addr;
     *payload = 0x00;
     return mfrc522_ll_status_ok;
 }
 
+mfrc522_ll_status
+mfrc522_ll_recv_mul(void* ctx, u8 addr, size bytes, u8* payload)
+{
+    (void)ctx;
+    (void)addr;
+    for (size i = 0; i < bytes; ++i) {
+        payload[i] = 0x00;
+    }
+    return mfrc522_ll_status_ok;
+}
+
+#if MFRC522_LL_BATCH
+mfrc522_ll_status
+mfrc522_ll_transfer_multi(void* ctx, const mfrc522_ll_xfer* xfers, size num)
+{
+    (void)ctx;
+    for (size i = 0; i < num; ++i) {
+        for (size j = 0; (NULL != xfers[i].rx) && (j < xfers[i].bytes); ++j) {
+            xfers[i].rx[j] = 0x00;
+        }
+    }
+    return mfrc522_ll_status_ok;
+}
+#endif
+
+#if MFRC522_LL_ASYNC
+mfrc522_ll_status
+mfrc522_ll_submit(void* ctx, const mfrc522_ll_xfer* xfers, size num, mfrc522_ll_complete complete, void* arg)
+{
+    (void)ctx;
+    for (size i = 0; i < num; ++i) {
+        for (size j = 0; (NULL != xfers[i].rx) && (j < xfers[i].bytes); ++j) {
+            xfers[i].rx[j] = 0x00;
+        }
+    }
+    complete(arg, mfrc522_ll_status_ok);
+    return mfrc522_ll_status_ok;
+}
+#endif
+
 void
-mfrc522_ll_delay(u32 period)
+mfrc522_ll_delay(void* ctx, u32 period)
 {
+    (void)ctx;
     (void)period;
 }
+
+#if MFRC522_LL_IRQ
+mfrc522_ll_status
+mfrc522_ll_wait_irq(void* ctx, u32 timeout)
+{
+    (void)ctx;
+    (void)timeout;
+    return mfrc522_ll_status_ok;
+}
+#endif
+
+#if MFRC522_LL_CLOCK
+u32
+mfrc522_ll_now(void* ctx)
+{
+    (void)ctx;
+    return 0;
+}
+#endif
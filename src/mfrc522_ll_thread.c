@@ -0,0 +1,234 @@
+/*
+ * Reference implementation of asynchronous low-level transfers. Requests are queued and performed by a worker thread
+ * using wrapped synchronous operations. It allows to exercise asynchronous driver API on Linux hosts, whereas MCU-based
+ * targets are expected to implement 'submit' operation on top of DMA.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mfrc522_ll_posix.h"
+#include "mfrc522_ll_thread.h"
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Private macros --------------------- */
+/* ------------------------------------------------------------ */
+
+/* Period of IRQ pin emulation if wrapped operations cannot wait for the pin */
+#define THREAD_IRQ_POLL_DELAY 100
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+/* Perform transfers using wrapped operations. Bus lock has to be taken */
+static mfrc522_ll_status
+thread_transfer_locked(const mfrc522_ll_thread* thr, const mfrc522_ll_xfer* xfers, size num)
+{
+    const mfrc522_ll_ops* ops = thr->ops;
+    if (NULL != ops->transfer_multi) {
+        return ops->transfer_multi(thr->ctx, xfers, num);
+    }
+
+    mfrc522_ll_status status = mfrc522_ll_status_ok;
+    for (size i = 0; (i < num) && (mfrc522_ll_status_ok == status); ++i) {
+        const mfrc522_ll_xfer* xfer = &xfers[i];
+        if (NULL != xfer->tx) {
+            status = ops->send(thr->ctx, xfer->addr, xfer->bytes, xfer->tx);
+        } else if (1 == xfer->bytes) {
+            status = ops->recv(thr->ctx, xfer->addr, xfer->rx);
+        } else {
+            status = ops->recv_mul(thr->ctx, xfer->addr, xfer->bytes, xfer->rx);
+        }
+    }
+    return status;
+}
+
+static void*
+thread_loop(void* arg)
+{
+    mfrc522_ll_thread* thr = arg;
+
+    for (;;) {
+        pthread_mutex_lock(&thr->queue_lock);
+        while (!thr->queue_num && !thr->stopping) {
+            pthread_cond_wait(&thr->queue_cond, &thr->queue_lock);
+        }
+        if (!thr->queue_num) {
+            pthread_mutex_unlock(&thr->queue_lock);
+            break;
+        }
+        mfrc522_ll_thread_req req = thr->queue[thr->queue_head];
+        thr->queue_head = (thr->queue_head + 1) % MFRC522_LL_THREAD_QUEUE_SZ;
+        --thr->queue_num;
+        pthread_mutex_unlock(&thr->queue_lock);
+
+        pthread_mutex_lock(&thr->bus_lock);
+        mfrc522_ll_status status = thread_transfer_locked(thr, req.xfers, req.num);
+        pthread_mutex_unlock(&thr->bus_lock);
+        req.complete(req.arg, status);
+    }
+    return NULL;
+}
+
+static mfrc522_ll_status
+thread_init(void* ctx)
+{
+    mfrc522_ll_thread* thr = ctx;
+    ERROR_IF_EQ(thr, NULL, mfrc522_ll_status_init_err);
+    ERROR_IF_EQ(thr->ops, NULL, mfrc522_ll_status_init_err);
+
+    pthread_mutex_lock(&thr->bus_lock);
+    mfrc522_ll_status status = thr->ops->init(thr->ctx);
+    pthread_mutex_unlock(&thr->bus_lock);
+    return status;
+}
+
+static mfrc522_ll_status
+thread_transfer_multi(void* ctx, const mfrc522_ll_xfer* xfers, size num)
+{
+    mfrc522_ll_thread* thr = ctx;
+    pthread_mutex_lock(&thr->bus_lock);
+    mfrc522_ll_status status = thread_transfer_locked(thr, xfers, num);
+    pthread_mutex_unlock(&thr->bus_lock);
+    return status;
+}
+
+static mfrc522_ll_status
+thread_send(void* ctx, u8 addr, size bytes, const u8* payload)
+{
+    mfrc522_ll_xfer xfer = {addr, bytes, payload, NULL};
+    return thread_transfer_multi(ctx, &xfer, 1);
+}
+
+static mfrc522_ll_status
+thread_recv_mul(void* ctx, u8 addr, size bytes, u8* payload)
+{
+    mfrc522_ll_xfer xfer = {addr, bytes, NULL, payload};
+    return thread_transfer_multi(ctx, &xfer, 1);
+}
+
+static mfrc522_ll_status
+thread_recv(void* ctx, u8 addr, u8* payload)
+{
+    return thread_recv_mul(ctx, addr, 1, payload);
+}
+
+static void
+thread_delay(void* ctx, u32 period)
+{
+    const mfrc522_ll_thread* thr = ctx;
+    if (NULL != thr->ops->delay) {
+        thr->ops->delay(thr->ctx, period);
+    }
+}
+
+static mfrc522_ll_status
+thread_wait_irq(void* ctx, u32 timeout)
+{
+    /* Bus lock is not taken, so asynchronous requests can be performed while waiting */
+    const mfrc522_ll_thread* thr = ctx;
+    if (NULL != thr->ops->wait_irq) {
+        return thr->ops->wait_irq(thr->ctx, timeout);
+    }
+
+    /* Pin state is unknown. Report it active after a short delay, so the driver checks interrupt request registers */
+    thread_delay(ctx, (timeout < THREAD_IRQ_POLL_DELAY) ? timeout : THREAD_IRQ_POLL_DELAY);
+    return mfrc522_ll_status_ok;
+}
+
+static u32
+thread_now(void* ctx)
+{
+    const mfrc522_ll_thread* thr = ctx;
+    if (NULL != thr->ops->now) {
+        return thr->ops->now(thr->ctx);
+    }
+    return mfrc522_ll_posix_now(ctx); /* Fall back to the system clock */
+}
+
+static mfrc522_ll_status
+thread_submit(void* ctx, const mfrc522_ll_xfer* xfers, size num, mfrc522_ll_complete complete, void* arg)
+{
+    mfrc522_ll_thread* thr = ctx;
+    pthread_mutex_lock(&thr->queue_lock);
+    if (UNLIKELY(MFRC522_LL_THREAD_QUEUE_SZ == thr->queue_num)) {
+        pthread_mutex_unlock(&thr->queue_lock);
+        return mfrc522_ll_status_busy;
+    }
+
+    mfrc522_ll_thread_req* req = &thr->queue[(thr->queue_head + thr->queue_num) % MFRC522_LL_THREAD_QUEUE_SZ];
+    req->xfers = xfers;
+    req->num = num;
+    req->complete = complete;
+    req->arg = arg;
+    ++thr->queue_num;
+    pthread_cond_signal(&thr->queue_cond);
+    pthread_mutex_unlock(&thr->queue_lock);
+    return mfrc522_ll_status_ok;
+}
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public variables ------------------- */
+/* ------------------------------------------------------------ */
+
+const mfrc522_ll_ops mfrc522_ll_thread_ops = {
+    .version = MFRC522_LL_OPS_VERSION,
+    .init = thread_init,
+    .send = thread_send,
+    .recv = thread_recv,
+    .recv_mul = thread_recv_mul,
+    .delay = thread_delay,
+    .transfer_multi = thread_transfer_multi,
+    .submit = thread_submit,
+    .wait_irq = thread_wait_irq,
+    .now = thread_now
+};
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+mfrc522_ll_status
+mfrc522_ll_thread_start(mfrc522_ll_thread* thr, const mfrc522_ll_ops* ops, void* ctx)
+{
+    ERROR_IF_EQ(thr, NULL, mfrc522_ll_status_init_err);
+    ERROR_IF_EQ(ops, NULL, mfrc522_ll_status_init_err);
+    if (UNLIKELY(NULL != thr->ops)) {
+        return mfrc522_ll_status_init_err;
+    }
+
+    thr->ctx = ctx;
+    thr->stopping = false;
+    thr->queue_head = 0;
+    thr->queue_num = 0;
+    pthread_mutex_init(&thr->bus_lock, NULL);
+    pthread_mutex_init(&thr->queue_lock, NULL);
+    pthread_cond_init(&thr->queue_cond, NULL);
+    if (UNLIKELY(0 != pthread_create(&thr->worker, NULL, thread_loop, thr))) {
+        pthread_cond_destroy(&thr->queue_cond);
+        pthread_mutex_destroy(&thr->queue_lock);
+        pthread_mutex_destroy(&thr->bus_lock);
+        return mfrc522_ll_status_init_err;
+    }
+    thr->ops = ops;
+    return mfrc522_ll_status_ok;
+}
+
+void
+mfrc522_ll_thread_stop(mfrc522_ll_thread* thr)
+{
+    if (NULL == thr || NULL == thr->ops) {
+        return;
+    }
+
+    pthread_mutex_lock(&thr->queue_lock);
+    thr->stopping = true;
+    pthread_cond_signal(&thr->queue_cond);
+    pthread_mutex_unlock(&thr->queue_lock);
+
+    pthread_join(thr->worker, NULL);
+    pthread_cond_destroy(&thr->queue_cond);
+    pthread_mutex_destroy(&thr->queue_lock);
+    pthread_mutex_destroy(&thr->bus_lock);
+    thr->ops = NULL;
+}
@@ -0,0 +1,375 @@
+/*
+ * Low-level backend for serial devices using termios interface.
+ *
+ * Each byte is framed as described in MFRC522 documentation (section 8.1.4): a write consists of address and data
+ * bytes and is acknowledged by the device with address byte echo, whereas a read consists of address byte with
+ * the read flag set and is answered with data byte. Batches of transfers are sent in one write call and all the
+ * responses are collected afterwards.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "mfrc522_reg.h"
+#include "mfrc522_ll_posix.h"
+#include "mfrc522_ll_uart.h"
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Private macros --------------------- */
+/* ------------------------------------------------------------ */
+
+/* Read flag in UART address byte */
+#define ADDR_READ 0x80
+
+/* Mask for register address in UART address byte */
+#define ADDR_MASK 0x3F
+
+/* ------------------------------------------------------------ */
+/* ---------------------- Private data types ------------------ */
+/* ------------------------------------------------------------ */
+
+/* Baud rate supported by both a device and termios interface */
+typedef struct uart_rate_
+{
+    u32 baud; /* Baud rate */
+    speed_t speed; /* Termios speed constant */
+    u8 serial_speed; /* SerialSpeedReg value (BR_T0 and BR_T1 fields) */
+} uart_rate;
+
+/* ------------------------------------------------------------ */
+/* -------------------------- Private data -------------------- */
+/* ------------------------------------------------------------ */
+
+/* Rates sorted in descending order. The last one is used by a device after reset */
+static const uart_rate uart_rates[] = {
+    {921600, B921600, 0x1C},
+    {460800, B460800, 0x3A},
+    {230400, B230400, 0x5A},
+    {115200, B115200, 0x7A},
+    {57600, B57600, 0x9A},
+    {38400, B38400, 0xAB},
+    {19200, B19200, 0xCB},
+    {MFRC522_LL_UART_RESET_BAUD, B9600, 0xEB}
+};
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+/* Switch host side to given rate. Bytes received so far are discarded. Fails if the rate is not applied exactly */
+static bool
+uart_set_rate(const mfrc522_ll_uart* dev, const uart_rate* rate)
+{
+    struct termios tio;
+    if (UNLIKELY(tcgetattr(dev->fd, &tio) < 0)) {
+        return false;
+    }
+
+    /* Raw mode, 8 data bits, no parity, one stop bit */
+    tio.c_iflag &= ~(tcflag_t)(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF);
+    tio.c_oflag &= ~(tcflag_t)OPOST;
+    tio.c_lflag &= ~(tcflag_t)(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+    tio.c_cflag &= ~(tcflag_t)(CSIZE | PARENB | CSTOPB);
+    tio.c_cflag |= CS8 | CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    if (UNLIKELY((cfsetispeed(&tio, rate->speed) < 0) || (cfsetospeed(&tio, rate->speed) < 0))) {
+        return false;
+    }
+
+    /* Some drivers accept the request, but silently keep a rate the hardware cannot generate */
+    if (UNLIKELY((dev->conf.tcsetattr_fn(dev->fd, TCSADRAIN, &tio) < 0) || (tcgetattr(dev->fd, &tio) < 0) ||
+                 (cfgetispeed(&tio) != rate->speed) || (cfgetospeed(&tio) != rate->speed))) {
+        return false;
+    }
+    tcflush(dev->fd, TCIFLUSH);
+    return true;
+}
+
+static bool
+uart_write_all(const mfrc522_ll_uart* dev, const u8* buf, size len)
+{
+    while (len) {
+        ssize_t res = write(dev->fd, buf, len);
+        if (res < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return false;
+        }
+        buf += res;
+        len -= (size)res;
+    }
+    return true;
+}
+
+static bool
+uart_read_all(const mfrc522_ll_uart* dev, u8* buf, size len)
+{
+    while (len) {
+        struct pollfd pfd;
+        pfd.fd = dev->fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int res = poll(&pfd, 1, (int)dev->conf.timeout);
+        if (res < 0 && EINTR == errno) {
+            continue;
+        }
+        if (res <= 0) {
+            return false;
+        }
+
+        ssize_t bytes = read(dev->fd, buf, len);
+        if (bytes < 0 && EINTR == errno) {
+            continue;
+        }
+        if (bytes <= 0) {
+            return false;
+        }
+        buf += bytes;
+        len -= (size)bytes;
+    }
+    return true;
+}
+
+/*
+ * Send pending bytes and collect responses. Each response byte is either stored in 'dst' buffer or, if 'dst' is NULL,
+ * compared with expected address byte echo.
+ */
+static mfrc522_ll_status
+uart_exchange(const mfrc522_ll_uart* dev, const u8* tx, size tx_len, u8* const* dst, const u8* echo, size rx_len,
+              bool recv)
+{
+    u8 rx[MFRC522_LL_UART_BUF_SZ];
+
+    if (UNLIKELY(!uart_write_all(dev, tx, tx_len))) {
+        return mfrc522_ll_status_send_err;
+    }
+    if (UNLIKELY(!uart_read_all(dev, rx, rx_len))) {
+        return recv ? mfrc522_ll_status_recv_err : mfrc522_ll_status_send_err;
+    }
+
+    for (size i = 0; i < rx_len; ++i) {
+        if (NULL != dst[i]) {
+            *dst[i] = rx[i];
+        } else if (UNLIKELY(echo[i] != rx[i])) {
+            return mfrc522_ll_status_send_err;
+        }
+    }
+    return mfrc522_ll_status_ok;
+}
+
+static mfrc522_ll_status
+uart_transfer_multi(void* ctx, const mfrc522_ll_xfer* xfers, size num)
+{
+    const mfrc522_ll_uart* dev = ctx;
+    u8 tx[MFRC522_LL_UART_BUF_SZ];
+    u8* dst[MFRC522_LL_UART_BUF_SZ];
+    u8 echo[MFRC522_LL_UART_BUF_SZ];
+    mfrc522_ll_status status;
+    size tx_len = 0;
+    size rx_len = 0;
+    bool recv = false;
+
+    for (size i = 0; i < num; ++i) {
+        const mfrc522_ll_xfer* xfer = &xfers[i];
+        u8 addr = xfer->addr & ADDR_MASK;
+
+        for (size j = 0; j < xfer->bytes; ++j) {
+            /* Send pending bytes if there is no room for the current one */
+            if (tx_len + 2 > MFRC522_LL_UART_BUF_SZ) {
+                status = uart_exchange(dev, tx, tx_len, dst, echo, rx_len, recv);
+                ERROR_IF_NEQ(status, mfrc522_ll_status_ok);
+                tx_len = 0;
+                rx_len = 0;
+                recv = false;
+            }
+
+            if (NULL != xfer->tx) {
+                tx[tx_len++] = addr;
+                tx[tx_len++] = xfer->tx[j];
+                dst[rx_len] = NULL;
+                echo[rx_len++] = addr;
+            } else {
+                tx[tx_len++] = addr | ADDR_READ;
+                dst[rx_len++] = &xfer->rx[j];
+                recv = true;
+            }
+        }
+    }
+
+    if (!tx_len) {
+        return mfrc522_ll_status_ok;
+    }
+    return uart_exchange(dev, tx, tx_len, dst, echo, rx_len, recv);
+}
+
+static mfrc522_ll_status
+uart_send(void* ctx, u8 addr, size bytes, const u8* payload)
+{
+    mfrc522_ll_xfer xfer = {addr, bytes, payload, NULL};
+    return uart_transfer_multi(ctx, &xfer, 1);
+}
+
+static mfrc522_ll_status
+uart_recv_mul(void* ctx, u8 addr, size bytes, u8* payload)
+{
+    mfrc522_ll_xfer xfer = {addr, bytes, NULL, payload};
+    return uart_transfer_multi(ctx, &xfer, 1);
+}
+
+static mfrc522_ll_status
+uart_recv(void* ctx, u8 addr, u8* payload)
+{
+    return uart_recv_mul(ctx, addr, 1, payload);
+}
+
+/* Check whether a device responds at given rate. SerialSpeedReg tells which rate the device uses */
+static bool
+uart_probe(mfrc522_ll_uart* dev, const uart_rate* rate)
+{
+    u8 serial_speed;
+    if (!uart_set_rate(dev, rate) ||
+        (mfrc522_ll_status_ok != uart_recv(dev, mfrc522_reg_serial_speed, &serial_speed))) {
+        return false;
+    }
+    return rate->serial_speed == serial_speed;
+}
+
+/* Find a rate a device currently uses. A device may keep the rate negotiated by a previous session */
+static const uart_rate*
+uart_find_rate(mfrc522_ll_uart* dev)
+{
+    const uart_rate* reset_rate = &uart_rates[SIZE_ARRAY(uart_rates) - 1];
+    if (uart_probe(dev, reset_rate)) {
+        return reset_rate;
+    }
+
+    for (size i = 0; i < SIZE_ARRAY(uart_rates) - 1; ++i) {
+        if (uart_probe(dev, &uart_rates[i])) {
+            return &uart_rates[i];
+        }
+    }
+    return NULL;
+}
+
+/* Negotiate the highest rate accepted by both sides. Returns the rate agreed on or NULL if the device is lost */
+static const uart_rate*
+uart_upgrade_rate(mfrc522_ll_uart* dev, const uart_rate* cur)
+{
+    for (const uart_rate* rate = uart_rates; rate < cur; ++rate) {
+        if (rate->baud > dev->conf.max_baud) {
+            continue;
+        }
+
+        /* The host has to accept the rate before the device is asked for it. Otherwise the device would switch to
+         * a rate the host cannot reach. The write itself is sent at current rate */
+        bool host_ok = uart_set_rate(dev, rate);
+        if (UNLIKELY(!uart_set_rate(dev, cur))) {
+            return NULL;
+        }
+        if (!host_ok) {
+            continue;
+        }
+
+        /* The write is acknowledged at current rate, afterwards the device switches to the new one */
+        if (UNLIKELY(mfrc522_ll_status_ok != uart_send(dev, mfrc522_reg_serial_speed, 1, &rate->serial_speed))) {
+            return NULL;
+        }
+        if (uart_probe(dev, rate)) {
+            return rate;
+        }
+
+        /* The device rejected the rate, make sure it still uses the old one before trying a lower rate */
+        if (!uart_probe(dev, cur)) {
+            return NULL;
+        }
+    }
+    return cur;
+}
+
+static mfrc522_ll_status
+uart_init(void* ctx)
+{
+    mfrc522_ll_uart* dev = ctx;
+    ERROR_IF_EQ(dev, NULL, mfrc522_ll_status_init_err);
+    mfrc522_ll_uart_close(dev);
+
+    dev->fd = open(dev->conf.path, O_RDWR | O_NOCTTY);
+    if (UNLIKELY(dev->fd < 0)) {
+        return mfrc522_ll_status_init_err;
+    }
+
+    const uart_rate* rate = uart_find_rate(dev);
+    if (NULL != rate) {
+        rate = uart_upgrade_rate(dev, rate);
+    }
+    if (UNLIKELY(NULL == rate)) {
+        mfrc522_ll_uart_close(dev);
+        return mfrc522_ll_status_init_err;
+    }
+
+    dev->baud = rate->baud;
+    return mfrc522_ll_status_ok;
+}
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public variables ------------------- */
+/* ------------------------------------------------------------ */
+
+const mfrc522_ll_ops mfrc522_ll_uart_ops = {
+    .version = MFRC522_LL_OPS_VERSION,
+    .init = uart_init,
+    .send = uart_send,
+    .recv = uart_recv,
+    .recv_mul = uart_recv_mul,
+    .delay = mfrc522_ll_posix_delay,
+    .transfer_multi = uart_transfer_multi,
+    .now = mfrc522_ll_posix_now
+};
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+mfrc522_ll_status
+mfrc522_ll_uart_setup(mfrc522_ll_uart* dev, const mfrc522_ll_uart_conf* conf)
+{
+    ERROR_IF_EQ(dev, NULL, mfrc522_ll_status_init_err);
+    ERROR_IF_EQ(conf, NULL, mfrc522_ll_status_init_err);
+    ERROR_IF_EQ(conf->path, NULL, mfrc522_ll_status_init_err);
+
+    dev->fd = -1;
+    dev->baud = 0;
+    dev->conf = *conf;
+    if (!dev->conf.max_baud) {
+        dev->conf.max_baud = MFRC522_LL_UART_MAX_BAUD;
+    }
+    if (!dev->conf.timeout) {
+        dev->conf.timeout = MFRC522_LL_UART_DEF_TIMEOUT;
+    }
+    if (NULL == dev->conf.tcsetattr_fn) {
+        dev->conf.tcsetattr_fn = tcsetattr;
+    }
+    return mfrc522_ll_status_ok;
+}
+
+u32
+mfrc522_ll_uart_baud(const mfrc522_ll_uart* dev)
+{
+    return (NULL != dev && dev->fd >= 0) ? dev->baud : 0;
+}
+
+void
+mfrc522_ll_uart_close(mfrc522_ll_uart* dev)
+{
+    if (NULL != dev && dev->fd >= 0) {
+        close(dev->fd);
+        dev->fd = -1;
+        dev->baud = 0;
+    }
+}
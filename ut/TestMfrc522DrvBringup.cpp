@@ -0,0 +1,456 @@
+#include "mfrc522_drv.h"
+#include "mfrc522_conf.h"
+#include <gtest/gtest.h>
+#include "common/SimulatedChip.h"
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Private classes -------------------- */
+/* ------------------------------------------------------------ */
+
+/*
+ * MFRC522 which keeps its registers between host sessions. Soft reset brings registers back to reset values and takes
+ * some time. Self test fills FIFO with expected bytes. Every low-level call is counted as one bus transaction.
+ */
+class BootChip : public SimulatedChip
+{
+public:
+    BootChip()
+    {
+        busCost = 50;
+        reset();
+    }
+
+    u32 resetLatency = 1000; /* Time needed by the oscillator to become stable after soft reset */
+    size writes = 0;
+    size resets = 0;
+    size selfTests = 0;
+
+private:
+    void reset()
+    {
+        u8 version = regs[mfrc522_reg_version];
+        std::fill(std::begin(regs), std::end(regs), 0x00);
+        regs[mfrc522_reg_version] = version;
+        regs[mfrc522_reg_command] = 0x20 | mfrc522_reg_cmd_idle;
+        regs[mfrc522_reg_mode] = 0x3F;
+        regs[mfrc522_reg_tx_control] = 0x80;
+        regs[mfrc522_reg_rf_cfg] = 0x48;
+        regs[mfrc522_reg_auto_test] = 0x40;
+        fifo.clear();
+    }
+
+    bool ready() const
+    {
+        return static_cast<i32>(clock - readyAt) >= 0;
+    }
+
+    void write(u8 addr, u8 val) override
+    {
+        ++writes;
+        if (mfrc522_reg_command != addr) {
+            SimulatedChip::write(addr, val);
+        } else if (mfrc522_reg_cmd_soft_reset == (val & 0x0F)) {
+            reset();
+            ++resets;
+            readyAt = clock + resetLatency;
+        } else if (mfrc522_reg_cmd_crc == (val & 0x0F) && (0x09 == (regs[mfrc522_reg_auto_test] & 0x0F))) {
+            const u8 out[] = {MFRC522_CONF_SELF_TEST_FIFO_OUT};
+            fifo.assign(std::begin(out), std::end(out));
+            ++selfTests;
+            regs[addr] = val; /* CalcCRC keeps running until another command is invoked */
+        } else {
+            /* Other commands used here terminate at once */
+            regs[addr] = (mfrc522_reg_cmd_crc == (val & 0x0F)) ? val : (val & 0xF0) | mfrc522_reg_cmd_idle;
+        }
+    }
+
+    u8 read(u8 addr) override
+    {
+        if (mfrc522_reg_command == addr && !ready()) {
+            /* Soft reset command is active until the device is ready */
+            return (regs[addr] & 0xF0) | mfrc522_reg_cmd_soft_reset;
+        }
+        return SimulatedChip::read(addr);
+    }
+
+    u32 readyAt = 0;
+};
+
+/* Configuration of a reader: timer, modulation, CRC preset and antenna */
+static const mfrc522_drv_script_entry image[] = {
+    MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_mode, 0x8D),
+    MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_prescaler, 0x3E),
+    MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_reload_hi, 0x00),
+    MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_reload_lo, 0x1E),
+    MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tx_ask, 0x40),
+    MFRC522_DRV_SCRIPT_WR(mfrc522_reg_mode, 0x3D),
+    MFRC522_DRV_SCRIPT_WR(mfrc522_reg_rf_cfg, 0x70),
+    MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tx_control, 0x83),
+};
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+/* Bring-up settings applying the image above without self test */
+static mfrc522_drv_bringup_conf bringupConf()
+{
+    mfrc522_drv_bringup_conf buConf;
+    buConf.image = image;
+    buConf.image_sz = SIZE_ARRAY(image);
+    buConf.self_test = mfrc522_drv_bringup_self_test_skip;
+    buConf.force_reset = false;
+    return buConf;
+}
+
+/* Every call stands for a new host process: nothing is known about the device */
+static mfrc522_drv_status bringup(BootChip* chip, const mfrc522_drv_bringup_conf* buConf, bool* warm)
+{
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    mfrc522_drv_reg_cache cache;
+    conf.ll_ops = SimulatedChip::ops(true, true);
+    conf.ll_ctx = chip;
+    conf.atqa_verify_fn = nullptr;
+    mfrc522_drv_reg_cache_attach(&conf, &cache);
+    conf.chip_version = 0x00;
+    return mfrc522_drv_bringup(&conf, buConf, warm);
+}
+
+static void expectImage(const BootChip& chip)
+{
+    for (const auto& entry : image) {
+        EXPECT_EQ(entry.val, chip.regs[entry.addr]);
+    }
+}
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Test cases ------------------------ */
+/* ------------------------------------------------------------ */
+
+TEST(TestMfrc522DrvBringup, mfrc522_drv_bringup__ColdStart__ImageApplied)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    chip.regs[mfrc522_reg_tim_mode] = 0x12; /* Garbage left by somebody else */
+
+    bool warm = true;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    EXPECT_FALSE(warm);
+    EXPECT_EQ(1, chip.resets);
+    EXPECT_EQ(0, chip.selfTests);
+    expectImage(chip);
+}
+
+TEST(TestMfrc522DrvBringup, mfrc522_drv_bringup__WarmStart__ResetAndWritesSkipped)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    bool warm;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    ASSERT_FALSE(warm);
+
+    chip.transactions = 0;
+    chip.writes = 0;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    EXPECT_TRUE(warm);
+    EXPECT_EQ(1, chip.resets);
+    EXPECT_EQ(0, chip.writes);
+    EXPECT_EQ(1, chip.transactions); /* Identity and image are read in one batch */
+    expectImage(chip);
+}
+
+TEST(TestMfrc522DrvBringup, mfrc522_drv_bringup__MaskedEntries__OwnBitsCompared)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    const mfrc522_drv_script_entry masked[] = {
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_tx_control, 1, TXCONTROL_TX1RFEN),
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_tx_control, 1, TXCONTROL_TX2RFEN),
+    };
+    buConf.image = masked;
+    buConf.image_sz = SIZE_ARRAY(masked);
+
+    bool warm;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    ASSERT_FALSE(warm);
+    EXPECT_EQ(0x83, chip.regs[mfrc522_reg_tx_control]);
+
+    /* Other bits of the register are not a part of the image */
+    chip.regs[mfrc522_reg_tx_control] = 0x03;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    EXPECT_TRUE(warm);
+    EXPECT_EQ(1, chip.resets);
+
+    chip.regs[mfrc522_reg_tx_control] = 0x01;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    EXPECT_FALSE(warm);
+    EXPECT_EQ(2, chip.resets);
+    EXPECT_EQ(0x83, chip.regs[mfrc522_reg_tx_control]);
+}
+
+TEST(TestMfrc522DrvBringup, mfrc522_drv_bringup__PartiallyConfigured__DeviceReset)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    bool warm;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+
+    /* Previous session died in the middle of reconfiguration */
+    chip.regs[mfrc522_reg_rf_cfg] = 0x48;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    EXPECT_FALSE(warm);
+    EXPECT_EQ(2, chip.resets);
+    expectImage(chip);
+}
+
+TEST(TestMfrc522DrvBringup, mfrc522_drv_bringup__DeviceBusy__DeviceReset)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    bool warm;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+
+    /* Previous session left the device in the middle of a command */
+    chip.regs[mfrc522_reg_command] = mfrc522_reg_cmd_transceive;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    EXPECT_FALSE(warm);
+    EXPECT_EQ(2, chip.resets);
+
+    /* ... or in soft power-down */
+    chip.regs[mfrc522_reg_command] = 0x10 | mfrc522_reg_cmd_idle;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    EXPECT_FALSE(warm);
+    EXPECT_EQ(3, chip.resets);
+    expectImage(chip);
+}
+
+TEST(TestMfrc522DrvBringup, mfrc522_drv_bringup__ResetForced__DeviceReset)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    bool warm;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+
+    buConf.force_reset = true;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    EXPECT_FALSE(warm);
+    EXPECT_EQ(2, chip.resets);
+    expectImage(chip);
+}
+
+TEST(TestMfrc522DrvBringup, mfrc522_drv_bringup__SelfTest__RunOnColdStartOnly)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    buConf.self_test = mfrc522_drv_bringup_self_test_run;
+
+    bool warm;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    EXPECT_FALSE(warm);
+    EXPECT_EQ(1, chip.resets); /* Self test resets the device on its own */
+    EXPECT_EQ(1, chip.selfTests);
+    EXPECT_EQ(mfrc522_reg_cmd_idle, chip.regs[mfrc522_reg_command] & 0x0F);
+    EXPECT_EQ(0x00, chip.regs[mfrc522_reg_auto_test] & 0x0F);
+    expectImage(chip);
+
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    EXPECT_TRUE(warm);
+    EXPECT_EQ(1, chip.selfTests);
+}
+
+TEST(TestMfrc522DrvBringup, mfrc522_drv_bringup__InvalidImage__Failure)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    const mfrc522_drv_script_entry poll[] = {
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_mode, 0x3D),
+        MFRC522_DRV_SCRIPT_POLL(mfrc522_reg_status1, 0x20, 0x20),
+    };
+    const mfrc522_drv_script_entry volatileReg[] = {
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_com_irq, 0x7F),
+    };
+
+    bool warm;
+    buConf.image = poll;
+    buConf.image_sz = SIZE_ARRAY(poll);
+    EXPECT_EQ(mfrc522_drv_status_nok, bringup(&chip, &buConf, &warm));
+    buConf.image = volatileReg;
+    buConf.image_sz = SIZE_ARRAY(volatileReg);
+    EXPECT_EQ(mfrc522_drv_status_nok, bringup(&chip, &buConf, &warm));
+    buConf.image = nullptr;
+    EXPECT_EQ(mfrc522_drv_status_nullptr, bringup(&chip, &buConf, &warm));
+    EXPECT_EQ(0, chip.transactions);
+}
+
+TEST(TestMfrc522DrvBringup, mfrc522_drv_bringup__UnsupportedChip__Failure)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    chip.regs[mfrc522_reg_version] = 0x12;
+
+    bool warm;
+    EXPECT_EQ(mfrc522_drv_status_dev_err, bringup(&chip, &buConf, &warm));
+    EXPECT_EQ(0, chip.writes);
+}
+
+TEST(TestMfrc522DrvBringup, mfrc522_drv_bringup__ComparedToFullInit__FewerBusTransactions)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    /* Typical sequence without bring-up: init, reset, self test and module initialization */
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    mfrc522_drv_reg_cache cache;
+    conf.ll_ops = SimulatedChip::ops(true, true);
+    conf.ll_ctx = &chip;
+    conf.atqa_verify_fn = nullptr;
+
+    u32 start = chip.clock;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_init(&conf));
+    mfrc522_drv_reg_cache_attach(&conf, &cache);
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_self_test(&conf));
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_soft_reset(&conf));
+    for (const auto& entry : image) {
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_script_exec(&conf, &entry, 1));
+    }
+    u32 legacyTime = chip.clock - start;
+    size legacyMessages = chip.transactions;
+
+    bool warm;
+    chip.transactions = 0;
+    start = chip.clock;
+    buConf.force_reset = true;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    u32 coldTime = chip.clock - start;
+    size coldMessages = chip.transactions;
+
+    chip.transactions = 0;
+    start = chip.clock;
+    buConf.force_reset = false;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    ASSERT_TRUE(warm);
+    u32 warmTime = chip.clock - start;
+    size warmMessages = chip.transactions;
+
+    RecordProperty("LegacyMessages", static_cast<int>(legacyMessages));
+    RecordProperty("LegacyTime", static_cast<int>(legacyTime));
+    RecordProperty("ColdMessages", static_cast<int>(coldMessages));
+    RecordProperty("ColdTime", static_cast<int>(coldTime));
+    RecordProperty("WarmMessages", static_cast<int>(warmMessages));
+    RecordProperty("WarmTime", static_cast<int>(warmTime));
+    EXPECT_LT(coldMessages, legacyMessages);
+    EXPECT_EQ(1, warmMessages);
+    EXPECT_LT(warmTime, coldTime);
+}
+
+TEST(TestMfrc522DrvSnapshot, mfrc522_drv_snapshot_get__EachRegister__HostOwnedOnesCaptured)
+{
+    /* Each host-owned register except for BitFramingReg and SerialSpeedReg is captured exactly once */
+    mfrc522_drv_reg_snapshot snap;
+    for (size i = 0; i < MFRC522_DRV_SNAPSHOT_SZ; ++i) {
+        snap.regs[i] = static_cast<u8>(i);
+    }
+
+    size captured = 0;
+    for (u8 addr = 0; addr < MFRC522_DRV_REG_NUM; ++addr) {
+        u8 val;
+        mfrc522_drv_status status = mfrc522_drv_snapshot_get(&snap, static_cast<mfrc522_reg>(addr), &val);
+        bool expected = mfrc522_drv_reg_cacheable(static_cast<mfrc522_reg>(addr)) &&
+                        (mfrc522_reg_bit_framing != addr) && (mfrc522_reg_serial_speed != addr);
+        ASSERT_EQ(expected ? mfrc522_drv_status_ok : mfrc522_drv_status_nok, status) << static_cast<int>(addr);
+        if (expected) {
+            EXPECT_EQ(captured++, val);
+        }
+    }
+    EXPECT_EQ(MFRC522_DRV_SNAPSHOT_SZ, captured);
+}
+
+TEST(TestMfrc522DrvSnapshot, mfrc522_drv_restore__AfterReset__ConfigurationRestored)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    bool warm;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = SimulatedChip::ops(true, true);
+    conf.ll_ctx = &chip;
+
+    mfrc522_drv_reg_snapshot snap;
+    chip.transactions = 0;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_snapshot(&conf, &snap));
+    EXPECT_EQ(1, chip.transactions);
+    u8 val;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_snapshot_get(&snap, mfrc522_reg_rf_cfg, &val));
+    EXPECT_EQ(0x70, val);
+
+    /* Brown-out brings registers back to reset values */
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_soft_reset(&conf));
+    EXPECT_NE(0x70, chip.regs[mfrc522_reg_rf_cfg]);
+
+    chip.transactions = 0;
+    chip.writes = 0;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_restore(&conf, &snap));
+    EXPECT_EQ(1, chip.transactions);
+    EXPECT_EQ(MFRC522_DRV_SNAPSHOT_SZ, chip.writes);
+    expectImage(chip);
+
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+    EXPECT_TRUE(warm);
+}
+
+TEST(TestMfrc522DrvSnapshot, mfrc522_drv_snapshot_diff__ConfigurationDrifted__ChangedRegistersReported)
+{
+    BootChip chip;
+    auto buConf = bringupConf();
+
+    bool warm;
+    ASSERT_EQ(mfrc522_drv_status_ok, bringup(&chip, &buConf, &warm));
+
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    mfrc522_drv_reg_cache cache;
+    conf.ll_ops = SimulatedChip::ops(true, true);
+    conf.ll_ctx = &chip;
+    mfrc522_drv_reg_cache_attach(&conf, &cache);
+
+    mfrc522_drv_reg_snapshot ref;
+    mfrc522_drv_reg_snapshot snap;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_snapshot(&conf, &ref));
+    u64 diff = UINT64_MAX;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_snapshot_diff(&ref, &ref, &diff));
+    EXPECT_EQ(0, diff);
+
+    /* Configuration drifted, e.g. somebody else accessed the device */
+    chip.regs[mfrc522_reg_tim_reload_lo] = 0x20;
+    chip.regs[mfrc522_reg_tx_control] = 0x80;
+    chip.regs[mfrc522_reg_serial_speed] = 0x7A; /* Not a part of a snapshot */
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_snapshot(&conf, &snap));
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_snapshot_diff(&snap, &ref, &diff));
+    EXPECT_EQ((1ULL << mfrc522_reg_tim_reload_lo) | (1ULL << mfrc522_reg_tx_control), diff);
+
+    /* Snapshot updates register shadow cache */
+    EXPECT_TRUE(cache.valid & (1ULL << mfrc522_reg_tx_control));
+    EXPECT_EQ(0x80, cache.regs[mfrc522_reg_tx_control]);
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_restore(&conf, &ref));
+    expectImage(chip);
+    EXPECT_EQ(0x1E, cache.regs[mfrc522_reg_tim_reload_lo]);
+
+    EXPECT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_snapshot_diff(&snap, nullptr, &diff));
+    EXPECT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_snapshot(&conf, nullptr));
+    EXPECT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_restore(nullptr, &ref));
+}
@@ -47,17 +47,58 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_init__NullCases)
     EXPECT_EQ(mfrc522_drv_status_nullptr, status);
 }
 
+TEST(TestMfrc522DrvCommon, mfrc522_drv_conf_init__NullCases)
+{
+    auto status = mfrc522_drv_conf_init(nullptr);
+    EXPECT_EQ(mfrc522_drv_status_nullptr, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_conf_init__TypicalCase__DefaultsSet)
+{
+    mfrc522_drv_conf conf;
+    conf.atqa_verify_fn = piccAcceptAny;
+    conf.reg_cache = reinterpret_cast<mfrc522_drv_reg_cache*>(0x1); /* Stack garbage */
+    conf.crc_mode = mfrc522_drv_crc_mode_sw;
+
+    auto status = mfrc522_drv_conf_init(&conf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(nullptr, conf.ll_ctx);
+    ASSERT_EQ(nullptr, conf.atqa_verify_fn);
+    ASSERT_EQ(nullptr, conf.reg_cache);
+    ASSERT_EQ(mfrc522_drv_crc_mode_coproc, conf.crc_mode);
+}
+
 TEST(TestMfrc522DrvCommon, mfrc522_drv_init__LowLevelInitError__Failure)
 {
     /* Set expectations */
     MOCK(mfrc522_ll_init);
-    MOCK_CALL_NO_ARGS(mfrc522_ll_init).WillOnce(Return(mfrc522_ll_status_init_err));
+    MOCK_CALL(mfrc522_ll_init, _).WillOnce(Return(mfrc522_ll_status_init_err));
 
     mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ctx = nullptr;
     auto status = mfrc522_drv_init(&conf);
     ASSERT_EQ(mfrc522_drv_status_ll_err, status);
 }
 
+TEST(TestMfrc522DrvCommon, mfrc522_drv_init__LlContextSet__ContextPassedToLowLevelCalls)
+{
+    int dev = 0; /* Any object to point at */
+
+    /* Set expectations */
+    MOCK(mfrc522_ll_init);
+    MOCK(mfrc522_ll_recv);
+    MOCK_CALL(mfrc522_ll_init, &dev).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_recv, &dev, mfrc522_reg_version, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(MFRC522_CONF_CHIP_TYPE), Return(mfrc522_ll_status_ok)));
+
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ctx = &dev;
+    auto status = mfrc522_drv_init(&conf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+}
+
 TEST(TestMfrc522DrvCommon, mfrc522_drv_init__LlReceiveError__LlErrorIsGenerated)
 {
     u8 payload = 0xAB; /* Assume that low-level call failed, thus trash value was returned */
@@ -65,10 +106,12 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_init__LlReceiveError__LlErrorIsGenerated)
 
     /* Set expectations */
     MOCK(mfrc522_ll_recv);
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_version, NotNull())
-        .WillOnce(DoAll(SetArgPointee<1>(payload), Return(llStatus)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_version, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(payload), Return(llStatus)));
 
     mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ctx = nullptr;
     auto status = mfrc522_drv_init(&conf);
     ASSERT_EQ(mfrc522_drv_status_ll_err, status);
     /* In a case low-level API returns an error 'chip_version' field should be equal to MFRC522_REG_VERSION_INVALID */
@@ -79,10 +122,12 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_init__DeviceNotSupported__Failure)
 {
     /* Set expectations */
     MOCK(mfrc522_ll_recv);
-    MOCK_CALL( mfrc522_ll_recv, mfrc522_reg_version, NotNull())
-        .WillOnce(DoAll(SetArgPointee<1>(0xAA), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL( mfrc522_ll_recv, _, mfrc522_reg_version, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(0xAA), Return(mfrc522_ll_status_ok)));
 
     mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ctx = nullptr;
     auto status = mfrc522_drv_init(&conf);
     ASSERT_EQ(mfrc522_drv_status_dev_err, status);
 }
@@ -91,10 +136,12 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_init__DeviceFound__Success)
 {
     /* Set expectations */
     MOCK(mfrc522_ll_recv);
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_version, NotNull())
-        .WillOnce(DoAll(SetArgPointee<1>(MFRC522_CONF_CHIP_TYPE), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_version, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(MFRC522_CONF_CHIP_TYPE), Return(mfrc522_ll_status_ok)));
 
     mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ctx = nullptr;
     auto status = mfrc522_drv_init(&conf);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
 
@@ -102,6 +149,22 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_init__DeviceFound__Success)
     ASSERT_EQ(MFRC522_CONF_CHIP_TYPE, conf.chip_version);
 }
 
+TEST(TestMfrc522DrvCommon, mfrc522_drv_init__RegCacheNotAttached__GarbagePointerNotUsed)
+{
+    /* Set expectations */
+    MOCK(mfrc522_ll_recv);
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_version, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(MFRC522_CONF_CHIP_TYPE), Return(mfrc522_ll_status_ok)));
+
+    /* Configuration filled field by field by a caller unaware of the cache */
+    mfrc522_drv_conf conf;
+    conf.ll_ctx = nullptr;
+    conf.reg_cache = reinterpret_cast<mfrc522_drv_reg_cache*>(0x1);
+    auto status = mfrc522_drv_init(&conf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(nullptr, conf.reg_cache);
+}
+
 TEST(TestMfrc522DrvCommon, mfrc522_drv_write__NullCases)
 {
     u8 payload = 0xAB;
@@ -127,7 +190,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_fifo_store__ValidLowLevelCallIsMade)
 
     /* Expect that low-level call is made */
     MOCK(mfrc522_ll_send);
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_data, 1, Pointee(0xBC)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, 1, Pointee(0xBC)).WillOnce(Return(mfrc522_ll_status_ok));
 
     auto status = mfrc522_drv_fifo_store(&device, 0xBC);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -142,7 +205,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_fifo_store_mul__ValidLowLevelCallIsMade)
 
     /* Expect that low-level call is made */
     MOCK(mfrc522_ll_send);
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_data, SIZE_ARRAY(bytes), &bytes[0])
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, SIZE_ARRAY(bytes), &bytes[0])
         .WillOnce(Return(mfrc522_ll_status_ok));
 
     auto status = mfrc522_drv_fifo_store_mul(&dev, &bytes[0], SIZE_ARRAY(bytes));
@@ -156,21 +219,154 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_fifo_read__ValidLowLevelCallIsMade)
 
     /* Expect that low-level call is made */
     MOCK(mfrc522_ll_recv);
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_fifo_data, &buffer)
-        .WillOnce(DoAll(SetArgPointee<1>(0xFA), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_fifo_data, &buffer)
+        .WillOnce(DoAll(SetArgPointee<2>(0xFA), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_fifo_read(&dev, &buffer);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
     ASSERT_EQ(0xFA, buffer);
 }
 
+TEST(TestMfrc522DrvCommon, mfrc522_drv_read_mul__NullCases)
+{
+    auto dev = initDevice();
+    u8 pl;
+
+    auto status = mfrc522_drv_read_mul(&dev, mfrc522_reg_fifo_data, 1, nullptr);
+    ASSERT_EQ(mfrc522_drv_status_nullptr, status);
+
+    status = mfrc522_drv_read_mul(nullptr, mfrc522_reg_fifo_data, 1, &pl);
+    ASSERT_EQ(mfrc522_drv_status_nullptr, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_fifo_read_mul__SingleLowLevelCallIsMade)
+{
+    auto dev = initDevice();
+    const u8 fifo[] = {0xFA, 0x01, 0xCC};
+    u8 buffer[SIZE_ARRAY(fifo)];
+
+    /* Expect that single low-level call is made */
+    MOCK(mfrc522_ll_recv_mul);
+    MOCK_CALL(mfrc522_ll_recv_mul, _, mfrc522_reg_fifo_data, SIZE_ARRAY(fifo), &buffer[0])
+        .WillOnce(DoAll(SetArrayArgument<3>(fifo, fifo + SIZE_ARRAY(fifo)), Return(mfrc522_ll_status_ok)));
+
+    auto status = mfrc522_drv_fifo_read_mul(&dev, &buffer[0], SIZE_ARRAY(buffer));
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(0, memcmp(fifo, buffer, SIZE_ARRAY(fifo)));
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_fifo_read_mul__LowLevelError__Failure)
+{
+    auto dev = initDevice();
+    u8 buffer[2];
+
+    MOCK(mfrc522_ll_recv_mul);
+    MOCK_CALL(mfrc522_ll_recv_mul, _, mfrc522_reg_fifo_data, 2, &buffer[0])
+        .WillOnce(Return(mfrc522_ll_status_recv_err));
+
+    auto status = mfrc522_drv_fifo_read_mul(&dev, &buffer[0], 2);
+    ASSERT_EQ(mfrc522_drv_status_ll_err, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_read_regs__NullCases)
+{
+    auto dev = initDevice();
+    const mfrc522_reg regs[] = {mfrc522_reg_com_irq};
+    u8 out[SIZE_ARRAY(regs)];
+
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_read_regs(nullptr, regs, SIZE_ARRAY(regs), out));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_read_regs(&dev, nullptr, SIZE_ARRAY(regs), out));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_read_regs(&dev, regs, SIZE_ARRAY(regs), nullptr));
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_read_regs__NoBatchLowLevel__RegistersReadInOrder)
+{
+    auto dev = initDevice();
+    const mfrc522_reg regs[] = {mfrc522_reg_status1, mfrc522_reg_fifo_level, mfrc522_reg_control};
+    u8 out[SIZE_ARRAY(regs)];
+
+    /* Set expectations */
+    MOCK(mfrc522_ll_recv);
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_status1, &out[0])
+        .WillOnce(DoAll(SetArgPointee<2>(0x21), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_fifo_level, &out[1])
+        .WillOnce(DoAll(SetArgPointee<2>(0x05), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_control, &out[2])
+        .WillOnce(DoAll(SetArgPointee<2>(0x10), Return(mfrc522_ll_status_ok)));
+
+    auto status = mfrc522_drv_read_regs(&dev, regs, SIZE_ARRAY(regs), out);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(0x21, out[0]);
+    ASSERT_EQ(0x05, out[1]);
+    ASSERT_EQ(0x10, out[2]);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_read_regs__LowLevelError__Failure)
+{
+    auto dev = initDevice();
+    const mfrc522_reg regs[] = {mfrc522_reg_com_irq, mfrc522_reg_div_irq};
+    u8 out[SIZE_ARRAY(regs)];
+
+    /* Remaining registers are not read after an error */
+    MOCK(mfrc522_ll_recv);
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_com_irq, NotNull()).WillOnce(Return(mfrc522_ll_status_recv_err));
+
+    auto status = mfrc522_drv_read_regs(&dev, regs, SIZE_ARRAY(regs), out);
+    ASSERT_EQ(mfrc522_drv_status_ll_err, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_write_async__NullCases)
+{
+    auto dev = initDevice();
+    mfrc522_drv_async_req req;
+    auto cb = [](mfrc522_drv_status status, void* arg) {
+        static_cast<void>(status);
+        static_cast<void>(arg);
+    };
+    u8 pl = 0x00;
+
+    auto status = mfrc522_drv_write_async(nullptr, &req, mfrc522_reg_fifo_data, 1, &pl, cb, nullptr);
+    ASSERT_EQ(mfrc522_drv_status_nullptr, status);
+
+    status = mfrc522_drv_write_async(&dev, nullptr, mfrc522_reg_fifo_data, 1, &pl, cb, nullptr);
+    ASSERT_EQ(mfrc522_drv_status_nullptr, status);
+
+    status = mfrc522_drv_write_async(&dev, &req, mfrc522_reg_fifo_data, 1, nullptr, cb, nullptr);
+    ASSERT_EQ(mfrc522_drv_status_nullptr, status);
+
+    status = mfrc522_drv_write_async(&dev, &req, mfrc522_reg_fifo_data, 1, &pl, nullptr, nullptr);
+    ASSERT_EQ(mfrc522_drv_status_nullptr, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_read_mul_async__NoAsyncLowLevel__CompletedAtOnce)
+{
+    auto dev = initDevice();
+    const u8 fifo[] = {0xFA, 0x01};
+    u8 buffer[SIZE_ARRAY(fifo)];
+
+    MOCK(mfrc522_ll_recv_mul);
+    MOCK_CALL(mfrc522_ll_recv_mul, _, mfrc522_reg_fifo_data, SIZE_ARRAY(fifo), &buffer[0])
+        .WillOnce(DoAll(SetArrayArgument<3>(fifo, fifo + SIZE_ARRAY(fifo)), Return(mfrc522_ll_status_ok)));
+
+    mfrc522_drv_status result = mfrc522_drv_status_nok;
+    auto cb = [](mfrc522_drv_status status, void* arg) { *static_cast<mfrc522_drv_status*>(arg) = status; };
+
+    mfrc522_drv_async_req req;
+    auto status = mfrc522_drv_read_mul_async(&dev, &req, mfrc522_reg_fifo_data, SIZE_ARRAY(buffer), &buffer[0], cb,
+                                             &result);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(mfrc522_drv_status_ok, result);
+    ASSERT_EQ(0, memcmp(fifo, buffer, SIZE_ARRAY(fifo)));
+}
+
 TEST(TestMfrc522DrvCommon, mfrc522_drv_fifo_flush__ValidLowLevelCallIsMade)
 {
     auto dev = initDevice();
 
     /* Expect that low-level call is made */
     MOCK(mfrc522_ll_send);
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_level, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_level, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
 
     auto status = mfrc522_drv_fifo_flush(&dev);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -179,7 +375,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_fifo_flush__ValidLowLevelCallIsMade)
 TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__NullCases)
 {
     mfrc522_drv_conf conf;
-    mfrc522_drv_read_until_conf ruConf;
+    mfrc522_drv_read_until_conf ruConf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
 
     auto status = mfrc522_drv_read_until(&conf, nullptr);
     ASSERT_EQ(mfrc522_drv_status_nullptr, status);
@@ -192,7 +388,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__InfinityFlagEnabled__Success)
 {
     auto conf = initDevice();
 
-    mfrc522_drv_read_until_conf ruConf;
+    mfrc522_drv_read_until_conf ruConf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
     ruConf.addr = mfrc522_reg_fifo_data;
     ruConf.exp_payload = 0x0E;
     ruConf.mask = 0x0F;
@@ -202,10 +398,10 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__InfinityFlagEnabled__Success)
     /* Populate fake responses */
     MOCK(mfrc522_ll_recv);
     InSequence s;
-    MOCK_CALL(mfrc522_ll_recv, ruConf.addr, NotNull()).Times(100)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(0x00), Return(mfrc522_ll_status_ok)));
-    MOCK_CALL(mfrc522_ll_recv, ruConf.addr, NotNull())
-        .WillOnce(DoAll(SetArgPointee<1>(ruConf.exp_payload), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, ruConf.addr, NotNull()).Times(100)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, ruConf.addr, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(ruConf.exp_payload), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_read_until(&conf, &ruConf);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -216,7 +412,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__AnswerOnFirstTry__Success)
 {
     auto conf = initDevice();
 
-    mfrc522_drv_read_until_conf ruConf;
+    mfrc522_drv_read_until_conf ruConf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
     ruConf.addr = mfrc522_reg_fifo_data;
     ruConf.exp_payload = 0xF0;
     ruConf.mask = 0xF0;
@@ -225,8 +421,8 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__AnswerOnFirstTry__Success)
 
     /* Set expectations */
     MOCK(mfrc522_ll_recv);
-    MOCK_CALL(mfrc522_ll_recv, ruConf.addr, NotNull())
-        .WillOnce(DoAll(SetArgPointee<1>(ruConf.exp_payload), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, ruConf.addr, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(ruConf.exp_payload), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_read_until(&conf, &ruConf);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -237,7 +433,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__AnswerOnThirdTime__Success)
 {
     auto conf = initDevice();
 
-    mfrc522_drv_read_until_conf ruConf;
+    mfrc522_drv_read_until_conf ruConf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
     ruConf.addr = mfrc522_reg_fifo_data;
     ruConf.exp_payload = 0x80;
     ruConf.mask = 0xC0;
@@ -247,10 +443,10 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__AnswerOnThirdTime__Success)
     /* Set expectations */
     MOCK(mfrc522_ll_recv);
     InSequence seq;
-    MOCK_CALL(mfrc522_ll_recv, ruConf.addr, NotNull())
-        .WillOnce(DoAll(SetArgPointee<1>(0x00), Return(mfrc522_ll_status_ok)))
-        .WillOnce(DoAll(SetArgPointee<1>(0x40), Return(mfrc522_ll_status_ok)))
-        .WillOnce(DoAll(SetArgPointee<1>(0x8F), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, ruConf.addr, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)))
+        .WillOnce(DoAll(SetArgPointee<2>(0x40), Return(mfrc522_ll_status_ok)))
+        .WillOnce(DoAll(SetArgPointee<2>(0x8F), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_read_until(&conf, &ruConf);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -261,7 +457,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__NoAnswerAfterAllTries__Failur
 {
     auto conf = initDevice();
 
-    mfrc522_drv_read_until_conf ruConf;
+    mfrc522_drv_read_until_conf ruConf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
     ruConf.addr = mfrc522_reg_fifo_data;
     ruConf.exp_payload = 0xAA;
     ruConf.mask = 0xFF;
@@ -270,8 +466,8 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__NoAnswerAfterAllTries__Failur
 
     /* Set expectations */
     MOCK(mfrc522_ll_recv);
-    MOCK_CALL(mfrc522_ll_recv, ruConf.addr, NotNull()).Times(static_cast<i32>(ruConf.retry_cnt + 1))
-        .WillRepeatedly(DoAll(SetArgPointee<1>(0x00), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, ruConf.addr, NotNull()).Times(static_cast<i32>(ruConf.retry_cnt + 1))
+        .WillRepeatedly(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_read_until(&conf, &ruConf);
     ASSERT_EQ(mfrc522_drv_status_dev_rtr_err, status);
@@ -280,6 +476,97 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__NoAnswerAfterAllTries__Failur
     ASSERT_EQ(0x00, ruConf.payload);
 }
 
+TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__DefaultConf__DefaultRetriesWithoutDeadline)
+{
+    auto conf = initDevice();
+
+    /* Only the register and the exit criterion are set */
+    mfrc522_drv_read_until_conf ruConf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+    ruConf.addr = mfrc522_reg_fifo_data;
+    ruConf.exp_payload = 0xAA;
+
+    /* Set expectations */
+    MOCK(mfrc522_ll_recv);
+    MOCK_CALL(mfrc522_ll_recv, _, ruConf.addr, NotNull()).Times(MFRC522_DRV_DEF_RETRY_CNT + 1)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)));
+
+    auto status = mfrc522_drv_read_until(&conf, &ruConf);
+    ASSERT_EQ(mfrc522_drv_status_dev_rtr_err, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_read_until__DeadlineWithoutClock__DelaysSummedUp)
+{
+    auto conf = initDevice();
+
+    mfrc522_drv_read_until_conf ruConf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+    ruConf.addr = mfrc522_reg_fifo_data;
+    ruConf.exp_payload = 0xAA;
+    ruConf.mask = 0xFF;
+    ruConf.retry_cnt = MFRC522_DRV_RETRY_CNT_INF;
+    ruConf.delay = 10;
+    ruConf.first_delay = 20;
+    ruConf.timeout = 100;
+
+    /* Reads after 20, 30, ..., 100us of delays */
+    MOCK(mfrc522_ll_recv);
+    MOCK_CALL(mfrc522_ll_recv, _, ruConf.addr, NotNull()).Times(9)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)));
+
+    auto status = mfrc522_drv_read_until(&conf, &ruConf);
+    ASSERT_EQ(mfrc522_drv_status_dev_rtr_err, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_script_exec__NullCases)
+{
+    auto conf = initDevice();
+    const mfrc522_drv_script_entry script[] = {MFRC522_DRV_SCRIPT_WR(mfrc522_reg_mode, 0x3D)};
+
+    auto status = mfrc522_drv_script_exec(nullptr, script, SIZE_ARRAY(script));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, status);
+
+    status = mfrc522_drv_script_exec(&conf, nullptr, 1);
+    ASSERT_EQ(mfrc522_drv_status_nullptr, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_script_exec__UnknownOperation__Failure)
+{
+    auto conf = initDevice();
+    const mfrc522_drv_script_entry script[] = {{0xFF, mfrc522_reg_mode, 0x00, 0x00}};
+
+    MOCK(mfrc522_ll_send);
+    MOCK_CALL(mfrc522_ll_send, _, _, _, _).Times(0);
+
+    auto status = mfrc522_drv_script_exec(&conf, script, SIZE_ARRAY(script));
+    ASSERT_EQ(mfrc522_drv_status_nok, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_script_exec__PollAndVolatileRegister__PendingWritesSentFirst)
+{
+    auto conf = initDevice();
+    const mfrc522_drv_script_entry script[] = {
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_fifo_data, 0xAB),
+        MFRC522_DRV_SCRIPT_POLL(mfrc522_reg_fifo_level, 0x01, 0x7F),
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_reload_lo, 0x12),
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_command, 1, COMMAND_RCVOFF)
+    };
+
+    /* Set expectations */
+    MOCK(mfrc522_ll_send);
+    MOCK(mfrc522_ll_recv);
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, 1, Pointee(0xAB)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_fifo_level, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)))
+        .WillOnce(DoAll(SetArgPointee<2>(0x81), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_tim_reload_lo, 1, Pointee(0x12)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_command, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(0x0C), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, Pointee(0x2C)).WillOnce(Return(mfrc522_ll_status_ok));
+
+    auto status = mfrc522_drv_script_exec(&conf, script, SIZE_ARRAY(script));
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+}
+
 TEST(TestMfrc522DrvCommon, mfrc522_drv_soft_reset__NullCases)
 {
     auto status = mfrc522_drv_soft_reset(nullptr);
@@ -293,13 +580,13 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_soft_reset__TypicalCase__Success)
     /* Create expectations */
     MOCK(mfrc522_ll_recv);
     InSequence seq;
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_command, NotNull())
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_command, NotNull())
         /* Phase 1: Perform soft reset */
-        .WillOnce(DoAll(SetArgPointee<1>(mfrc522_reg_cmd_soft_reset), Return(mfrc522_ll_status_ok)))
+        .WillOnce(DoAll(SetArgPointee<2>(mfrc522_reg_cmd_soft_reset), Return(mfrc522_ll_status_ok)))
         /* Phase 2: Soft reset has not been done yet */
-        .WillOnce(DoAll(SetArgPointee<1>(mfrc522_reg_cmd_soft_reset), Return(mfrc522_ll_status_ok)))
+        .WillOnce(DoAll(SetArgPointee<2>(mfrc522_reg_cmd_soft_reset), Return(mfrc522_ll_status_ok)))
         /* Phase 3: Idle command is active back */
-        .WillOnce(DoAll(SetArgPointee<1>(mfrc522_reg_cmd_idle), Return(mfrc522_ll_status_ok)));
+        .WillOnce(DoAll(SetArgPointee<2>(mfrc522_reg_cmd_idle), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_soft_reset(&conf);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -311,8 +598,8 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_soft_reset__IdleCommandNotReached__Failur
 
     /* Create expectations */
     MOCK(mfrc522_ll_recv);
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_command, NotNull()).Times(MFRC522_DRV_DEF_RETRY_CNT + 1)
-        .WillRepeatedly(DoAll(SetArgPointee<1>(mfrc522_reg_cmd_mem), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_command, NotNull()).Times(MFRC522_DRV_DEF_RETRY_CNT + 1)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(mfrc522_reg_cmd_mem), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_soft_reset(&conf);
     ASSERT_EQ(mfrc522_drv_status_dev_rtr_err, status);
@@ -335,15 +622,131 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_write_masked__MaskedWritePerformed)
     MOCK(mfrc522_ll_recv);
     MOCK(mfrc522_ll_send);
     InSequence seq;//
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_gs_n, NotNull())
-        .WillOnce(DoAll(SetArgPointee<1>(0x55), Return(mfrc522_ll_status_ok)));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_gs_n, 1, Pointee(0x5D))
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_gs_n, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(0x55), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_gs_n, 1, Pointee(0x5D))
         .WillOnce(Return(mfrc522_ll_status_ok));
 
     auto status = mfrc522_drv_write_masked(&conf, mfrc522_reg_gs_n, 13, msk, pos);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
 }
 
+TEST(TestMfrc522DrvCommon, mfrc522_drv_write_masked__RegCacheCold__RegisterReadOnce)
+{
+    auto conf = initDevice();
+    mfrc522_drv_reg_cache cache;
+    mfrc522_drv_reg_cache_attach(&conf, &cache);
+
+    /* Set expectations */
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_send);
+    InSequence seq;
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_gs_n, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(0x55), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_gs_n, 1, Pointee(0x5D))
+        .WillOnce(Return(mfrc522_ll_status_ok));
+    /* Second write does not require a register to be read */
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_gs_n, 1, Pointee(0x3D))
+        .WillOnce(Return(mfrc522_ll_status_ok));
+
+    auto status = mfrc522_drv_write_masked(&conf, mfrc522_reg_gs_n, 13, 0x0F, 0);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    status = mfrc522_drv_write_masked(&conf, mfrc522_reg_gs_n, 3, 0x0F, 4);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(0x3D, cache.regs[mfrc522_reg_gs_n]);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_write_masked__VolatileRegister__RegisterAlwaysRead)
+{
+    auto conf = initDevice();
+    mfrc522_drv_reg_cache cache;
+    mfrc522_drv_reg_cache_attach(&conf, &cache);
+
+    /* Set expectations */
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_send);
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_control, NotNull()).Times(2)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(0x10), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_control, 1, Pointee(0x50)).Times(2)
+        .WillRepeatedly(Return(mfrc522_ll_status_ok));
+
+    for (auto i = 0; i < 2; ++i) {
+        auto status = mfrc522_drv_write_masked(&conf, mfrc522_reg_control, 1, MFRC522_REG_FIELD(CONTROL_TSTART));
+        ASSERT_EQ(mfrc522_drv_status_ok, status);
+    }
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_reg_cache__SoftReset__CacheInvalidated)
+{
+    auto conf = initDevice();
+    mfrc522_drv_reg_cache cache;
+    mfrc522_drv_reg_cache_attach(&conf, &cache);
+
+    /* Fill the cache with a plain write */
+    MOCK(mfrc522_ll_send);
+    MOCK(mfrc522_ll_recv);
+    IGNORE_REDUNDANT_LL_SEND_CALLS();
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_command, NotNull())
+        .WillRepeatedly(DoAll(SetArgPointee<2>(mfrc522_reg_cmd_idle), Return(mfrc522_ll_status_ok)));
+    auto status = mfrc522_drv_write_byte(&conf, mfrc522_reg_mode, 0x3D);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_TRUE(cache.valid & (1ULL << mfrc522_reg_mode));
+
+    status = mfrc522_drv_soft_reset(&conf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(0, cache.valid);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_reg_cache_invalidate__NullCases)
+{
+    auto status = mfrc522_drv_reg_cache_invalidate(nullptr);
+    ASSERT_EQ(mfrc522_drv_status_nullptr, status);
+
+    /* No cache in use */
+    auto conf = initDevice();
+    status = mfrc522_drv_reg_cache_invalidate(&conf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_reg_cache_attach__NullCases)
+{
+    mfrc522_drv_reg_cache cache;
+    auto status = mfrc522_drv_reg_cache_attach(nullptr, &cache);
+    ASSERT_EQ(mfrc522_drv_status_nullptr, status);
+
+    /* NULL cache detaches the current one */
+    auto conf = initDevice();
+    status = mfrc522_drv_reg_cache_attach(&conf, &cache);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    status = mfrc522_drv_reg_cache_attach(&conf, nullptr);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(nullptr, conf.reg_cache);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_reg_cache_attach__StaleCache__EntriesInvalidated)
+{
+    auto conf = initDevice();
+    mfrc522_drv_reg_cache cache;
+    cache.valid = UINT64_MAX; /* Left from another device */
+
+    auto status = mfrc522_drv_reg_cache_attach(&conf, &cache);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(&cache, conf.reg_cache);
+    ASSERT_EQ(0, cache.valid);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_reg_cacheable__MiscCases)
+{
+    ASSERT_TRUE(mfrc522_drv_reg_cacheable(mfrc522_reg_mode));
+    ASSERT_TRUE(mfrc522_drv_reg_cacheable(mfrc522_reg_tim_reload_lo));
+    ASSERT_TRUE(mfrc522_drv_reg_cacheable(mfrc522_reg_tx_control));
+    ASSERT_FALSE(mfrc522_drv_reg_cacheable(mfrc522_reg_command));
+    ASSERT_FALSE(mfrc522_drv_reg_cacheable(mfrc522_reg_com_irq));
+    ASSERT_FALSE(mfrc522_drv_reg_cacheable(mfrc522_reg_fifo_data));
+    ASSERT_FALSE(mfrc522_drv_reg_cacheable(mfrc522_reg_control));
+    ASSERT_FALSE(mfrc522_drv_reg_cacheable(mfrc522_reg_version));
+}
+
 TEST(TestMfrc522DrvCommon, mfrc522_drv_read_masked__NullCases)
 {
     auto device = initDevice();
@@ -362,8 +765,8 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_read_masked__MaskedReadPerformed)
 
     /* Set expectations */
     MOCK(mfrc522_ll_recv);
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_fifo_data, NotNull())
-        .WillOnce(DoAll(SetArgPointee<1>(0xCF), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_fifo_data, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(0xCF), Return(mfrc522_ll_status_ok)));
 
     /* Call FUT */
     auto status = mfrc522_drv_read_masked(&device, mfrc522_reg_fifo_data, &out, 0x0F, 4);
@@ -383,6 +786,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_self_test__TypicalCase__Success)
 
     /* Self test procedure */
     MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_recv_mul);
     MOCK(mfrc522_ll_send);
     MOCK(mfrc522_drv_soft_reset);
     MOCK(mfrc522_drv_invoke_cmd);
@@ -392,28 +796,26 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_self_test__TypicalCase__Success)
     MOCK_CALL(mfrc522_drv_soft_reset, &conf)
         .WillOnce(Return(mfrc522_drv_status_ok));
     /* 2. Clear the internal buffer */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_data, 1, Pointee(0x00))
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, 1, Pointee(0x00))
         .WillOnce(Return(mfrc522_ll_status_ok));
     MOCK_CALL(mfrc522_drv_invoke_cmd, &conf, mfrc522_reg_cmd_mem)
         .WillOnce(Return(mfrc522_drv_status_ok));
     /* 3. Enable the self test by writing 09h to the AutoTestReg register */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_auto_test, 1, NotNull())
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_auto_test, 1, NotNull())
         .WillOnce(Return(mfrc522_ll_status_ok));
     /* 4. Write 00h to the FIFO buffer */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_data, 1, Pointee(0x00))
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, 1, Pointee(0x00))
         .WillOnce(Return(mfrc522_ll_status_ok));
     /* 5. Start the self test with the CalcCRC command */
     MOCK_CALL(mfrc522_drv_invoke_cmd, &conf, mfrc522_reg_cmd_crc)
         .WillOnce(Return(mfrc522_drv_status_ok));
     /* 6 Wait until FIFO buffer contains 64 bytes */
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_fifo_level, NotNull())
-        .WillOnce(DoAll(SetArgPointee<1>(64), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_fifo_level, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(64), Return(mfrc522_ll_status_ok)));
     /* Read FIFO contents */
     u8 ret[MFRC522_DRV_SELF_TEST_FIFO_SZ] = {MFRC522_CONF_SELF_TEST_FIFO_OUT};
-    for (const auto& r : ret) {
-        MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_fifo_data, _)
-            .WillOnce(DoAll(SetArgPointee<1>(r), Return(mfrc522_ll_status_ok)));
-    }
+    MOCK_CALL(mfrc522_ll_recv_mul, _, mfrc522_reg_fifo_data, MFRC522_DRV_SELF_TEST_FIFO_SZ, NotNull())
+        .WillOnce(DoAll(SetArrayArgument<3>(ret, ret + MFRC522_DRV_SELF_TEST_FIFO_SZ), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_self_test(&conf);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -428,6 +830,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_self_test__FifoContentsDoNotMatchExpected
 
     /* Self test procedure */
     MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_recv_mul);
     MOCK(mfrc522_ll_send);
     MOCK(mfrc522_drv_soft_reset);
     MOCK(mfrc522_drv_invoke_cmd);
@@ -437,28 +840,27 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_self_test__FifoContentsDoNotMatchExpected
     MOCK_CALL(mfrc522_drv_soft_reset, &conf)
             .WillOnce(Return(mfrc522_drv_status_ok));
     /* 2. Clear the internal buffer */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_data, 1, Pointee(0x00))
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, 1, Pointee(0x00))
             .WillOnce(Return(mfrc522_ll_status_ok));
     MOCK_CALL(mfrc522_drv_invoke_cmd, &conf, mfrc522_reg_cmd_mem)
             .WillOnce(Return(mfrc522_drv_status_ok));
     /* 3. Enable the self test by writing 09h to the AutoTestReg register */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_auto_test, 1, NotNull())
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_auto_test, 1, NotNull())
             .WillOnce(Return(mfrc522_ll_status_ok));
     /* 4. Write 00h to the FIFO buffer */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_data, 1, Pointee(0x00))
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, 1, Pointee(0x00))
             .WillOnce(Return(mfrc522_ll_status_ok));
     /* 5. Start the self test with the CalcCRC command */
     MOCK_CALL(mfrc522_drv_invoke_cmd, &conf, mfrc522_reg_cmd_crc)
             .WillOnce(Return(mfrc522_drv_status_ok));
     /* 6 Wait until FIFO buffer contains 64 bytes */
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_fifo_level, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(64), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_fifo_level, NotNull())
+            .WillOnce(DoAll(SetArgPointee<2>(64), Return(mfrc522_ll_status_ok)));
     /* Read FIFO contents */
     u8 ret[MFRC522_DRV_SELF_TEST_FIFO_SZ] = {0x00}; /* Only zeros returned */
-    for (const auto& r : ret) {
-        MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_fifo_data, NotNull())
-                .WillOnce(DoAll(SetArgPointee<1>(r), Return(mfrc522_ll_status_ok)));
-    }
+    MOCK_CALL(mfrc522_ll_recv_mul, _, mfrc522_reg_fifo_data, MFRC522_DRV_SELF_TEST_FIFO_SZ, NotNull())
+            .WillOnce(DoAll(SetArrayArgument<3>(ret, ret + MFRC522_DRV_SELF_TEST_FIFO_SZ),
+                            Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_self_test(&conf);
     ASSERT_EQ(mfrc522_drv_status_self_test_err, status);
@@ -477,11 +879,11 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_invoke_cmd__InvokeCmdThatTerminates__Look
     /* Set expectations */
     MOCK(mfrc522_ll_recv);
     InSequence s;
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_command, NotNull())
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_command, NotNull())
         /* Called when new command needs to be invoked */
-        .WillOnce(DoAll(SetArgPointee<1>(0x00), Return(mfrc522_ll_status_ok)))
+        .WillOnce(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)))
         /* Idle command is active back */
-        .WillOnce(DoAll(SetArgPointee<1>(mfrc522_reg_cmd_idle), Return(mfrc522_ll_status_ok)));
+        .WillOnce(DoAll(SetArgPointee<2>(mfrc522_reg_cmd_idle), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_invoke_cmd(&conf, mfrc522_reg_cmd_mem);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -493,9 +895,9 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_invoke_cmd__InvokeCmdThatDoesNotTerminate
 
     /* Set expectations */
     MOCK(mfrc522_ll_recv);
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_command, NotNull())
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_command, NotNull())
         /* Called when new command needs to be invoked */
-        .WillOnce(DoAll(SetArgPointee<1>(0x00), Return(mfrc522_ll_status_ok)));
+        .WillOnce(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_invoke_cmd(&conf, mfrc522_reg_cmd_transceive);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -522,8 +924,8 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_crc_init__TypicalCase__Success)
     /* Set expectations */
     MOCK(mfrc522_ll_send);
     InSequence s;
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_mode, 1, Pointee(0x01)).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_mode, 1, Pointee(1 << 7)).WillOnce(Return(mfrc522_ll_status_ok));
+    /* Both fields are written at once */
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_mode, 1, Pointee(0x01 | (1 << 7))).WillOnce(Return(mfrc522_ll_status_ok));
 
     auto status = mfrc522_drv_crc_init(&device, &crcConfig);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -553,15 +955,15 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_crc_compute__TypicalCase__CrcComputed)
     /* Phase 1: CRC command should be invoked */
     MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_crc).WillOnce(Return(mfrc522_drv_status_ok));
     /* Phase 2: CRC coprocessor has computed the value */
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_status1, NotNull())
-        .WillOnce(DoAll(SetArgPointee<1>(1 << 5), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_status1, NotNull())
+        .WillOnce(DoAll(SetArgPointee<2>(1 << 5), Return(mfrc522_ll_status_ok)));
     /* Phase 3: Activate Idle command back */
     MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_idle).WillOnce(Return(mfrc522_drv_status_ok));
     /* Phase 4: Computed value is read */
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_crc_result_lsb, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(crcLo), Return(mfrc522_ll_status_ok)));
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_crc_result_msb, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(crcHi), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_crc_result_lsb, NotNull())
+            .WillOnce(DoAll(SetArgPointee<2>(crcLo), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_crc_result_msb, NotNull())
+            .WillOnce(DoAll(SetArgPointee<2>(crcHi), Return(mfrc522_ll_status_ok)));
 
     u16 out;
     auto status = mfrc522_drv_crc_compute(&device, &out);
@@ -591,19 +993,17 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_generate_rand__TypicalCase__Success) {
     }
 
     /* Set expectations */
-    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_recv_mul);
     MOCK(mfrc522_drv_invoke_cmd);
-    IGNORE_REDUNDANT_LL_RECV_CALLS();
     InSequence s;
     /* 'Rand' command is invoked */
     MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_rand).WillOnce(Return(mfrc522_drv_status_ok));
     /* 'Mem' command is invoked */
     MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_mem).WillOnce(Return(mfrc522_drv_status_ok));
-    /* 25 bytes are read from the FIFO buffer */
-    for (const auto& i: returnedBytes) {
-        MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_fifo_data, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(i), Return(mfrc522_ll_status_ok)));
-    }
+    /* 25 bytes are read from the FIFO buffer at once */
+    MOCK_CALL(mfrc522_ll_recv_mul, _, mfrc522_reg_fifo_data, MFRC522_DRV_RAND_TOTAL, NotNull())
+            .WillOnce(DoAll(SetArrayArgument<3>(returnedBytes, returnedBytes + MFRC522_DRV_RAND_TOTAL),
+                            Return(mfrc522_ll_status_ok)));
 
     u8 out[10];
     auto status = mfrc522_drv_generate_rand(&device, &out[0], 10);
@@ -633,19 +1033,17 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_generate_rand__MoreThanTenBytesRequested_
     }
 
     /* Set expectations */
-    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_recv_mul);
     MOCK(mfrc522_drv_invoke_cmd);
-    IGNORE_REDUNDANT_LL_RECV_CALLS();
     InSequence s;
     /* 'Rand' command is invoked */
     MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_rand).WillOnce(Return(mfrc522_drv_status_ok));
     /* 'Mem' command is invoked */
     MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_mem).WillOnce(Return(mfrc522_drv_status_ok));
-    /* 25 bytes are read from the FIFO buffer */
-    for (const auto& i: returnedBytes) {
-        MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_fifo_data, NotNull())
-                .WillOnce(DoAll(SetArgPointee<1>(i), Return(mfrc522_ll_status_ok)));
-    }
+    /* 25 bytes are read from the FIFO buffer at once */
+    MOCK_CALL(mfrc522_ll_recv_mul, _, mfrc522_reg_fifo_data, MFRC522_DRV_RAND_TOTAL, NotNull())
+                .WillOnce(DoAll(SetArrayArgument<3>(returnedBytes, returnedBytes + MFRC522_DRV_RAND_TOTAL),
+                                Return(mfrc522_ll_status_ok)));
 
     u8 out[11] = {0x00};
     auto status = mfrc522_drv_generate_rand(&device, &out[0], 11); /* Request 11 bytes */
@@ -707,9 +1105,10 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_ext_itf_init__TypicalCase__Success)
 
     /* Set expectations */
     MOCK(mfrc522_ll_send);
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_tx_ask, 1, _).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_tx_control, 1, _).Times(2).WillRepeatedly(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_command, 1, _).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_tx_ask, 1, _).WillOnce(Return(mfrc522_ll_status_ok));
+    /* Both TX RF bits are set at once */
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_tx_control, 1, Pointee(0x03)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, _).WillOnce(Return(mfrc522_ll_status_ok));
 
     auto status = mfrc522_drv_ext_itf_init(&device, &itfConf);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
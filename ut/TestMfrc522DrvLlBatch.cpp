@@ -0,0 +1,408 @@
+#include "mfrc522_drv.h"
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+#include <utility>
+#include "common/TestCommon.h"
+#include "common/Mockable.h"
+
+using namespace testing;
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Test cases ------------------------ */
+/* ------------------------------------------------------------ */
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_tim_start__TypicalCase__WritesSentInBatches)
+{
+    auto conf = initDevice();
+
+    mfrc522_drv_tim_conf timerConf = MFRC522_DRV_TIM_CONF_DEFAULT;
+    timerConf.prescaler_type = mfrc522_drv_tim_psl_odd;
+    timerConf.prescaler = 0xFABC;
+    timerConf.reload_val = 0x0CA0;
+    timerConf.periodic = true;
+
+    /* Set expectations */
+    std::vector<std::pair<u8, u8>> xfers;
+    const u8 hostOwned[] = {0x80, 0x4D};
+    const u8 control[] = {0x10};
+    MOCK(mfrc522_ll_send);
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK_CALL(mfrc522_ll_send, _, _, _, _).Times(0);
+    MOCK_CALL(mfrc522_ll_recv, _, _, _).Times(0);
+    InSequence s;
+    /* Host-owned registers (TModeReg and DemodReg) are read up front at once */
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2)
+        .WillOnce(DoAll(FillRx(hostOwned), Return(mfrc522_ll_status_ok)));
+    /* Timer configuration is sent at once, followed by the read of volatile Control register */
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 6)
+        .WillOnce(DoAll(SaveXfers(&xfers), FillRx(control), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 1)
+        .WillOnce(DoAll(SaveXfers(&xfers), Return(mfrc522_ll_status_ok)));
+
+    auto status = mfrc522_drv_tim_start(&conf, &timerConf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+
+    const std::vector<std::pair<u8, u8>> expected = {
+        {mfrc522_reg_tim_prescaler, 0xBC},
+        {mfrc522_reg_tim_mode, 0x1A},
+        {mfrc522_reg_demod, 0x4D},
+        {mfrc522_reg_tim_reload_lo, 0xA0},
+        {mfrc522_reg_tim_reload_hi, 0x0C},
+        {mfrc522_reg_control, 0x50}
+    };
+    ASSERT_EQ(expected, xfers);
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_script_exec__RegisterCacheUsed__NoReads)
+{
+    auto conf = initDevice();
+    mfrc522_drv_reg_cache cache;
+    mfrc522_drv_reg_cache_attach(&conf, &cache);
+
+    const mfrc522_drv_script_entry script[] = {
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_mode, 1, MODE_CRC_PRESET),
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_mode, 1, MODE_CRC_MSBFIRST)
+    };
+
+    /* Set expectations */
+    const u8 mode[] = {0x3C};
+    MOCK(mfrc522_ll_transfer_multi);
+    InSequence s;
+    /* The register is read during the first run only */
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 1)
+        .WillOnce(DoAll(FillRx(mode), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 1).Times(2).WillRepeatedly(Return(mfrc522_ll_status_ok));
+
+    for (auto i = 0; i < 2; ++i) {
+        auto status = mfrc522_drv_script_exec(&conf, script, SIZE_ARRAY(script));
+        ASSERT_EQ(mfrc522_drv_status_ok, status);
+    }
+    ASSERT_EQ(0xBD, cache.regs[mfrc522_reg_mode]);
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_script_exec__LongScript__SplitIntoSeveralBatches)
+{
+    auto conf = initDevice();
+
+    /* Volatile registers are never merged */
+    std::vector<mfrc522_drv_script_entry> script(20, MFRC522_DRV_SCRIPT_WR(mfrc522_reg_fifo_data, 0xAB));
+
+    MOCK(mfrc522_ll_transfer_multi);
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 16).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 4).WillOnce(Return(mfrc522_ll_status_ok));
+
+    auto status = mfrc522_drv_script_exec(&conf, script.data(), script.size());
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_script_exec__SoftResetInTheMiddle__NotReordered)
+{
+    auto conf = initDevice();
+    mfrc522_drv_reg_cache cache;
+    mfrc522_drv_reg_cache_attach(&conf, &cache);
+
+    const mfrc522_drv_script_entry script[] = {
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_mode, 0x3D),
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_tx_control, 1, TXCONTROL_TX1RFEN),
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_command, mfrc522_reg_cmd_soft_reset),
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_mode, 0x3F),
+        MFRC522_DRV_SCRIPT_WR_MASKED(mfrc522_reg_tx_control, 1, TXCONTROL_TX2RFEN)
+    };
+
+    /* Set expectations */
+    std::vector<std::pair<u8, u8>> xfers;
+    const u8 txControlBefore[] = {0x84};
+    const u8 txControlAfter[] = {0x80}; /* Reset value */
+    MOCK(mfrc522_ll_transfer_multi);
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 1)
+        .WillOnce(DoAll(FillRx(txControlBefore), Return(mfrc522_ll_status_ok)));
+    /* Writes up to SoftReset are sent first, then host-owned registers are read again */
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 3)
+        .WillOnce(DoAll(SaveXfers(&xfers), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 1)
+        .WillOnce(DoAll(FillRx(txControlAfter), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2)
+        .WillOnce(DoAll(SaveXfers(&xfers), Return(mfrc522_ll_status_ok)));
+
+    auto status = mfrc522_drv_script_exec(&conf, script, SIZE_ARRAY(script));
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+
+    const std::vector<std::pair<u8, u8>> expected = {
+        {mfrc522_reg_mode, 0x3D},
+        {mfrc522_reg_tx_control, 0x85},
+        {mfrc522_reg_command, mfrc522_reg_cmd_soft_reset},
+        {mfrc522_reg_mode, 0x3F},
+        {mfrc522_reg_tx_control, 0x82}
+    };
+    ASSERT_EQ(expected, xfers);
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_script_exec__BatchError__LlErrorReturned)
+{
+    auto conf = initDevice();
+    const mfrc522_drv_script_entry script[] = {
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_reload_lo, 0x01),
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_reload_hi, 0x02)
+    };
+
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2).WillOnce(Return(mfrc522_ll_status_send_err));
+
+    auto status = mfrc522_drv_script_exec(&conf, script, SIZE_ARRAY(script));
+    ASSERT_EQ(mfrc522_drv_status_ll_err, status);
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_irq_states__TypicalCase__BothRegistersReadAtOnce)
+{
+    auto conf = initDevice();
+
+    /* Set expectations */
+    const u8 irqs[] = {0x30, 0x04};
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK_CALL(mfrc522_ll_recv, _, _, _).Times(0);
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2)
+        .WillOnce(DoAll(FillRx(irqs), Return(mfrc522_ll_status_ok)));
+
+    u16 states;
+    auto status = mfrc522_drv_irq_states(&conf, &states);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(0x0430, states);
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_read_regs__LongList__SplitIntoSeveralBatches)
+{
+    auto conf = initDevice();
+    std::vector<mfrc522_reg> regs(20, mfrc522_reg_status1);
+    std::vector<u8> out(regs.size());
+
+    /* Set expectations */
+    MOCK(mfrc522_ll_transfer_multi);
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 16).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 4).WillOnce(Return(mfrc522_ll_status_ok));
+
+    auto status = mfrc522_drv_read_regs(&conf, regs.data(), regs.size(), out.data());
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_transceive__TypicalCase__SetupAndTeardownSentAtOnce)
+{
+    auto device = initDevice();
+
+    /* Populate configuration struct */
+    u8 tx[] = {0x93, 0x20};
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    transceiveConf.tx_data = &tx[0];
+    transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
+    transceiveConf.rx_data = nullptr;
+    transceiveConf.rx_data_sz = 0;
+    transceiveConf.command = mfrc522_reg_cmd_transceive;
+
+    /* Set expectations */
+    std::vector<std::pair<u8, u8>> xfers;
+    const u8 regs[] = {0x20, 0x07}; /* CommandReg with RcvOff bit and BitFramingReg with TxLastBits */
+    MOCK(mfrc522_ll_send);
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK(mfrc522_drv_irq_states);
+    IGNORE_REDUNDANT_LL_RECV_CALLS();
+    MOCK_CALL(mfrc522_ll_send, _, _, _, _).Times(0);
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2).WillOnce(DoAll(FillRx(regs), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 6)
+        .WillOnce(DoAll(SaveXfers(&xfers), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull())
+        .WillOnce(DoAll(SetArgPointee<1>(1 << 5), Return(mfrc522_drv_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2)
+        .WillOnce(DoAll(SaveXfers(&xfers), Return(mfrc522_ll_status_ok)));
+
+    auto status = mfrc522_drv_transceive(&device, &transceiveConf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+
+    const std::vector<std::pair<u8, u8>> expected = {
+        {mfrc522_reg_com_irq, 0x7F},
+        {mfrc522_reg_div_irq, 0x14},
+        {mfrc522_reg_fifo_level, 0x80},
+        {mfrc522_reg_fifo_data, 0x20},
+        {mfrc522_reg_command, 0x20 | mfrc522_reg_cmd_transceive},
+        {mfrc522_reg_bit_framing, 0x80}, /* Framing is taken from transceive configuration */
+        {mfrc522_reg_bit_framing, 0x07}, /* Previous framing is restored */
+        {mfrc522_reg_command, 0x20 | mfrc522_reg_cmd_idle}
+    };
+    ASSERT_EQ(expected, xfers);
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_transceive__RxData__LastBitsAndLevelReadAtOnce)
+{
+    auto device = initDevice();
+
+    /* Populate configuration struct */
+    u8 tx = 0x26;
+    u8 rx[2];
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    transceiveConf.tx_data = &tx;
+    transceiveConf.tx_data_sz = 1;
+    transceiveConf.rx_data = &rx[0];
+    transceiveConf.rx_data_sz = SIZE_ARRAY(rx);
+    transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.tx_last_bits = 7;
+
+    /* Set expectations */
+    const u8 regs[] = {0x20, 0x00}; /* CommandReg with RcvOff bit and BitFramingReg */
+    const u8 rxState[] = {0x10, 0x02}; /* ControlReg with no incomplete byte and FIFOLevelReg */
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_recv_mul);
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK(mfrc522_drv_irq_states);
+    IGNORE_REDUNDANT_LL_RECV_CALLS();
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2).WillOnce(DoAll(FillRx(regs), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 6).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull())
+        .WillOnce(DoAll(SetArgPointee<1>(1 << 5), Return(mfrc522_drv_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2)
+        .WillOnce(DoAll(FillRx(rxState), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv_mul, _, mfrc522_reg_fifo_data, SIZE_ARRAY(rx), NotNull())
+        .WillOnce(DoAll(SetArrayArgument<3>(std::begin(rxState), std::end(rxState)), Return(mfrc522_ll_status_ok)));
+
+    auto status = mfrc522_drv_transceive(&device, &transceiveConf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(SIZE_ARRAY(rx), transceiveConf.rx_len);
+    ASSERT_EQ(0, transceiveConf.rx_last_bits);
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_transceive__TimerExpired__TimeoutReturnedAtOnce)
+{
+    auto device = initDevice();
+
+    /* Populate configuration struct */
+    u8 tx = 0x26;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    transceiveConf.tx_data = &tx;
+    transceiveConf.tx_data_sz = 1;
+    transceiveConf.rx_data = nullptr;
+    transceiveConf.rx_data_sz = 0;
+    transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = 2;
+
+    /* Set expectations */
+    std::vector<std::pair<u8, u8>> xfers;
+    const u8 hostOwned[] = {0x00, 0x00}; /* TModeReg and DemodReg */
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK(mfrc522_drv_irq_states);
+    IGNORE_REDUNDANT_LL_RECV_CALLS();
+    InSequence s;
+    /* The timer is configured to start at the end of transmission. It is not started immediately */
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2)
+        .WillOnce(DoAll(FillRx(hostOwned), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 5)
+        .WillOnce(DoAll(SaveXfers(&xfers), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 6).WillOnce(Return(mfrc522_ll_status_ok));
+    /* TimerIRq ends the command without further polling */
+    MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull())
+        .WillOnce(DoAll(SetArgPointee<1>(1 << 0), Return(mfrc522_drv_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2).WillOnce(Return(mfrc522_ll_status_ok));
+
+    auto status = mfrc522_drv_transceive(&device, &transceiveConf);
+    ASSERT_EQ(mfrc522_drv_status_transceive_timeout, status);
+
+    const std::vector<std::pair<u8, u8>> expected = {
+        {mfrc522_reg_tim_prescaler, 0x9E},
+        {mfrc522_reg_tim_mode, 0x86},
+        {mfrc522_reg_demod, 0x10},
+        {mfrc522_reg_tim_reload_lo, 0x08},
+        {mfrc522_reg_tim_reload_hi, 0x00}
+    };
+    ASSERT_EQ(expected, xfers);
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_write_async__TypicalCase__CompletedByLowLevel)
+{
+    auto device = initDevice();
+    mfrc522_drv_reg_cache cache;
+    mfrc522_drv_reg_cache_attach(&device, &cache);
+    cache.regs[mfrc522_reg_mode] = 0x3F; /* Value known before the write */
+    cache.valid |= 1ULL << mfrc522_reg_mode;
+
+    /* Set expectations */
+    mfrc522_ll_complete complete = nullptr;
+    void* completeArg = nullptr;
+    MOCK(mfrc522_ll_submit);
+    MOCK_CALL(mfrc522_ll_submit, _, NotNull(), 1, NotNull(), NotNull())
+        .WillOnce(DoAll(SaveArg<3>(&complete), SaveArg<4>(&completeArg), Return(mfrc522_ll_status_ok)));
+
+    struct Result
+    {
+        bool called = false;
+        mfrc522_drv_status status = mfrc522_drv_status_nok;
+    } result;
+    auto cb = [](mfrc522_drv_status status, void* arg) {
+        auto res = static_cast<Result*>(arg);
+        res->called = true;
+        res->status = status;
+    };
+
+    const u8 payload = 0x3D;
+    mfrc522_drv_async_req req;
+    auto status = mfrc522_drv_write_async(&device, &req, mfrc522_reg_mode, 1, &payload, cb, &result);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+
+    /* Nothing is done until low-level layer completes the transfer. The register is no longer shadowed */
+    ASSERT_FALSE(result.called);
+    ASSERT_FALSE(cache.valid & (1ULL << mfrc522_reg_mode));
+
+    /* Completion context does not touch the cache */
+    complete(completeArg, mfrc522_ll_status_ok);
+    ASSERT_TRUE(result.called);
+    ASSERT_EQ(mfrc522_drv_status_ok, result.status);
+    ASSERT_FALSE(cache.valid & (1ULL << mfrc522_reg_mode));
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_read_async__LowLevelError__ErrorPassedToCallback)
+{
+    auto device = initDevice();
+
+    mfrc522_ll_complete complete = nullptr;
+    void* completeArg = nullptr;
+    MOCK(mfrc522_ll_submit);
+    MOCK_CALL(mfrc522_ll_submit, _, NotNull(), 1, NotNull(), NotNull())
+        .WillOnce(DoAll(SaveArg<3>(&complete), SaveArg<4>(&completeArg), Return(mfrc522_ll_status_ok)));
+
+    mfrc522_drv_status result = mfrc522_drv_status_nok;
+    auto cb = [](mfrc522_drv_status status, void* arg) { *static_cast<mfrc522_drv_status*>(arg) = status; };
+
+    u8 payload;
+    mfrc522_drv_async_req req;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_read_async(&device, &req, mfrc522_reg_status1, &payload, cb, &result));
+    complete(completeArg, mfrc522_ll_status_recv_err);
+    ASSERT_EQ(mfrc522_drv_status_ll_err, result);
+}
+
+TEST(TestMfrc522DrvLlBatch, mfrc522_drv_read_mul_async__LowLevelBusy__CallbackNotInvoked)
+{
+    auto device = initDevice();
+
+    MOCK(mfrc522_ll_submit);
+    MOCK_CALL(mfrc522_ll_submit, _, NotNull(), 1, NotNull(), NotNull()).WillOnce(Return(mfrc522_ll_status_busy));
+
+    bool called = false;
+    auto cb = [](mfrc522_drv_status status, void* arg) {
+        static_cast<void>(status);
+        *static_cast<bool*>(arg) = true;
+    };
+
+    u8 payload[4];
+    mfrc522_drv_async_req req;
+    auto status = mfrc522_drv_read_mul_async(&device, &req, mfrc522_reg_fifo_data, SIZE_ARRAY(payload), payload, cb,
+                                             &called);
+    ASSERT_EQ(mfrc522_drv_status_ll_err, status);
+    ASSERT_FALSE(called);
+}
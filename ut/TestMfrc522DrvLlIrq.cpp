@@ -0,0 +1,215 @@
+#include "mfrc522_drv.h"
+#include "mfrc522_conf.h"
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+#include <utility>
+#include "common/TestCommon.h"
+#include "common/Mockable.h"
+
+using namespace testing;
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+/* Transceive configuration without RX data */
+static mfrc522_drv_transceive_conf transceiveConf(u8* tx, size txSize)
+{
+    mfrc522_drv_transceive_conf conf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    conf.tx_data = tx;
+    conf.tx_data_sz = txSize;
+    conf.rx_data = nullptr;
+    conf.rx_data_sz = 0;
+    conf.command = mfrc522_reg_cmd_transceive;
+    return conf;
+}
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Test cases ------------------------ */
+/* ------------------------------------------------------------ */
+
+TEST(TestMfrc522DrvLlIrq, mfrc522_drv_transceive__TypicalCase__IrqStatesReadOnce)
+{
+    auto device = initDevice();
+    u8 tx[] = {0x93, 0x20};
+    auto trConf = transceiveConf(tx, SIZE_ARRAY(tx));
+
+    /* Set expectations */
+    std::vector<std::pair<u8, u8>> xfers;
+    const u8 regs[] = {0x20, 0x07, 0x81}; /* CommandReg, BitFramingReg and ComIEnReg with IRqInv and TimerIEn bits */
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK(mfrc522_ll_wait_irq);
+    MOCK(mfrc522_drv_irq_states);
+    IGNORE_REDUNDANT_LL_RECV_CALLS();
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 3).WillOnce(DoAll(FillRx(regs), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 7)
+        .WillOnce(DoAll(SaveXfers(&xfers), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_wait_irq, _, MFRC522_CONF_IRQ_WAIT_TIMEOUT).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull())
+        .WillOnce(DoAll(SetArgPointee<1>(1 << 5), Return(mfrc522_drv_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 3)
+        .WillOnce(DoAll(SaveXfers(&xfers), Return(mfrc522_ll_status_ok)));
+
+    auto status = mfrc522_drv_transceive(&device, &trConf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+
+    const std::vector<std::pair<u8, u8>> expected = {
+        {mfrc522_reg_com_irq, 0x7F},
+        {mfrc522_reg_div_irq, 0x14},
+        {mfrc522_reg_com_irq_en, 0xB2},
+        {mfrc522_reg_fifo_level, 0x80},
+        {mfrc522_reg_fifo_data, 0x20},
+        {mfrc522_reg_command, 0x20 | mfrc522_reg_cmd_transceive},
+        {mfrc522_reg_bit_framing, 0x80}, /* Framing is taken from transceive configuration */
+        {mfrc522_reg_bit_framing, 0x07}, /* Previous framing is restored */
+        {mfrc522_reg_command, 0x20 | mfrc522_reg_cmd_idle},
+        {mfrc522_reg_com_irq_en, 0x81}
+    };
+    ASSERT_EQ(expected, xfers);
+}
+
+TEST(TestMfrc522DrvLlIrq, mfrc522_drv_transceive__PinNotActive__TimeoutReturned)
+{
+    auto device = initDevice();
+    u8 tx = 0x26;
+    auto trConf = transceiveConf(&tx, 1);
+
+    /* Set expectations */
+    std::vector<std::pair<u8, u8>> xfers;
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK(mfrc522_ll_wait_irq);
+    MOCK(mfrc522_drv_irq_states);
+    IGNORE_REDUNDANT_LL_RECV_CALLS();
+    MOCK_CALL(mfrc522_drv_irq_states, _, _).Times(0);
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 3).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 7).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_wait_irq, _, _).WillOnce(Return(mfrc522_ll_status_timeout));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 3)
+        .WillOnce(DoAll(SaveXfers(&xfers), Return(mfrc522_ll_status_ok)));
+
+    auto status = mfrc522_drv_transceive(&device, &trConf);
+    ASSERT_EQ(mfrc522_drv_status_transceive_timeout, status);
+
+    /* Interrupts routed to IRQ pin are restored even if there was no response */
+    ASSERT_EQ(3U, xfers.size());
+    const std::pair<u8, u8> restored = {mfrc522_reg_com_irq_en, 0x00};
+    ASSERT_EQ(restored, xfers.back());
+}
+
+TEST(TestMfrc522DrvLlIrq, mfrc522_drv_transceive__SpuriousWakeUp__WaitResumed)
+{
+    auto device = initDevice();
+    u8 tx[] = {0x93, 0x20};
+    auto trConf = transceiveConf(tx, SIZE_ARRAY(tx));
+
+    /* Set expectations */
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK(mfrc522_ll_wait_irq);
+    MOCK(mfrc522_drv_irq_states);
+    IGNORE_REDUNDANT_LL_RECV_CALLS();
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 3).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 7).WillOnce(Return(mfrc522_ll_status_ok));
+    /* The pin is active, but no completion interrupt is pending yet */
+    MOCK_CALL(mfrc522_ll_wait_irq, _, _).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull())
+        .WillOnce(DoAll(SetArgPointee<1>(0), Return(mfrc522_drv_status_ok)));
+    MOCK_CALL(mfrc522_ll_wait_irq, _, _).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull())
+        .WillOnce(DoAll(SetArgPointee<1>(1 << 5), Return(mfrc522_drv_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 3).WillOnce(Return(mfrc522_ll_status_ok));
+
+    auto status = mfrc522_drv_transceive(&device, &trConf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+}
+
+TEST(TestMfrc522DrvLlIrq, mfrc522_drv_transceive__TimeoutSet__TimerIrqRoutedToPin)
+{
+    auto device = initDevice();
+    u8 tx = 0x26;
+    auto trConf = transceiveConf(&tx, 1);
+    trConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
+
+    /* Set expectations */
+    std::vector<std::pair<u8, u8>> xfers;
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK(mfrc522_ll_wait_irq);
+    MOCK(mfrc522_drv_irq_states);
+    IGNORE_REDUNDANT_LL_RECV_CALLS();
+    InSequence s;
+    /* Timer configuration */
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 2).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 5).WillOnce(Return(mfrc522_ll_status_ok));
+    /* Transceive */
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 3).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 7)
+        .WillOnce(DoAll(SaveXfers(&xfers), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_wait_irq, _, _).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull())
+        .WillOnce(DoAll(SetArgPointee<1>(1 << 0), Return(mfrc522_drv_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 3).WillOnce(Return(mfrc522_ll_status_ok));
+
+    auto status = mfrc522_drv_transceive(&device, &trConf);
+    ASSERT_EQ(mfrc522_drv_status_transceive_timeout, status);
+
+    const std::pair<u8, u8> irqEn = {mfrc522_reg_com_irq_en, 0x33};
+    ASSERT_EQ(irqEn, xfers[2]);
+}
+
+TEST(TestMfrc522DrvLlIrq, mfrc522_drv_transceive__ErrorIrq__ErrorReturned)
+{
+    auto device = initDevice();
+    u8 tx = 0x26;
+    auto trConf = transceiveConf(&tx, 1);
+
+    /* Set expectations */
+    MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK(mfrc522_ll_wait_irq);
+    MOCK(mfrc522_drv_irq_states);
+    IGNORE_REDUNDANT_LL_RECV_CALLS();
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, _, _).Times(3).WillRepeatedly(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_wait_irq, _, _).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull())
+        .WillOnce(DoAll(SetArgPointee<1>(1 << 1), Return(mfrc522_drv_status_ok)));
+
+    auto status = mfrc522_drv_transceive(&device, &trConf);
+    ASSERT_EQ(mfrc522_drv_status_transceive_err, status);
+}
+
+TEST(TestMfrc522DrvLlIrq, mfrc522_drv_transceive__WaitError__LlErrorReturned)
+{
+    auto device = initDevice();
+    u8 tx = 0x26;
+    auto trConf = transceiveConf(&tx, 1);
+
+    /* Set expectations */
+    std::vector<std::pair<u8, u8>> xfers;
+    const u8 regs[] = {0x20, 0x07, 0x81}; /* CommandReg, BitFramingReg and ComIEnReg */
+    MOCK(mfrc522_ll_transfer_multi);
+    MOCK(mfrc522_ll_wait_irq);
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 3).WillOnce(DoAll(FillRx(regs), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), _).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_wait_irq, _, _).WillOnce(Return(mfrc522_ll_status_recv_err));
+    MOCK_CALL(mfrc522_ll_transfer_multi, _, NotNull(), 3)
+        .WillOnce(DoAll(SaveXfers(&xfers), Return(mfrc522_ll_status_ok)));
+
+    auto status = mfrc522_drv_transceive(&device, &trConf);
+    ASSERT_EQ(mfrc522_drv_status_ll_err, status);
+
+    /* The command is terminated and interrupts routed to IRQ pin are restored anyway */
+    const std::vector<std::pair<u8, u8>> expected = {
+        {mfrc522_reg_bit_framing, 0x07},
+        {mfrc522_reg_command, 0x20 | mfrc522_reg_cmd_idle},
+        {mfrc522_reg_com_irq_en, 0x81}
+    };
+    ASSERT_EQ(expected, xfers);
+}
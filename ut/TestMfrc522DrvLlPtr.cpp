@@ -1,93 +1,323 @@
 #include "mfrc522_drv.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 
 /* ------------------------------------------------------------ */
 /* --------------------- Private functions -------------------- */
 /* ------------------------------------------------------------ */
 
+/* Context passed to the last send or asynchronous transfer call */
+static void* lastCtx = nullptr;
+
 /* Dummy implementation of low-level functions */
-static mfrc522_ll_status dummyInit()
+static mfrc522_ll_status dummyInit(void* ctx)
 {
+    static_cast<void>(ctx);
     return mfrc522_ll_status_ok;
 }
 
-static mfrc522_ll_status dummySend(u8 addr, size bytes, const u8* payload) // NOLINT(readability-non-const-parameter)
+static mfrc522_ll_status dummySend(void* ctx, u8 addr, size bytes, const u8* payload)
 {
+    lastCtx = ctx;
     static_cast<void>(addr);
     static_cast<void>(bytes);
     static_cast<void>(payload);
     return mfrc522_ll_status_ok;
 }
 
-static mfrc522_ll_status dummyRecv(u8 addr, u8* payload) // NOLINT(readability-non-const-parameter)
+static mfrc522_ll_status dummyRecv(void* ctx, u8 addr, u8* payload)
 {
+    static_cast<void>(ctx);
     static_cast<void>(addr);
-    static_cast<void>(payload);
+    *payload = 0x00;
+    return mfrc522_ll_status_ok;
+}
+
+static mfrc522_ll_status dummyRecvMul(void* ctx, u8 addr, size bytes, u8* payload)
+{
+    static_cast<void>(ctx);
+    static_cast<void>(addr);
+    std::fill(payload, payload + bytes, 0x00);
     return mfrc522_ll_status_ok;
 }
 
-static void dummyDelay(u32 period)
+static void dummyDelay(void* ctx, u32 period)
 {
+    static_cast<void>(ctx);
     static_cast<void>(period);
 }
 
+/* Number of calls to scatter-gather transfer function */
+static size transferMultiCalls = 0;
+
+static mfrc522_ll_status dummyTransferMulti(void* ctx, const mfrc522_ll_xfer* xfers, size num)
+{
+    static_cast<void>(ctx);
+    static_cast<void>(xfers);
+    static_cast<void>(num);
+    ++transferMultiCalls;
+    return mfrc522_ll_status_ok;
+}
+
+/* Asynchronous transfer function completing the transfers at once */
+static mfrc522_ll_status dummySubmit(void* ctx, const mfrc522_ll_xfer* xfers, size num, mfrc522_ll_complete complete,
+                                     void* arg)
+{
+    lastCtx = ctx;
+    static_cast<void>(xfers);
+    static_cast<void>(num);
+    complete(arg, mfrc522_ll_status_ok);
+    return mfrc522_ll_status_ok;
+}
+
+/* Number of calls to IRQ wait function */
+static size waitIrqCalls = 0;
+
+/* IRQ wait function reporting that the pin did not become active */
+static mfrc522_ll_status dummyWaitIrq(void* ctx, u32 timeout)
+{
+    lastCtx = ctx;
+    static_cast<void>(timeout);
+    ++waitIrqCalls;
+    return mfrc522_ll_status_timeout;
+}
+
+/* Table with all mandatory operations set */
+static mfrc522_ll_ops dummyOps()
+{
+    mfrc522_ll_ops ops;
+    ops.version = MFRC522_LL_OPS_VERSION;
+    ops.init = dummyInit;
+    ops.send = dummySend;
+    ops.recv = dummyRecv;
+    ops.recv_mul = dummyRecvMul;
+    ops.delay = dummyDelay;
+    ops.transfer_multi = nullptr;
+    ops.submit = nullptr;
+    ops.wait_irq = nullptr;
+    ops.now = nullptr;
+    return ops;
+}
+
 /* ------------------------------------------------------------ */
 /* ------------------------ Test cases ------------------------ */
 /* ------------------------------------------------------------ */
 
 TEST(TestMfrc522DrvLlPtr, mfrc522_drv_init__NullCases)
 {
-    /* Stage 1: Pass NULL as low-level init */
+    /* Stage 1: Pass NULL as low-level operations table */
     mfrc522_drv_conf conf;
-    conf.ll_init = nullptr;
-    conf.ll_recv = dummyRecv;
-    conf.ll_send = dummySend;
-    conf.ll_delay = dummyDelay;
+    conf.ll_ops = nullptr;
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_init(&conf));
+
+    /* Stage 2: Pass NULL as low-level init */
+    auto ops = dummyOps();
+    conf.ll_ops = &ops;
+    conf.ll_ctx = nullptr;
+    ops.init = nullptr;
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_init(&conf));
+
+    /* Stage 3: Pass NULL as low-level send */
+    ops = dummyOps();
+    ops.send = nullptr;
     ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_init(&conf));
 
-    /* Stage 2: Pass NULL as low-level send */
-    conf.ll_recv = dummyRecv;
-    conf.ll_send = nullptr;
-    conf.ll_delay = dummyDelay;
+    /* Stage 4: Pass NULL as low-level receive */
+    ops = dummyOps();
+    ops.recv = nullptr;
     ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_init(&conf));
 
-    /* Stage 3: Pass NULL as low-level receive */
-    conf.ll_recv = nullptr;
-    conf.ll_send = dummySend;
-    conf.ll_delay = dummyDelay;
+    /* Stage 5: Pass NULL as low-level delay */
+    ops = dummyOps();
+    ops.delay = nullptr;
     ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_init(&conf));
 
-    /* Stage 4: Pass NULL as low-level delay */
-    conf.ll_recv = dummyRecv;
-    conf.ll_send = dummySend;
-    conf.ll_delay = nullptr;
+    /* Stage 6: Pass NULL as low-level multiple-byte receive */
+    ops = dummyOps();
+    ops.recv_mul = nullptr;
     ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_init(&conf));
 }
 
+TEST(TestMfrc522DrvLlPtr, mfrc522_drv_init__UnsupportedOpsVersion__Failure)
+{
+    auto ops = dummyOps();
+    ops.version = MFRC522_LL_OPS_VERSION + 1;
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &ops;
+    conf.ll_ctx = nullptr;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, mfrc522_drv_init(&conf));
+}
+
 TEST(TestMfrc522DrvLlPtr, mfrc522_drv_write__Success)
 {
     /* Dummy configuration */
+    auto ops = dummyOps();
     mfrc522_drv_conf conf;
-    conf.ll_init = dummyInit;
-    conf.ll_recv = dummyRecv;
-    conf.ll_send = dummySend;
-    conf.ll_delay = dummyDelay;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &ops;
+    conf.ll_ctx = nullptr;
 
     u8 dummyByte = 0xAB;
     auto status = mfrc522_drv_write(&conf, mfrc522_reg_fifo_data, 1, &dummyByte);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
 }
 
+TEST(TestMfrc522DrvLlPtr, mfrc522_drv_read_mul__Success)
+{
+    /* Dummy configuration */
+    auto ops = dummyOps();
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &ops;
+    conf.ll_ctx = nullptr;
+
+    u8 buffer[4];
+    auto status = mfrc522_drv_read_mul(&conf, mfrc522_reg_fifo_data, sizeof(buffer), &buffer[0]);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+}
+
 TEST(TestMfrc522DrvLlPtr, mfrc522_drv_read__Success)
 {
     /* Dummy configuration */
+    auto ops = dummyOps();
     mfrc522_drv_conf conf;
-    conf.ll_init = dummyInit;
-    conf.ll_recv = dummyRecv;
-    conf.ll_send = dummySend;
-    conf.ll_delay = dummyDelay;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &ops;
+    conf.ll_ctx = nullptr;
 
     u8 buffer;
     auto status = mfrc522_drv_read(&conf, mfrc522_reg_fifo_data, &buffer);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
 }
+
+TEST(TestMfrc522DrvLlPtr, mfrc522_drv_script_exec__TransferMultiMissing__SingleCallsUsed)
+{
+    auto ops = dummyOps();
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &ops;
+    conf.ll_ctx = nullptr;
+
+    const mfrc522_drv_script_entry script[] = {
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_reload_lo, 0x01),
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_reload_hi, 0x02)
+    };
+    transferMultiCalls = 0;
+    auto status = mfrc522_drv_script_exec(&conf, script, SIZE_ARRAY(script));
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(0U, transferMultiCalls);
+}
+
+TEST(TestMfrc522DrvLlPtr, mfrc522_drv_script_exec__TransferMultiPresent__SingleBatchSent)
+{
+    auto ops = dummyOps();
+    ops.transfer_multi = dummyTransferMulti;
+    ops.send = nullptr; /* Must not be used */
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &ops;
+    conf.ll_ctx = nullptr;
+
+    const mfrc522_drv_script_entry script[] = {
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_reload_lo, 0x01),
+        MFRC522_DRV_SCRIPT_WR(mfrc522_reg_tim_reload_hi, 0x02)
+    };
+    transferMultiCalls = 0;
+    auto status = mfrc522_drv_script_exec(&conf, script, SIZE_ARRAY(script));
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(1U, transferMultiCalls);
+}
+
+TEST(TestMfrc522DrvLlPtr, mfrc522_drv_init__ZeroOpsVersion__Failure)
+{
+    /* Version is never zero, thus a table with the field left unset is rejected */
+    auto ops = dummyOps();
+    ops.version = 0;
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &ops;
+    conf.ll_ctx = nullptr;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, mfrc522_drv_init(&conf));
+}
+
+TEST(TestMfrc522DrvLlPtr, mfrc522_drv_write__TwoDevices__OwnContextPassed)
+{
+    auto ops = dummyOps();
+    int devs[2]; /* Any objects to point at */
+    mfrc522_drv_conf confs[2];
+    for (size i = 0; i < SIZE_ARRAY(confs); ++i) {
+        mfrc522_drv_conf_init(&confs[i]);
+        confs[i].ll_ops = &ops;
+        confs[i].ll_ctx = &devs[i];
+    }
+
+    u8 dummyByte = 0xAB;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write(&confs[1], mfrc522_reg_fifo_data, 1, &dummyByte));
+    ASSERT_EQ(&devs[1], lastCtx);
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write(&confs[0], mfrc522_reg_fifo_data, 1, &dummyByte));
+    ASSERT_EQ(&devs[0], lastCtx);
+}
+
+TEST(TestMfrc522DrvLlPtr, mfrc522_drv_write_async__SubmitMissing__CompletedAtOnce)
+{
+    auto ops = dummyOps();
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &ops;
+    conf.ll_ctx = nullptr;
+
+    mfrc522_drv_status result = mfrc522_drv_status_nok;
+    auto cb = [](mfrc522_drv_status status, void* arg) { *static_cast<mfrc522_drv_status*>(arg) = status; };
+
+    u8 payload = 0xAB;
+    mfrc522_drv_async_req req;
+    ASSERT_EQ(mfrc522_drv_status_ok,
+              mfrc522_drv_write_async(&conf, &req, mfrc522_reg_fifo_data, 1, &payload, cb, &result));
+    ASSERT_EQ(mfrc522_drv_status_ok, result);
+}
+
+TEST(TestMfrc522DrvLlPtr, mfrc522_drv_write_async__SubmitPresent__ContextPassed)
+{
+    auto ops = dummyOps();
+    ops.submit = dummySubmit;
+    ops.send = nullptr; /* Must not be used */
+    int dev = 0; /* Any object to point at */
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &ops;
+    conf.ll_ctx = &dev;
+
+    mfrc522_drv_status result = mfrc522_drv_status_nok;
+    auto cb = [](mfrc522_drv_status status, void* arg) { *static_cast<mfrc522_drv_status*>(arg) = status; };
+
+    u8 payload = 0xAB;
+    mfrc522_drv_async_req req;
+    ASSERT_EQ(mfrc522_drv_status_ok,
+              mfrc522_drv_write_async(&conf, &req, mfrc522_reg_fifo_data, 1, &payload, cb, &result));
+    ASSERT_EQ(mfrc522_drv_status_ok, result);
+    ASSERT_EQ(&dev, lastCtx);
+}
+
+TEST(TestMfrc522DrvLlPtr, mfrc522_drv_transceive__WaitIrqPresent__PinAwaited)
+{
+    auto ops = dummyOps();
+    ops.wait_irq = dummyWaitIrq;
+    int dev = 0; /* Any object to point at */
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &ops;
+    conf.ll_ctx = &dev;
+
+    u8 tx = 0x26;
+    mfrc522_drv_transceive_conf trConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    trConf.tx_data = &tx;
+    trConf.tx_data_sz = 1;
+    trConf.rx_data = nullptr;
+    trConf.rx_data_sz = 0;
+    trConf.command = mfrc522_reg_cmd_transceive;
+    waitIrqCalls = 0;
+    ASSERT_EQ(mfrc522_drv_status_transceive_timeout, mfrc522_drv_transceive(&conf, &trConf));
+    ASSERT_EQ(1U, waitIrqCalls);
+    ASSERT_EQ(&dev, lastCtx);
+}
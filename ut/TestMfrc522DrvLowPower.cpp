@@ -0,0 +1,254 @@
+#include "mfrc522_drv.h"
+#include "mfrc522_conf.h"
+#include <gtest/gtest.h>
+#include "common/SimulatedChip.h"
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Private classes -------------------- */
+/* ------------------------------------------------------------ */
+
+/*
+ * MFRC522 with simulated time and soft power-down. The device needs some time to wake up, a card entering RF field
+ * answers REQA and WUPA, otherwise the timer expires after frame waiting time. Time spent in power-down is accumulated.
+ */
+class PoweredChip : public SimulatedChip
+{
+public:
+    PoweredChip()
+    {
+        busCost = 2;
+    }
+
+    /* Total time spent in power-down, including the current period */
+    u32 downTime() const
+    {
+        return poweredDown ? (downTotal + (clock - downSince)) : downTotal;
+    }
+
+    u32 wakeLatency = 300; /* Time needed by the oscillator to become stable */
+    u32 responseLatency = 100; /* Time after which a card answers */
+    u32 fwt = 1000; /* Frame waiting time measured by the timer */
+    u32 cardArrives = UINT32_MAX; /* Time at which a card enters RF field */
+    bool poweredDown = false;
+    size frames = 0; /* Number of frames sent */
+    size accessesWhileDown = 0; /* Number of accesses to registers other than CommandReg during power-down */
+
+private:
+    void access(u8 addr) override
+    {
+        if ((poweredDown || !awake()) && mfrc522_reg_command != addr) {
+            ++accessesWhileDown;
+        }
+    }
+
+    bool awake() const
+    {
+        return static_cast<i32>(clock - readyAt) >= 0;
+    }
+
+    bool cardPresent() const
+    {
+        return clock >= cardArrives;
+    }
+
+    void write(u8 addr, u8 val) override
+    {
+        if (mfrc522_reg_command == addr) {
+            if ((val & 0x10) && !poweredDown) {
+                poweredDown = true;
+                downSince = clock;
+            } else if (!(val & 0x10) && poweredDown) {
+                poweredDown = false;
+                downTotal += clock - downSince;
+                readyAt = clock + wakeLatency;
+            }
+            pending = false;
+        }
+        SimulatedChip::write(addr, val);
+    }
+
+    u8 read(u8 addr) override
+    {
+        if (mfrc522_reg_command == addr && !awake()) {
+            /* PowerDown bit is read as set until wake-up procedure is complete */
+            return regs[addr] | 0x10;
+        }
+        if (mfrc522_reg_com_irq == addr) {
+            update();
+        }
+        return SimulatedChip::read(addr);
+    }
+
+    void transmit() override
+    {
+        bool request = (1 == fifo.size()) &&
+                       (mfrc522_picc_cmd_reqa == fifo.front() || mfrc522_picc_cmd_wupa == fifo.front()) &&
+                       (0x07 == (regs[mfrc522_reg_bit_framing] & 0x07));
+        fifo.clear();
+        ++frames;
+        pending = true;
+        answered = request && awake() && cardPresent();
+        sentAt = clock;
+    }
+
+    void update()
+    {
+        if (!pending) {
+            return;
+        }
+        if (answered && clock - sentAt >= responseLatency) {
+            pending = false;
+            fifo.assign({0x04, 0x00});
+            regs[mfrc522_reg_com_irq] |= 1 << mfrc522_reg_irq_rx;
+        } else if (!answered && clock - sentAt >= fwt) {
+            pending = false;
+            regs[mfrc522_reg_com_irq] |= 1 << mfrc522_reg_irq_timer;
+        }
+    }
+
+    u32 readyAt = 0;
+    u32 downSince = 0;
+    u32 downTotal = 0;
+    bool pending = false;
+    bool answered = false;
+    u32 sentAt = 0;
+};
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+static mfrc522_drv_conf initDriver(PoweredChip* chip)
+{
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = SimulatedChip::ops();
+    conf.ll_ctx = chip;
+    conf.atqa_verify_fn = nullptr;
+    EXPECT_EQ(mfrc522_drv_status_ok, mfrc522_drv_init(&conf));
+    return conf;
+}
+
+/* Duty cycle of 100 ms in power-down and 2 ms with RF field on before a probe */
+static mfrc522_drv_lpcd_conf lpcdConf(u32 maxCycles)
+{
+    mfrc522_drv_lpcd_conf lpcdConf;
+    lpcdConf.frame = mfrc522_picc_cmd_wupa;
+    lpcdConf.sleep_period = 100000;
+    lpcdConf.settle_time = 2000;
+    lpcdConf.max_cycles = maxCycles;
+    return lpcdConf;
+}
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Test cases ------------------------ */
+/* ------------------------------------------------------------ */
+
+TEST(TestMfrc522DrvLowPower, mfrc522_drv_lpcd__NullCases)
+{
+    PoweredChip chip;
+    auto conf = initDriver(&chip);
+    auto lpConf = lpcdConf(1);
+    u16 atqa;
+
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_power_down(nullptr, true));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_lpcd(nullptr, &lpConf, &atqa));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_lpcd(&conf, nullptr, &atqa));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_lpcd(&conf, &lpConf, nullptr));
+}
+
+TEST(TestMfrc522DrvLowPower, mfrc522_drv_lpcd__InvalidFrame__Failure)
+{
+    PoweredChip chip;
+    auto conf = initDriver(&chip);
+    auto lpConf = lpcdConf(1);
+    lpConf.frame = mfrc522_picc_cmd_halt;
+    u16 atqa;
+
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_lpcd(&conf, &lpConf, &atqa));
+    ASSERT_EQ(0U, chip.frames);
+    ASSERT_FALSE(chip.poweredDown);
+}
+
+TEST(TestMfrc522DrvLowPower, mfrc522_drv_power_down__Resume__ReturnsWhenDeviceIsReady)
+{
+    PoweredChip chip;
+    auto conf = initDriver(&chip);
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_power_down(&conf, true));
+    ASSERT_TRUE(chip.poweredDown);
+    ASSERT_EQ(0x20 | 0x10 | mfrc522_reg_cmd_idle, chip.regs[mfrc522_reg_command]); /* RcvOff bit is kept */
+
+    u32 resumedAt = chip.clock;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_power_down(&conf, false));
+    ASSERT_FALSE(chip.poweredDown);
+    ASSERT_GE(chip.clock - resumedAt, chip.wakeLatency);
+    ASSERT_LE(chip.clock - resumedAt, chip.wakeLatency + 200);
+    ASSERT_EQ(0x20 | mfrc522_reg_cmd_idle, chip.regs[mfrc522_reg_command]);
+}
+
+TEST(TestMfrc522DrvLowPower, mfrc522_drv_power_down__DeviceNeverWakesUp__Failure)
+{
+    PoweredChip chip;
+    auto conf = initDriver(&chip);
+    chip.wakeLatency = 10 * MFRC522_CONF_DEADLINE_WAKE_UP;
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_power_down(&conf, true));
+    u32 resumedAt = chip.clock;
+    ASSERT_EQ(mfrc522_drv_status_dev_rtr_err, mfrc522_drv_power_down(&conf, false));
+    ASSERT_LT(chip.clock - resumedAt, 2 * MFRC522_CONF_DEADLINE_WAKE_UP);
+}
+
+TEST(TestMfrc522DrvLowPower, mfrc522_drv_lpcd__NoCard__MostTimeInPowerDown)
+{
+    PoweredChip chip;
+    auto conf = initDriver(&chip);
+    auto lpConf = lpcdConf(20);
+    u16 atqa;
+
+    u32 startedAt = chip.clock;
+    u32 downBefore = chip.downTime();
+    ASSERT_EQ(mfrc522_drv_status_transceive_timeout, mfrc522_drv_lpcd(&conf, &lpConf, &atqa));
+    ASSERT_EQ(21U, chip.frames); /* The first probe is repeated, since a PICC might have been left in READY state */
+    ASSERT_TRUE(chip.poweredDown);
+    ASSERT_EQ(0U, chip.accessesWhileDown);
+
+    /* Fraction of time spent in power-down in per mille */
+    u32 elapsed = chip.clock - startedAt;
+    u32 fraction = static_cast<u32>((1000ULL * (chip.downTime() - downBefore)) / elapsed);
+    RecordProperty("PowerDownPerMille", static_cast<int>(fraction));
+    ASSERT_GE(fraction, 950U);
+}
+
+TEST(TestMfrc522DrvLowPower, mfrc522_drv_lpcd__CardArrives__DetectedWithinOneCycle)
+{
+    PoweredChip chip;
+    auto conf = initDriver(&chip);
+    auto lpConf = lpcdConf(0);
+    chip.cardArrives = chip.clock + 350000;
+    u16 atqa;
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_lpcd(&conf, &lpConf, &atqa));
+    ASSERT_EQ(0x0004, atqa);
+    ASSERT_FALSE(chip.poweredDown);
+    ASSERT_EQ(0x20 | mfrc522_reg_cmd_idle, chip.regs[mfrc522_reg_command]);
+
+    /* Detection latency is bounded by a single cycle */
+    u32 cycle = lpConf.sleep_period + lpConf.settle_time + chip.wakeLatency + 2 * chip.fwt;
+    ASSERT_LE(chip.clock - chip.cardArrives, cycle);
+}
+
+TEST(TestMfrc522DrvLowPower, mfrc522_drv_lpcd__CardAlreadyPresent__NoPowerDown)
+{
+    PoweredChip chip;
+    auto conf = initDriver(&chip);
+    auto lpConf = lpcdConf(0);
+    chip.cardArrives = 0;
+    u16 atqa;
+
+    u32 downBefore = chip.downTime();
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_lpcd(&conf, &lpConf, &atqa));
+    ASSERT_EQ(0x0004, atqa);
+    ASSERT_EQ(1U, chip.frames);
+    ASSERT_EQ(downBefore, chip.downTime());
+}
@@ -16,7 +16,12 @@ MATCHER_P(TransceiveStructInputMatcher, expected, "Transceive struct input match
     return (arg->tx_data_sz == expected->tx_data_sz) && /* Compare TX sizes */
            (arg->rx_data_sz == expected->rx_data_sz) &&  /* Compare RX sizes */
            !memcmp(arg->tx_data, expected->tx_data, expected->tx_data_sz) && /* Compare TX data */
-           (arg->command == expected->command); /* Compare commands */
+           (arg->command == expected->command) && /* Compare commands */
+           (arg->timeout == expected->timeout) && /* Compare frame waiting times */
+           (arg->hw_crc == expected->hw_crc) && /* Compare CRC modes */
+           (arg->tx_last_bits == expected->tx_last_bits) && /* Compare TX framing */
+           (arg->rx_align == expected->rx_align) && /* Compare RX alignment */
+           (arg->rx_var_len == expected->rx_var_len); /* Compare RX length modes */
 }
 
 /* ------------------------------------------------------------ */
@@ -37,7 +42,7 @@ ACTION_P(TransceiveAction, expected)
 TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__NullCases)
 {
     auto device = initDevice();
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
 
     auto status = mfrc522_drv_transceive(&device, nullptr);
     ASSERT_EQ(mfrc522_drv_status_nullptr, status);
@@ -49,13 +54,34 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__InvalidCommand)
 {
     auto device = initDevice();
     /* Do not fill any other fields - needless in this test */
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.command = mfrc522_reg_cmd_idle;
 
     auto status = mfrc522_drv_transceive(&device, &transceiveConf);
     ASSERT_EQ(mfrc522_drv_status_nok, status);
 }
 
+TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__TimeoutTooLong__Failure)
+{
+    auto device = initDevice();
+
+    u8 tx = 0xCF;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    transceiveConf.tx_data = &tx;
+    transceiveConf.tx_data_sz = 1;
+    transceiveConf.rx_data = nullptr;
+    transceiveConf.rx_data_sz = 0;
+    transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_TIM_MAX_PERIOD + 1;
+
+    /* Nothing shall be sent to the device */
+    MOCK(mfrc522_ll_send);
+    MOCK_CALL(mfrc522_ll_send, _, _, _, _).Times(0);
+
+    auto status = mfrc522_drv_transceive(&device, &transceiveConf);
+    ASSERT_EQ(mfrc522_drv_status_tim_prd_err, status);
+}
+
 TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__NoIrqAfterAllRetries__TimeoutError)
 {
     auto device = initDevice();
@@ -63,7 +89,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__NoIrqAfterAllRetries__Timeout
     /* Populate configuration struct */
     u8 tx = 0xCF;
     u8 rx = 0xAA;
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx;
     transceiveConf.tx_data_sz = 1;
     transceiveConf.rx_data = &rx;
@@ -74,24 +100,25 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__NoIrqAfterAllRetries__Timeout
     MOCK(mfrc522_ll_send);
     MOCK(mfrc522_ll_recv);
     MOCK(mfrc522_drv_irq_states);
-    MOCK(mfrc522_drv_invoke_cmd);
-    MOCK(mfrc522_drv_irq_clr);
     IGNORE_REDUNDANT_LL_RECV_CALLS();
     InSequence s;
     /* All IRQs shall be cleared */
-    MOCK_CALL(mfrc522_drv_irq_clr, &device, mfrc522_reg_irq_all).WillOnce(Return(mfrc522_drv_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_com_irq, 1, Pointee(0x7F)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_div_irq, 1, Pointee(0x14)).WillOnce(Return(mfrc522_ll_status_ok));
     /* FIFO buffer should be flushed and populated with new data */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_level, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_data, 1, Pointee(tx)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_level, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, 1, Pointee(tx)).WillOnce(Return(mfrc522_ll_status_ok));
     /* Start transceive command and transmission of data */
-    MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_transceive).WillOnce(Return(mfrc522_drv_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, Pointee(mfrc522_reg_cmd_transceive))
+            .WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_bit_framing, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
     /* Simulate that no IRQ is set (states = 0x0000) */
     MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull()).Times(AtLeast(1))
             .WillRepeatedly(DoAll(SetArgPointee<1>(0x0000), Return(mfrc522_drv_status_ok)));
     /* Stop transmission of data and enter Idle state back */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_idle).WillOnce(Return(mfrc522_drv_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_bit_framing, 1, Pointee(0x00)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, Pointee(mfrc522_reg_cmd_idle))
+            .WillOnce(Return(mfrc522_ll_status_ok));
 
     /* Check results */
     auto status = mfrc522_drv_transceive(&device, &transceiveConf);
@@ -106,7 +133,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__ErrorBitIsSet__ErrorReturned)
     /* Populate configuration struct */
     u8 tx = 0xCF;
     u8 rx = 0xAA;
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx;
     transceiveConf.tx_data_sz = 1;
     transceiveConf.rx_data = &rx;
@@ -117,24 +144,25 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__ErrorBitIsSet__ErrorReturned)
     MOCK(mfrc522_ll_send);
     MOCK(mfrc522_ll_recv);
     MOCK(mfrc522_drv_irq_states);
-    MOCK(mfrc522_drv_invoke_cmd);
-    MOCK(mfrc522_drv_irq_clr);
     IGNORE_REDUNDANT_LL_RECV_CALLS();
     InSequence s;
     /* All IRQs shall be cleared */
-    MOCK_CALL(mfrc522_drv_irq_clr, &device, mfrc522_reg_irq_all).WillOnce(Return(mfrc522_drv_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_com_irq, 1, Pointee(0x7F)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_div_irq, 1, Pointee(0x14)).WillOnce(Return(mfrc522_ll_status_ok));
     /* FIFO buffer should be flushed and populated with new data */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_level, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_data, 1, Pointee(tx)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_level, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, 1, Pointee(tx)).WillOnce(Return(mfrc522_ll_status_ok));
     /* Start transceive command and transmission of data */
-    MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_transceive).WillOnce(Return(mfrc522_drv_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, Pointee(mfrc522_reg_cmd_transceive))
+            .WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_bit_framing, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
     /* Simulate that error IRQ is set (low byte = 0x02) */
     MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull()).Times(AtLeast(1))
             .WillRepeatedly(DoAll(SetArgPointee<1>(0x0002), Return(mfrc522_drv_status_ok)));
     /* Stop transmission of data and enter Idle state back */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_idle).WillOnce(Return(mfrc522_drv_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_bit_framing, 1, Pointee(0x00)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, Pointee(mfrc522_reg_cmd_idle))
+            .WillOnce(Return(mfrc522_ll_status_ok));
 
     /* Check results */
     auto status = mfrc522_drv_transceive(&device, &transceiveConf);
@@ -149,7 +177,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__InvalidNumberOfRxValidBits__E
     /* Populate configuration struct */
     u8 tx = 0xCF;
     u8 rx = 0xAA;
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx;
     transceiveConf.tx_data_sz = 1;
     transceiveConf.rx_data = &rx;
@@ -160,26 +188,27 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__InvalidNumberOfRxValidBits__E
     MOCK(mfrc522_ll_send);
     MOCK(mfrc522_ll_recv);
     MOCK(mfrc522_drv_irq_states);
-    MOCK(mfrc522_drv_invoke_cmd);
-    MOCK(mfrc522_drv_irq_clr);
     IGNORE_REDUNDANT_LL_RECV_CALLS();
     InSequence s;
     /* All IRQs shall be cleared */
-    MOCK_CALL(mfrc522_drv_irq_clr, &device, mfrc522_reg_irq_all).WillOnce(Return(mfrc522_drv_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_com_irq, 1, Pointee(0x7F)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_div_irq, 1, Pointee(0x14)).WillOnce(Return(mfrc522_ll_status_ok));
     /* FIFO buffer should be flushed and populated with new data */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_level, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_data, 1, Pointee(tx)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_level, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, 1, Pointee(tx)).WillOnce(Return(mfrc522_ll_status_ok));
     /* Start transceive command and transmission of data */
-    MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_transceive).WillOnce(Return(mfrc522_drv_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, Pointee(mfrc522_reg_cmd_transceive))
+            .WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_bit_framing, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
     MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull()).Times(AtLeast(1))
             .WillRepeatedly(DoAll(SetArgPointee<1>(1 << 5), Return(mfrc522_drv_status_ok)));
     /* Stop transmission of data and enter Idle state back */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_idle).WillOnce(Return(mfrc522_drv_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_bit_framing, 1, Pointee(0x00)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, Pointee(mfrc522_reg_cmd_idle))
+            .WillOnce(Return(mfrc522_ll_status_ok));
     /* Simulate that RX last bits = 0x01 */
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_control, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(0x01), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_control, NotNull())
+            .WillOnce(DoAll(SetArgPointee<2>(0x01), Return(mfrc522_ll_status_ok)));
 
     /* Check results */
     auto status = mfrc522_drv_transceive(&device, &transceiveConf);
@@ -194,7 +223,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__NoDataOnRxSide__Error)
     /* Populate configuration struct */
     u8 tx = 0xCF;
     u8 rx = 0xAA;
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx;
     transceiveConf.tx_data_sz = 1;
     transceiveConf.rx_data = &rx;
@@ -204,29 +233,31 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__NoDataOnRxSide__Error)
     /* Set expectations */
     MOCK(mfrc522_ll_send);
     MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_recv_mul);
     MOCK(mfrc522_drv_irq_states);
-    MOCK(mfrc522_drv_invoke_cmd);
-    MOCK(mfrc522_drv_irq_clr);
     IGNORE_REDUNDANT_LL_RECV_CALLS();
     InSequence s;
     /* All IRQs shall be cleared */
-    MOCK_CALL(mfrc522_drv_irq_clr, &device, mfrc522_reg_irq_all).WillOnce(Return(mfrc522_drv_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_com_irq, 1, Pointee(0x7F)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_div_irq, 1, Pointee(0x14)).WillOnce(Return(mfrc522_ll_status_ok));
     /* FIFO buffer should be flushed and populated with new data */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_level, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_data, 1, Pointee(tx)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_level, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, 1, Pointee(tx)).WillOnce(Return(mfrc522_ll_status_ok));
     /* Start transceive command and transmission of data */
-    MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_transceive).WillOnce(Return(mfrc522_drv_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, Pointee(mfrc522_reg_cmd_transceive))
+            .WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_bit_framing, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
     MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull()).Times(AtLeast(1))
             .WillRepeatedly(DoAll(SetArgPointee<1>(1 << 5), Return(mfrc522_drv_status_ok)));
     /* Stop transmission of data and enter Idle state back */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_idle).WillOnce(Return(mfrc522_drv_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_bit_framing, 1, Pointee(0x00)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, Pointee(mfrc522_reg_cmd_idle))
+            .WillOnce(Return(mfrc522_ll_status_ok));
     /* Get number of RX last bits and FIFO level */
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_control, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(0x00), Return(mfrc522_ll_status_ok)));
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_fifo_level, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(0x00), Return(mfrc522_ll_status_ok))); /* Lack of RX bytes */
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_control, NotNull())
+            .WillOnce(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_fifo_level, NotNull())
+            .WillOnce(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok))); /* Lack of RX bytes */
 
     /* Check results */
     auto status = mfrc522_drv_transceive(&device, &transceiveConf);
@@ -241,7 +272,7 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__TypicalCase__Success)
     /* Populate configuration struct */
     u8 tx = 0xCF;
     u8 rx[2] = {0x00};
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx;
     transceiveConf.tx_data_sz = 1;
     transceiveConf.rx_data = &rx[0];
@@ -251,33 +282,35 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_transceive__TypicalCase__Success)
     /* Set expectations */
     MOCK(mfrc522_ll_send);
     MOCK(mfrc522_ll_recv);
+    MOCK(mfrc522_ll_recv_mul);
     MOCK(mfrc522_drv_irq_states);
-    MOCK(mfrc522_drv_invoke_cmd);
-    MOCK(mfrc522_drv_irq_clr);
     IGNORE_REDUNDANT_LL_RECV_CALLS();
     InSequence s;
     /* All IRQs shall be cleared */
-    MOCK_CALL(mfrc522_drv_irq_clr, &device, mfrc522_reg_irq_all).WillOnce(Return(mfrc522_drv_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_com_irq, 1, Pointee(0x7F)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_div_irq, 1, Pointee(0x14)).WillOnce(Return(mfrc522_ll_status_ok));
     /* FIFO buffer should be flushed and populated with new data */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_level, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_fifo_data, 1, Pointee(tx)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_level, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_fifo_data, 1, Pointee(tx)).WillOnce(Return(mfrc522_ll_status_ok));
     /* Start transceive command and transmission of data */
-    MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_transceive).WillOnce(Return(mfrc522_drv_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, Pointee(mfrc522_reg_cmd_transceive))
+            .WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_bit_framing, 1, Pointee(0x80)).WillOnce(Return(mfrc522_ll_status_ok));
     MOCK_CALL(mfrc522_drv_irq_states, &device, NotNull()).Times(AtLeast(1))
             .WillRepeatedly(DoAll(SetArgPointee<1>(1 << 5), Return(mfrc522_drv_status_ok)));
     /* Stop transmission of data and enter Idle state back */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_drv_invoke_cmd, &device, mfrc522_reg_cmd_idle).WillOnce(Return(mfrc522_drv_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_bit_framing, 1, Pointee(0x00)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_command, 1, Pointee(mfrc522_reg_cmd_idle))
+            .WillOnce(Return(mfrc522_ll_status_ok));
     /* Get number of RX last bits and FIFO level */
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_control, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(0x00), Return(mfrc522_ll_status_ok)));
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_fifo_level, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(0x02), Return(mfrc522_ll_status_ok)));
-    /* Read RX data */
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_fifo_data, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(0xBB), Return(mfrc522_ll_status_ok)))
-            .WillOnce(DoAll(SetArgPointee<1>(0xCC), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_control, NotNull())
+            .WillOnce(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_fifo_level, NotNull())
+            .WillOnce(DoAll(SetArgPointee<2>(0x02), Return(mfrc522_ll_status_ok)));
+    /* Read RX data at once */
+    const u8 fifo[] = {0xBB, 0xCC};
+    MOCK_CALL(mfrc522_ll_recv_mul, _, mfrc522_reg_fifo_data, 2, NotNull())
+            .WillOnce(DoAll(SetArrayArgument<3>(fifo, fifo + 2), Return(mfrc522_ll_status_ok)));
 
     /* Check results */
     auto status = mfrc522_drv_transceive(&device, &transceiveConf);
@@ -305,9 +338,8 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_reqa__TransceiveError__InvalidATQAReturne
     /* Set the same expectations for each test case */
     MOCK(mfrc522_ll_send);
     MOCK(mfrc522_drv_transceive);
-    /* TX last bits should be set to 0x07 in each test cases */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, Pointee(0x07)).Times(3)
-            .WillRepeatedly(Return(mfrc522_ll_status_ok));
+    /* TX last bits are set by transceive command, thus no register is written directly */
+    MOCK_CALL(mfrc522_ll_send, _, _, _, _).Times(0);
     /* Simulate failure in transceive process */
     MOCK_CALL(mfrc522_drv_transceive, &device, NotNull())
             .WillOnce(Return(mfrc522_drv_status_transceive_timeout))
@@ -344,18 +376,18 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_reqa__TypicalCase__Success)
     InSequence s;
     u8 txData[1] = {mfrc522_picc_cmd_reqa}; /* TX data (expected input to mocked function) */
     u8 rxData[2] = {0x04, 0x00}; /* RX data (expected output from mocked function) */
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &txData[0];
     transceiveConf.tx_data_sz = 1;
     transceiveConf.rx_data = &rxData[0];
     transceiveConf.rx_data_sz = 2;
     transceiveConf.command = mfrc522_reg_cmd_transceive;
-    /* TX last bits should be set to 0x07 */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, Pointee(0x07)).WillOnce(Return(mfrc522_ll_status_ok));
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
+    transceiveConf.tx_last_bits = 7; /* REQA is a short frame */
+    /* BitFramingReg is handled by transceive command, thus no register is written directly */
+    MOCK_CALL(mfrc522_ll_send, _, _, _, _).Times(0);
     MOCK_CALL(mfrc522_drv_transceive, &device, TransceiveStructInputMatcher(&transceiveConf))
             .WillOnce(DoAll(TransceiveAction(&transceiveConf), Return(mfrc522_drv_status_ok)));
-    /* TX last bits should be restored */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, Pointee(0x00)).WillOnce(Return(mfrc522_ll_status_ok));
 
     auto status = mfrc522_drv_reqa(&device, &atqa);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -374,18 +406,18 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_reqa__BlacklistedAtqaReturned__Error)
     InSequence s;
     u8 txData[1] = {mfrc522_picc_cmd_reqa}; /* TX data (expected input to mocked function) */
     u8 rxData[2] = {0xFF, 0xAA}; /* RX data (expected output from mocked function) */
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &txData[0];
     transceiveConf.tx_data_sz = 1;
     transceiveConf.rx_data = &rxData[0];
     transceiveConf.rx_data_sz = 2;
     transceiveConf.command = mfrc522_reg_cmd_transceive;
-    /* TX last bits should be set to 0x07 */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, Pointee(0x07)).WillOnce(Return(mfrc522_ll_status_ok));
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
+    transceiveConf.tx_last_bits = 7; /* REQA is a short frame */
+    /* BitFramingReg is handled by transceive command, thus no register is written directly */
+    MOCK_CALL(mfrc522_ll_send, _, _, _, _).Times(0);
     MOCK_CALL(mfrc522_drv_transceive, &device, TransceiveStructInputMatcher(&transceiveConf))
             .WillOnce(DoAll(TransceiveAction(&transceiveConf), Return(mfrc522_drv_status_ok)));
-    /* TX last bits should be restored */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_bit_framing, 1, Pointee(0x00)).WillOnce(Return(mfrc522_ll_status_ok));
 
     auto status = mfrc522_drv_reqa(&device, &atqa);
     ASSERT_EQ(mfrc522_drv_status_picc_vrf_err, status);
@@ -431,12 +463,13 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_anticollision__InvalidChecksum__Error)
     MOCK(mfrc522_drv_transceive);
     u8 txData[2] = {0x93, 0x20};
     u8 rxData[5] = {0x73, 0xEF, 0xD7, 0x18, 0xAB}; /* 0xAB is invalid in this case */
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &txData[0];
     transceiveConf.tx_data_sz = 2;
     transceiveConf.rx_data = &rxData[0];
     transceiveConf.rx_data_sz = 5;
     transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
     MOCK_CALL(mfrc522_drv_transceive, &device, TransceiveStructInputMatcher(&transceiveConf))
             .WillOnce(DoAll(TransceiveAction(&transceiveConf), Return(mfrc522_drv_status_ok)));
 
@@ -460,12 +493,13 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_anticollision__ValidNUIDAndChecksumReturn
     MOCK(mfrc522_drv_transceive);
     u8 txData[2] = {0x93, 0x20};
     u8 rxData[5] = {0x73, 0xEF, 0xD7, 0x18, 0x53};
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &txData[0];
     transceiveConf.tx_data_sz = 2;
     transceiveConf.rx_data = &rxData[0];
     transceiveConf.rx_data_sz = 5;
     transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
     MOCK_CALL(mfrc522_drv_transceive, &device, TransceiveStructInputMatcher(&transceiveConf))
             .WillOnce(DoAll(TransceiveAction(&transceiveConf), Return(mfrc522_drv_status_ok)));
 
@@ -508,12 +542,13 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_select__CRCDoesNotMatchUp__Error)
         0x08, /* SAK */
         0xB6, 0xDD /* CRC */
     };
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx[0];
     transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
     transceiveConf.rx_data = &rx[0];
     transceiveConf.rx_data_sz = SIZE_ARRAY(rx);
     transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
     InSequence s;
     /* Compute CRC of TX data */
     MOCK_CALL(mfrc522_drv_crc_compute, &device, NotNull())
@@ -549,12 +584,13 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_select__TypicalCase__Success)
         0x08, /* SAK */
         0xB6, 0xDD /* CRC */
     };
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx[0];
     transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
     transceiveConf.rx_data = &rx[0];
     transceiveConf.rx_data_sz = SIZE_ARRAY(rx);
     transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
     InSequence s;
     /* Compute CRC of TX data */
     MOCK_CALL(mfrc522_drv_crc_compute, &device, NotNull())
@@ -571,6 +607,81 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_select__TypicalCase__Success)
     ASSERT_EQ(0x08, sak);
 }
 
+TEST(TestMfrc522DrvCommon, mfrc522_drv_select__SoftwareCrc__CoprocessorNotUsed)
+{
+    auto device = initDevice();
+    device.crc_mode = mfrc522_drv_crc_mode_sw;
+    u8 serial[5] = {0x73, 0xEF, 0xD7, 0x18, 0x53}; /* Got from PICC */
+    u8 sak;
+
+    /* Set expectations */
+    MOCK(mfrc522_drv_transceive);
+    MOCK(mfrc522_drv_crc_compute);
+    MOCK(mfrc522_ll_send);
+    u8 tx[9] =
+    {
+        0x93, 0x70, /* General command */
+        0x73, 0xEF, 0xD7, 0x18, 0x53, /* Serial data */
+        0x95, 0xEF /* CRC */
+    };
+    u8 rx[3] =
+    {
+        0x08, /* SAK */
+        0xB6, 0xDD /* CRC */
+    };
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    transceiveConf.tx_data = &tx[0];
+    transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
+    transceiveConf.rx_data = &rx[0];
+    transceiveConf.rx_data_sz = SIZE_ARRAY(rx);
+    transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
+    MOCK_CALL(mfrc522_drv_crc_compute, _, _).Times(0);
+    MOCK_CALL(mfrc522_ll_send, _, _, _, _).Times(0);
+    MOCK_CALL(mfrc522_drv_transceive, &device, TransceiveStructInputMatcher(&transceiveConf))
+            .WillOnce(DoAll(TransceiveAction(&transceiveConf), Return(mfrc522_drv_status_ok)));
+
+    auto status = mfrc522_drv_select(&device, &serial[0], &sak);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(0x08, sak);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_select__HardwareCrc__CrcNotInFrame)
+{
+    auto device = initDevice();
+    device.crc_mode = mfrc522_drv_crc_mode_hw;
+    u8 serial[5] = {0x73, 0xEF, 0xD7, 0x18, 0x53}; /* Got from PICC */
+    u8 sak;
+
+    /* Set expectations */
+    MOCK(mfrc522_drv_transceive);
+    MOCK(mfrc522_drv_crc_compute);
+    u8 tx[7] =
+    {
+        0x93, 0x70, /* General command */
+        0x73, 0xEF, 0xD7, 0x18, 0x53 /* Serial data. CRC is appended by the chip */
+    };
+    u8 rx[1] =
+    {
+        0x08 /* SAK. CRC is verified by the chip */
+    };
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    transceiveConf.tx_data = &tx[0];
+    transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
+    transceiveConf.rx_data = &rx[0];
+    transceiveConf.rx_data_sz = SIZE_ARRAY(rx);
+    transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
+    transceiveConf.hw_crc = true;
+    MOCK_CALL(mfrc522_drv_crc_compute, _, _).Times(0);
+    MOCK_CALL(mfrc522_drv_transceive, &device, TransceiveStructInputMatcher(&transceiveConf))
+            .WillOnce(DoAll(TransceiveAction(&transceiveConf), Return(mfrc522_drv_status_ok)));
+
+    auto status = mfrc522_drv_select(&device, &serial[0], &sak);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(0x08, sak);
+}
+
 TEST(TestMfrc522DrvCommon, mfrc522_drv_authenticate__NullCases)
 {
     auto device = initDevice();
@@ -604,12 +715,13 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_authenticate__TypicalCase__Success)
         0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, /* Secret key */
         0x73, 0xEF, 0xD7, 0x18, /* Serial number without checksum */
     };
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx[0];
     transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
     transceiveConf.rx_data = nullptr;
     transceiveConf.rx_data_sz = 0;
     transceiveConf.command = mfrc522_reg_cmd_authent;
+    transceiveConf.timeout = MFRC522_DRV_FWT_MIFARE_AUTH;
 
     /* Set expectations */
     MOCK(mfrc522_drv_transceive);
@@ -619,8 +731,8 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_authenticate__TypicalCase__Success)
     MOCK_CALL(mfrc522_drv_transceive, &device, TransceiveStructInputMatcher(&transceiveConf))
             .WillOnce(DoAll(TransceiveAction(&transceiveConf), Return(mfrc522_drv_status_ok)));
     /* Check is crypto was enabled */
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_status2, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(1 << 3), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_status2, NotNull())
+            .WillOnce(DoAll(SetArgPointee<2>(1 << 3), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_authenticate(&device, &authConf);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -648,12 +760,13 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_authenticate__CryptoNotEnabled__Error)
         0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, /* Secret key */
         0x73, 0xEF, 0xD7, 0x18, /* Serial number without checksum */
     };
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx[0];
     transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
     transceiveConf.rx_data = nullptr;
     transceiveConf.rx_data_sz = 0;
     transceiveConf.command = mfrc522_reg_cmd_authent;
+    transceiveConf.timeout = MFRC522_DRV_FWT_MIFARE_AUTH;
 
     /* Set expectations */
     MOCK(mfrc522_drv_transceive);
@@ -663,8 +776,8 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_authenticate__CryptoNotEnabled__Error)
     MOCK_CALL(mfrc522_drv_transceive, &device, TransceiveStructInputMatcher(&transceiveConf))
             .WillOnce(DoAll(TransceiveAction(&transceiveConf), Return(mfrc522_drv_status_ok)));
     /* Simulate that crypto was not enabled even if the previous step returned 'ok' status code */
-    MOCK_CALL(mfrc522_ll_recv, mfrc522_reg_status2, NotNull())
-            .WillOnce(DoAll(SetArgPointee<1>(0x00), Return(mfrc522_ll_status_ok)));
+    MOCK_CALL(mfrc522_ll_recv, _, mfrc522_reg_status2, NotNull())
+            .WillOnce(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)));
 
     auto status = mfrc522_drv_authenticate(&device, &authConf);
     ASSERT_EQ(mfrc522_drv_status_crypto_err, status);
@@ -686,12 +799,13 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_halt__TypicalCase__Success)
         0x50, 0x00, /* Halt command */
         0x57, 0xCD /* CRC */
     };
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx[0];
     transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
     transceiveConf.rx_data = nullptr;
     transceiveConf.rx_data_sz = 0;
     transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
 
     /* Set expectations */
     MOCK(mfrc522_drv_transceive);
@@ -706,7 +820,74 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_halt__TypicalCase__Success)
     MOCK_CALL(mfrc522_drv_transceive, &device, TransceiveStructInputMatcher(&transceiveConf))
             .WillOnce(DoAll(TransceiveAction(&transceiveConf), Return(mfrc522_drv_status_transceive_timeout)));
     /* Disable the crypto unit */
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_status2, 1, Pointee(0x00)).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_status2, 1, Pointee(0x00)).WillOnce(Return(mfrc522_ll_status_ok));
+
+    auto status = mfrc522_drv_halt(&device);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_halt__SoftwareCrc__CoprocessorNotUsed)
+{
+    auto device = initDevice();
+    device.crc_mode = mfrc522_drv_crc_mode_sw;
+
+    /* Expected parameters */
+    u8 tx[4] =
+    {
+        0x50, 0x00, /* Halt command */
+        0x57, 0xCD /* CRC */
+    };
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    transceiveConf.tx_data = &tx[0];
+    transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
+    transceiveConf.rx_data = nullptr;
+    transceiveConf.rx_data_sz = 0;
+    transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
+
+    /* Set expectations */
+    MOCK(mfrc522_drv_transceive);
+    MOCK(mfrc522_ll_send);
+    MOCK(mfrc522_drv_crc_compute);
+    MOCK_CALL(mfrc522_drv_crc_compute, _, _).Times(0);
+    InSequence s;
+    MOCK_CALL(mfrc522_drv_transceive, &device, TransceiveStructInputMatcher(&transceiveConf))
+            .WillOnce(DoAll(TransceiveAction(&transceiveConf), Return(mfrc522_drv_status_transceive_timeout)));
+    /* Crypto unit is the only register written */
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_status2, 1, Pointee(0x00)).WillOnce(Return(mfrc522_ll_status_ok));
+
+    auto status = mfrc522_drv_halt(&device);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+}
+
+TEST(TestMfrc522DrvCommon, mfrc522_drv_halt__HardwareCrc__CrcNotInFrame)
+{
+    auto device = initDevice();
+    device.crc_mode = mfrc522_drv_crc_mode_hw;
+
+    /* Expected parameters */
+    u8 tx[2] =
+    {
+        0x50, 0x00 /* Halt command. CRC is appended by the chip */
+    };
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    transceiveConf.tx_data = &tx[0];
+    transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
+    transceiveConf.rx_data = nullptr;
+    transceiveConf.rx_data_sz = 0;
+    transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
+    transceiveConf.hw_crc = true;
+
+    /* Set expectations */
+    MOCK(mfrc522_drv_transceive);
+    MOCK(mfrc522_ll_send);
+    MOCK(mfrc522_drv_crc_compute);
+    MOCK_CALL(mfrc522_drv_crc_compute, _, _).Times(0);
+    InSequence s;
+    MOCK_CALL(mfrc522_drv_transceive, &device, TransceiveStructInputMatcher(&transceiveConf))
+            .WillOnce(DoAll(TransceiveAction(&transceiveConf), Return(mfrc522_drv_status_transceive_timeout)));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_status2, 1, Pointee(0x00)).WillOnce(Return(mfrc522_ll_status_ok));
 
     auto status = mfrc522_drv_halt(&device);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -722,12 +903,13 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_halt__OkStatusAfterTransceiveCommand__Err
         0x50, 0x00, /* Halt command */
         0x57, 0xCD /* CRC */
     };
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx[0];
     transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
     transceiveConf.rx_data = nullptr;
     transceiveConf.rx_data_sz = 0;
     transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
 
     /* Set expectations */
     MOCK(mfrc522_drv_transceive);
@@ -756,12 +938,13 @@ TEST(TestMfrc522DrvCommon, mfrc522_drv_halt__ErrorPresentAfterTransceiveCommand_
         0x50, 0x00, /* Halt command */
         0x57, 0xCD /* CRC */
     };
-    mfrc522_drv_transceive_conf transceiveConf;
+    mfrc522_drv_transceive_conf transceiveConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
     transceiveConf.tx_data = &tx[0];
     transceiveConf.tx_data_sz = SIZE_ARRAY(tx);
     transceiveConf.rx_data = nullptr;
     transceiveConf.rx_data_sz = 0;
     transceiveConf.command = mfrc522_reg_cmd_transceive;
+    transceiveConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
 
     /* Set expectations */
     MOCK(mfrc522_drv_transceive);
@@ -0,0 +1,246 @@
+#include "mfrc522_drv.h"
+#include "mfrc522_conf.h"
+#include <gtest/gtest.h>
+#include <map>
+#include "common/SimulatedChip.h"
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Private classes -------------------- */
+/* ------------------------------------------------------------ */
+
+/*
+ * MFRC522 with simulated time. Commands complete after a given latency, each register read takes some bus time and
+ * delays advance the clock, so the number of reads needed to detect completion can be measured.
+ */
+class TimedChip : public SimulatedChip
+{
+public:
+    std::map<u8, u32> latency = {
+        {mfrc522_reg_cmd_soft_reset, 40},
+        {mfrc522_reg_cmd_crc, 6},
+        {mfrc522_reg_cmd_mem, 2000}
+    };
+    u32 readCost = 2; /* Bus time of a single register read in microseconds */
+    u32 doneAt = 0; /* Time at which the recent command completes */
+    std::map<u8, size> reads;
+
+private:
+    bool done() const
+    {
+        return static_cast<i32>(clock - doneAt) >= 0;
+    }
+
+    void write(u8 addr, u8 val) override
+    {
+        SimulatedChip::write(addr, val);
+        if (mfrc522_reg_command == addr) {
+            auto it = latency.find(val & 0x0F);
+            doneAt = clock + ((latency.end() != it) ? it->second : 0);
+        }
+    }
+
+    u8 read(u8 addr) override
+    {
+        clock += readCost;
+        ++reads[addr];
+        u8 cmd = regs[mfrc522_reg_command] & 0x0F;
+        switch (addr) {
+            case mfrc522_reg_command:
+                /* CalcCRC does not terminate itself, all the other commands go back to Idle */
+                if (mfrc522_reg_cmd_crc != cmd && done()) {
+                    regs[addr] = (regs[addr] & 0xF0) | mfrc522_reg_cmd_idle;
+                }
+                break;
+            case mfrc522_reg_status1:
+                regs[addr] = (mfrc522_reg_cmd_crc == cmd && done()) ? 0x20 : 0x00;
+                break;
+            default:
+                break;
+        }
+        return SimulatedChip::read(addr);
+    }
+};
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+static mfrc522_drv_conf initDriver(TimedChip* chip, const mfrc522_ll_ops* ops = SimulatedChip::ops())
+{
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = ops;
+    conf.ll_ctx = chip;
+    conf.atqa_verify_fn = nullptr;
+    EXPECT_EQ(mfrc522_drv_status_ok, mfrc522_drv_init(&conf));
+    chip->reads.clear();
+    return conf;
+}
+
+/* Settings waiting for Idle command with fixed delay between reads */
+static mfrc522_drv_read_until_conf idleConf(u32 delay)
+{
+    mfrc522_drv_read_until_conf ruConf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+    ruConf.addr = mfrc522_reg_command;
+    ruConf.mask = 0x0F;
+    ruConf.exp_payload = mfrc522_reg_cmd_idle;
+    ruConf.delay = delay;
+    ruConf.retry_cnt = MFRC522_DRV_RETRY_CNT_INF;
+    return ruConf;
+}
+
+/* Start a command and wait until it is done. Returns the number of reads */
+static size waitForCommand(TimedChip* chip, const mfrc522_drv_conf* conf, mfrc522_drv_read_until_conf* ruConf)
+{
+    EXPECT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write_byte(conf, mfrc522_reg_command, mfrc522_reg_cmd_mem));
+    chip->reads.clear();
+    EXPECT_EQ(mfrc522_drv_status_ok, mfrc522_drv_read_until(conf, ruConf));
+    return chip->reads[mfrc522_reg_command];
+}
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Test cases ------------------------ */
+/* ------------------------------------------------------------ */
+
+TEST(TestMfrc522DrvPollPolicy, mfrc522_drv_read_until__LongOperation__BackoffReducesBusReads)
+{
+    TimedChip chip;
+    auto conf = initDriver(&chip);
+
+    auto fixed = idleConf(5);
+    size fixedReads = waitForCommand(&chip, &conf, &fixed);
+
+    auto backoff = idleConf(5);
+    backoff.max_delay = 640;
+    size backoffReads = waitForCommand(&chip, &conf, &backoff);
+
+    ASSERT_LT(10 * backoffReads, fixedReads);
+
+    /* Completion is detected not later than one capped delay after it happened */
+    ASSERT_LE(chip.clock - chip.doneAt, backoff.max_delay + chip.readCost);
+}
+
+TEST(TestMfrc522DrvPollPolicy, mfrc522_drv_read_until__ExpectedLatencyGiven__SingleRead)
+{
+    TimedChip chip;
+    auto conf = initDriver(&chip);
+
+    auto ruConf = idleConf(5);
+    ruConf.first_delay = chip.latency[mfrc522_reg_cmd_mem];
+    ASSERT_EQ(1U, waitForCommand(&chip, &conf, &ruConf));
+}
+
+TEST(TestMfrc522DrvPollPolicy, mfrc522_drv_read_until__DeadlineReached__Failure)
+{
+    TimedChip chip;
+    chip.clock = 0xFFFFFF00; /* Clock wraps around during the call */
+    auto conf = initDriver(&chip);
+
+    mfrc522_drv_read_until_conf ruConf = MFRC522_DRV_READ_UNTIL_CONF_DEFAULT;
+    ruConf.addr = mfrc522_reg_fifo_level;
+    ruConf.mask = 0xFF;
+    ruConf.exp_payload = 0x40;
+    ruConf.delay = 10;
+    ruConf.retry_cnt = MFRC522_DRV_RETRY_CNT_INF;
+    ruConf.max_delay = 80;
+    ruConf.timeout = 1000;
+
+    u32 start = chip.clock;
+    auto status = mfrc522_drv_read_until(&conf, &ruConf);
+    ASSERT_EQ(mfrc522_drv_status_dev_rtr_err, status);
+    ASSERT_LT(0U, chip.clockCalls);
+
+    u32 elapsed = chip.clock - start;
+    ASSERT_LE(ruConf.timeout, elapsed);
+    ASSERT_GE(ruConf.timeout + ruConf.max_delay + 2 * chip.readCost, elapsed);
+}
+
+TEST(TestMfrc522DrvPollPolicy, mfrc522_drv_read_until__NoClock__DelaysSummedUp)
+{
+    TimedChip chip;
+    auto conf = initDriver(&chip, SimulatedChip::ops(false));
+
+    auto ruConf = idleConf(100);
+    ruConf.timeout = 1000;
+    chip.latency[mfrc522_reg_cmd_mem] = 1000000;
+    EXPECT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write_byte(&conf, mfrc522_reg_command, mfrc522_reg_cmd_mem));
+
+    auto status = mfrc522_drv_read_until(&conf, &ruConf);
+    ASSERT_EQ(mfrc522_drv_status_dev_rtr_err, status);
+    ASSERT_EQ(0U, chip.clockCalls);
+    ASSERT_EQ(11U, chip.reads[mfrc522_reg_command]);
+}
+
+TEST(TestMfrc522DrvPollPolicy, mfrc522_drv_soft_reset__TypicalLatency__SingleRead)
+{
+    TimedChip chip;
+    auto conf = initDriver(&chip);
+
+    auto status = mfrc522_drv_soft_reset(&conf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(1U, chip.reads[mfrc522_reg_command]);
+}
+
+TEST(TestMfrc522DrvPollPolicy, mfrc522_drv_crc_compute__TypicalLatency__FewReads)
+{
+    TimedChip chip;
+    auto conf = initDriver(&chip);
+
+    u16 crc;
+    auto status = mfrc522_drv_crc_compute(&conf, &crc);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_GE(3U, chip.reads[mfrc522_reg_status1]);
+}
+
+TEST(TestMfrc522DrvPollPolicy, mfrc522_drv_soft_reset__SlowDevice__BudgetUsedInsteadOfRetries)
+{
+    TimedChip chip;
+    chip.latency[mfrc522_reg_cmd_soft_reset] = MFRC522_CONF_DEADLINE_SOFT_RESET - 500;
+    auto conf = initDriver(&chip);
+
+    auto status = mfrc522_drv_soft_reset(&conf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+}
+
+TEST(TestMfrc522DrvPollPolicy, mfrc522_drv_soft_reset__DeviceNotResponding__BudgetExhausted)
+{
+    TimedChip chip;
+    chip.latency[mfrc522_reg_cmd_soft_reset] = 10 * MFRC522_CONF_DEADLINE_SOFT_RESET;
+    auto conf = initDriver(&chip);
+
+    u32 start = chip.clock;
+    auto status = mfrc522_drv_soft_reset(&conf);
+    ASSERT_EQ(mfrc522_drv_status_dev_rtr_err, status);
+    ASSERT_LE(static_cast<u32>(MFRC522_CONF_DEADLINE_SOFT_RESET), chip.clock - start);
+    ASSERT_GT(static_cast<u32>(2 * MFRC522_CONF_DEADLINE_SOFT_RESET), chip.clock - start);
+}
+
+TEST(TestMfrc522DrvPollPolicy, mfrc522_drv_transceive_poll__NoCard__TimedOutAfterBudget)
+{
+    TimedChip chip;
+    auto conf = initDriver(&chip);
+
+    u8 tx = 0x26;
+    mfrc522_drv_transceive_conf trConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    trConf.tx_data = &tx;
+    trConf.tx_data_sz = 1;
+    trConf.rx_data = nullptr;
+    trConf.rx_data_sz = 0;
+    trConf.command = mfrc522_reg_cmd_transceive;
+
+    mfrc522_drv_transceive_op op;
+    auto status = mfrc522_drv_transceive_start(&conf, &op, &trConf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+
+    u32 start = chip.clock;
+    while (mfrc522_drv_status_in_progress == (status = mfrc522_drv_transceive_poll(&conf, &op))) {
+        chip.clock += op.poll_delay;
+    }
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+    ASSERT_EQ(mfrc522_drv_status_transceive_timeout, op.result);
+
+    /* The number of polls does not matter, only the time does */
+    ASSERT_LT(op.poll_limit, op.polls);
+    ASSERT_LE(static_cast<u32>(MFRC522_CONF_DEADLINE_TRANSCEIVE), chip.clock - start);
+    ASSERT_EQ(mfrc522_drv_status_transceive_timeout, mfrc522_drv_transceive_finish(&conf, &op));
+}
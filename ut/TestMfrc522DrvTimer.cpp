@@ -17,7 +17,7 @@ TEST(TestMfrc522DrvTimer, mfrc522_drv_tim_set__NullCases)
 
 TEST(TestMfrc522DrvTimer, mfrc522_drv_tim_set__PeriodEqualsToZero__Failure)
 {
-    mfrc522_drv_tim_conf conf;
+    mfrc522_drv_tim_conf conf = MFRC522_DRV_TIM_CONF_DEFAULT;
 
     auto status = mfrc522_drv_tim_set(&conf, 0);
     ASSERT_EQ(mfrc522_drv_status_tim_prd_err, status);
@@ -25,7 +25,7 @@ TEST(TestMfrc522DrvTimer, mfrc522_drv_tim_set__PeriodEqualsToZero__Failure)
 
 TEST(TestMfrc522DrvTimer, mfrc522_drv_tim_set__PeriodTooLong__Failure)
 {
-    mfrc522_drv_tim_conf conf;
+    mfrc522_drv_tim_conf conf = MFRC522_DRV_TIM_CONF_DEFAULT;
 
     auto status = mfrc522_drv_tim_set(&conf, MFRC522_DRV_TIM_MAX_PERIOD + 1);
     ASSERT_EQ(mfrc522_drv_status_tim_prd_err, status);
@@ -48,7 +48,7 @@ TEST(TestMfrc522DrvTimer, mfrc522_drv_tim_set__Periods__Success)
     };
 
     for (const auto& row : testData) {
-        mfrc522_drv_tim_conf conf;
+        mfrc522_drv_tim_conf conf = MFRC522_DRV_TIM_CONF_DEFAULT;
         auto status = mfrc522_drv_tim_set(&conf, row.first);
         ASSERT_EQ(mfrc522_drv_status_ok, status);
         ASSERT_EQ(1694, conf.prescaler);
@@ -60,7 +60,7 @@ TEST(TestMfrc522DrvTimer, mfrc522_drv_tim_set__Periods__Success)
 TEST(TestMfrc522DrvTimer, mfrc522_drv_tim_start__NullCases)
 {
     mfrc522_drv_conf conf;
-    mfrc522_drv_tim_conf timConf;
+    mfrc522_drv_tim_conf timConf = MFRC522_DRV_TIM_CONF_DEFAULT;
 
     auto status = mfrc522_drv_tim_start(nullptr, &timConf);
     ASSERT_EQ(mfrc522_drv_status_nullptr, status);
@@ -73,7 +73,7 @@ TEST(TestMfrc522DrvTimer, mfrc522_drv_tim_start__TypicalCase__TimerStarted)
 {
     auto conf = initDevice();
 
-    mfrc522_drv_tim_conf timerConf;
+    mfrc522_drv_tim_conf timerConf = MFRC522_DRV_TIM_CONF_DEFAULT;
     timerConf.prescaler_type = mfrc522_drv_tim_psl_odd;
     timerConf.prescaler = 0xFABC;
     timerConf.reload_val = 0x0CA0;
@@ -82,17 +82,47 @@ TEST(TestMfrc522DrvTimer, mfrc522_drv_tim_start__TypicalCase__TimerStarted)
     /* Fill low-level calls */
     MOCK(mfrc522_ll_send);
     InSequence s;
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_tim_prescaler, 1, Pointee(0xBC))
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_tim_prescaler, 1, Pointee(0xBC))
         .WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_tim_mode, 1, Pointee(0x0A))
+    /* Prescaler Hi and periodicity flag are written at once */
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_tim_mode, 1, Pointee(0x1A))
         .WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_demod, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_tim_reload_lo, 1, Pointee(0xA0))
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_demod, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_tim_reload_lo, 1, Pointee(0xA0))
         .WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_tim_reload_hi, 1, Pointee(0x0C))
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_tim_reload_hi, 1, Pointee(0x0C))
         .WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_tim_mode, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_control, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_control, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
+
+    auto status = mfrc522_drv_tim_start(&conf, &timerConf);
+    ASSERT_EQ(mfrc522_drv_status_ok, status);
+}
+
+TEST(TestMfrc522DrvTimer, mfrc522_drv_tim_start__AutoStart__TimerNotStartedImmediately)
+{
+    auto conf = initDevice();
+
+    mfrc522_drv_tim_conf timerConf = MFRC522_DRV_TIM_CONF_DEFAULT;
+    timerConf.prescaler_type = mfrc522_drv_tim_psl_odd;
+    timerConf.prescaler = 0xFABC;
+    timerConf.reload_val = 0x0CA0;
+    timerConf.periodic = false;
+    timerConf.auto_start = true;
+
+    /* Fill low-level calls */
+    MOCK(mfrc522_ll_send);
+    InSequence s;
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_tim_prescaler, 1, Pointee(0xBC))
+        .WillOnce(Return(mfrc522_ll_status_ok));
+    /* Prescaler Hi and automatic start flag are written at once */
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_tim_mode, 1, Pointee(0x8A))
+        .WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_demod, 1, NotNull()).WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_tim_reload_lo, 1, Pointee(0xA0))
+        .WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_tim_reload_hi, 1, Pointee(0x0C))
+        .WillOnce(Return(mfrc522_ll_status_ok));
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_control, _, _).Times(0);
 
     auto status = mfrc522_drv_tim_start(&conf, &timerConf);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -110,7 +140,7 @@ TEST(TestMfrc522DrvTimer, mfrc522_drv_tim_stop__TimerStopped)
 
     /* Set expectations */
     MOCK(mfrc522_ll_send);
-    MOCK_CALL(mfrc522_ll_send, mfrc522_reg_control, 1, _).WillOnce(Return(mfrc522_ll_status_ok));;
+    MOCK_CALL(mfrc522_ll_send, _, mfrc522_reg_control, 1, _).WillOnce(Return(mfrc522_ll_status_ok));;
 
     auto status = mfrc522_drv_tim_stop(&conf);
     ASSERT_EQ(mfrc522_drv_status_ok, status);
@@ -0,0 +1,1297 @@
+#include "mfrc522_drv.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "common/SimulatedChip.h"
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Private classes -------------------- */
+/* ------------------------------------------------------------ */
+
+/*
+ * MFRC522 with a MIFARE Classic card emulated at register level. A frame sent to the card is answered after a given
+ * number of ComIrqReg reads, which makes it possible to observe intermediate states of non-blocking operations.
+ */
+class CardChip : public SimulatedChip
+{
+public:
+    CardChip()
+    {
+        u16 crc = crcA(ats);
+        ats.push_back(crc & 0xFF);
+        ats.push_back(crc >> 8);
+    }
+
+    std::vector<u8> lastFrame; /* The last frame sent to the card */
+    u8 lastBitFraming = 0; /* Value of BitFramingReg used to send the last frame */
+    bool cardPresent = true;
+    bool collision = false; /* Set to raise ErrIRq instead of a response */
+    bool badCrc = false; /* Set to corrupt CRC_A of responses */
+    bool recvLost = false; /* Set to make receive calls fail once a frame is sent */
+    bool sendLost = false; /* Set to make send calls fail once a frame is sent */
+    size latency = 3; /* Number of ComIrqReg reads after which the card responds */
+    u8 serial[4] = {0xDE, 0xAD, 0xBE, 0xEF};
+    std::vector<u8> uid; /* Double or triple size UID. Single size UID is taken from 'serial' if empty */
+    u8 sak = 0x08; /* SAK returned at the last cascade level */
+    size frames = 0; /* Number of frames sent to the card */
+    std::vector<u8> ats = {0x05, 0x78, 0x80, 0x70, 0x02}; /* ATS. CRC is appended on construction */
+
+    /* A PICC of a multi-card field. Cascade level is the one a READY card expects next */
+    enum class CardState { idle, ready, active, halt };
+    struct Card
+    {
+        std::vector<u8> uid;
+        u8 sak;
+        CardState state;
+        int level;
+    };
+    std::vector<Card> cards; /* PICCs in RF field. If empty, a single card described above is emulated */
+
+    void addCard(const std::vector<u8>& cardUid, u8 cardSak = 0x08)
+    {
+        cards.push_back({cardUid, cardSak, CardState::idle, 0});
+    }
+
+private:
+    /* CRC_A as defined in ISO/IEC 14443-3 */
+    static u16 crcA(const std::vector<u8>& data)
+    {
+        u16 crc = 0x6363;
+        for (u8 byte : data) {
+            byte ^= crc & 0xFF;
+            byte ^= byte << 4;
+            crc = (crc >> 8) ^ (byte << 8) ^ (byte << 3) ^ (byte >> 4);
+        }
+        return crc;
+    }
+
+    void write(u8 addr, u8 val) override
+    {
+        SimulatedChip::write(addr, val);
+        if (mfrc522_reg_command == addr) {
+            execute(val & 0x0F);
+        }
+    }
+
+    u8 read(u8 addr) override
+    {
+        if (mfrc522_reg_com_irq == addr && pending && 0 == --pollsLeft) {
+            respond();
+        }
+        return SimulatedChip::read(addr);
+    }
+
+    void execute(u8 cmd)
+    {
+        if (mfrc522_reg_cmd_crc == cmd) {
+            u16 crc = crcA(std::vector<u8>(fifo.begin(), fifo.end()));
+            fifo.clear();
+            regs[mfrc522_reg_crc_result_lsb] = crc & 0xFF;
+            regs[mfrc522_reg_crc_result_msb] = crc >> 8;
+            regs[mfrc522_reg_status1] |= 1 << 5;
+        } else if (mfrc522_reg_cmd_authent == cmd) {
+            transmit();
+        } else if (mfrc522_reg_cmd_idle == cmd) {
+            pending = false;
+        }
+    }
+
+    void transmit() override
+    {
+        lastFrame.assign(fifo.begin(), fifo.end());
+        lastBitFraming = regs[mfrc522_reg_bit_framing];
+        fifo.clear();
+        regs[mfrc522_reg_error] = 0x00;
+        regs[mfrc522_reg_coll] = 0x20;
+        if (regs[mfrc522_reg_tx_mode] & 0x80) {
+            u16 crc = crcA(lastFrame);
+            lastFrame.push_back(crc & 0xFF);
+            lastFrame.push_back(crc >> 8);
+        }
+        pending = true;
+        pollsLeft = latency;
+        ++frames;
+        recvFails = recvFails || recvLost;
+        sendFails = sendFails || sendLost;
+    }
+
+    void respond()
+    {
+        pending = false;
+        rxLastBits = 0;
+        collPos = 0;
+        std::vector<u8> response;
+        if (!cardPresent) {
+            state = CardState::idle; /* The card left RF field */
+        }
+        if (cardPresent && !collision) {
+            if (mfrc522_reg_cmd_authent == (regs[mfrc522_reg_command] & 0x0F)) {
+                regs[mfrc522_reg_status2] |= 1 << 3;
+                regs[mfrc522_reg_com_irq] |= 1 << mfrc522_reg_irq_idle;
+                return;
+            }
+            response = cards.empty() ? answer() : answerCards();
+        }
+
+        if (!response.empty() && badCrc) {
+            response.back() ^= 0xFF;
+        }
+        if (response.size() > 2 && (regs[mfrc522_reg_rx_mode] & 0x80)) {
+            /* CRC_A is verified and stripped by the chip */
+            std::vector<u8> data(response.begin(), response.end() - 2);
+            u16 crc = crcA(data);
+            if ((crc & 0xFF) != response[response.size() - 2] || (crc >> 8) != response.back()) {
+                regs[mfrc522_reg_error] |= 1 << 2;
+                regs[mfrc522_reg_com_irq] |= 1 << mfrc522_reg_irq_err;
+                return;
+            }
+            response = data;
+        }
+
+        if (collPos) {
+            /* Bits received up to the collision are left in FIFO. Position out of CollPos range is not valid */
+            fifo.assign(response.begin(), response.end());
+            regs[mfrc522_reg_control] = (regs[mfrc522_reg_control] & ~0x07) | rxLastBits;
+            regs[mfrc522_reg_error] |= 1 << 3;
+            regs[mfrc522_reg_coll] = (collPos > 32) ? 0x20 : (collPos & 0x1F);
+            regs[mfrc522_reg_com_irq] |= 1 << mfrc522_reg_irq_err;
+        } else if (collision) {
+            regs[mfrc522_reg_com_irq] |= 1 << mfrc522_reg_irq_err;
+        } else if (response.empty()) {
+            regs[mfrc522_reg_com_irq] |= 1 << mfrc522_reg_irq_timer;
+        } else {
+            fifo.assign(response.begin(), response.end());
+            regs[mfrc522_reg_control] = (regs[mfrc522_reg_control] & ~0x07) | rxLastBits;
+            regs[mfrc522_reg_com_irq] |= (1 << mfrc522_reg_irq_rx) | (1 << mfrc522_reg_irq_idle);
+        }
+    }
+
+    /* Card response to the last frame. Empty if the card stays silent */
+    std::vector<u8> answer()
+    {
+        bool request = (mfrc522_picc_cmd_reqa == lastFrame[0]) || (mfrc522_picc_cmd_wupa == lastFrame[0]);
+        if (lastFrame.size() == 1 && request && 0x07 == (lastBitFraming & 0x07)) {
+            /* REQA and WUPA are answered only if sent as a short frame */
+            bool answered = wakeUp(&state, mfrc522_picc_cmd_wupa == lastFrame[0]);
+            return answered ? std::vector<u8>{0x04, 0x00} : std::vector<u8>{};
+        }
+        if (lastFrame.size() == 4 && 0x50 == lastFrame[0] && 0x00 == lastFrame[1]) {
+            state = (CardState::active == state) ? CardState::halt : CardState::idle;
+            return {}; /* HLTA is never answered */
+        }
+        int level = (lastFrame.size() >= 2) ? cascadeLevel(lastFrame[0]) : -1;
+        if (level >= 0 && lastFrame[1] > 0x20 && lastFrame[1] < 0x70) {
+            /* Bit oriented anticollision frame. The rest of UID CLn is sent starting with the first unknown bit */
+            size known = ((lastFrame[1] >> 4) - 2) * 8 + (lastFrame[1] & 0x0F);
+            std::vector<u8> cl = uidCl(level);
+            std::vector<u8> rest(cl.begin() + known / 8, cl.end());
+            rest[0] &= static_cast<u8>(0xFF << (known % 8));
+            return rest;
+        }
+        if (lastFrame.size() == 4 && 0xE0 == lastFrame[0]) {
+            return ats; /* RATS */
+        }
+        if (lastFrame.size() == 8 && 0xA2 == lastFrame[0]) {
+            rxLastBits = 4; /* WRITE is answered with 4-bit ACK */
+            return {0x0A};
+        }
+        if (level >= 0 && lastFrame.size() == 2 && 0x20 == lastFrame[1]) {
+            return uidCl(level);
+        }
+        if (level >= 0 && lastFrame.size() == 9 && 0x70 == lastFrame[1]) {
+            std::vector<u8> cl = uidCl(level);
+            if (cl.empty() || !std::equal(cl.begin(), cl.end(), lastFrame.begin() + 2)) {
+                return {}; /* Only the card with matching UID CLn answers */
+            }
+            bool last = (fullUid().size() == static_cast<size>(level) * 3 + 4);
+            state = last ? CardState::active : state;
+            std::vector<u8> response = {last ? sak : static_cast<u8>(0x04)};
+            u16 crc = crcA(response);
+            response.push_back(crc & 0xFF);
+            response.push_back(crc >> 8);
+            return response;
+        }
+        return {};
+    }
+
+    /* Response of all PICCs in a multi-card field to the last frame. Differing bits of responses make a collision */
+    std::vector<u8> answerCards()
+    {
+        bool request = (mfrc522_picc_cmd_reqa == lastFrame[0]) || (mfrc522_picc_cmd_wupa == lastFrame[0]);
+        if (lastFrame.size() == 1 && request && 0x07 == (lastBitFraming & 0x07)) {
+            bool wupa = (mfrc522_picc_cmd_wupa == lastFrame[0]);
+            bool any = false;
+            for (Card& card : cards) {
+                if (wakeUp(&card.state, wupa)) {
+                    card.level = 0;
+                    any = true;
+                }
+            }
+            return any ? std::vector<u8>{0x04, 0x00} : std::vector<u8>{};
+        }
+        if (lastFrame.size() == 4 && 0x50 == lastFrame[0] && 0x00 == lastFrame[1]) {
+            for (Card& card : cards) {
+                card.state = (CardState::active == card.state) ? CardState::halt :
+                             (CardState::ready == card.state) ? CardState::idle : card.state;
+            }
+            return {}; /* HLTA is never answered */
+        }
+
+        int level = (lastFrame.size() >= 2) ? cascadeLevel(lastFrame[0]) : -1;
+        if (level < 0) {
+            return {};
+        }
+        if (lastFrame.size() == 9 && 0x70 == lastFrame[1]) {
+            std::vector<u8> response;
+            for (Card& card : cards) {
+                if (CardState::ready != card.state || card.level != level) {
+                    continue;
+                }
+                std::vector<u8> cl = uidCl(card.uid, level);
+                if (!std::equal(cl.begin(), cl.end(), lastFrame.begin() + 2)) {
+                    card.state = CardState::idle; /* Not selected cards leave READY state */
+                    continue;
+                }
+                bool last = (card.uid.size() == static_cast<size>(level) * 3 + 4);
+                card.state = last ? CardState::active : CardState::ready;
+                card.level = level + 1;
+                response = {last ? card.sak : static_cast<u8>(0x04)};
+            }
+            if (!response.empty()) {
+                u16 crc = crcA(response);
+                response.push_back(crc & 0xFF);
+                response.push_back(crc >> 8);
+            }
+            return response;
+        }
+        if (lastFrame[1] < 0x20 || lastFrame[1] >= 0x70) {
+            return {};
+        }
+
+        /* ANTICOLLISION is answered by READY cards matching the known bits of UID CLn */
+        size known = ((lastFrame[1] >> 4) - 2) * 8 + (lastFrame[1] & 0x0F);
+        std::vector<u8> sent(lastFrame.begin() + 2, lastFrame.end());
+        std::vector<std::vector<u8>> answers;
+        for (const Card& card : cards) {
+            if (CardState::ready != card.state || card.level != level) {
+                continue;
+            }
+            std::vector<u8> cl = uidCl(card.uid, level);
+            bool match = true;
+            for (size bit = 0; bit < known && match; ++bit) {
+                match = (bitOf(cl, bit) == bitOf(sent, bit));
+            }
+            if (match) {
+                answers.push_back(cl);
+            }
+        }
+        if (answers.empty()) {
+            return {};
+        }
+
+        std::vector<u8> cl = answers[0];
+        size coll = 40;
+        for (size bit = known; bit < 40 && 40 == coll; ++bit) {
+            for (const std::vector<u8>& other : answers) {
+                coll = (bitOf(other, bit) != bitOf(cl, bit)) ? bit : coll;
+            }
+        }
+        if (coll < 40) {
+            /* The collided bit and the following ones are received as zeros */
+            cl[coll / 8] &= static_cast<u8>((1 << (coll % 8)) - 1);
+            cl.resize(coll / 8 + 1);
+            collPos = coll - known + 1;
+            rxLastBits = (coll + 1) % 8;
+        }
+        std::vector<u8> rest(cl.begin() + known / 8, cl.end());
+        rest[0] &= static_cast<u8>(0xFF << (known % 8));
+        return rest;
+    }
+
+    /*
+     * State transition of a PICC on REQA or WUPA. Returns true if the PICC answers. A READY or ACTIVE PICC takes the
+     * frame as an unexpected one and goes back to IDLE state without answering
+     */
+    static bool wakeUp(CardState* cardState, bool wupa)
+    {
+        if (CardState::ready == *cardState || CardState::active == *cardState) {
+            *cardState = CardState::idle;
+            return false;
+        }
+        if (CardState::halt == *cardState && !wupa) {
+            return false;
+        }
+        *cardState = CardState::ready;
+        return true;
+    }
+
+    /* Bits are sent LSB first */
+    static bool bitOf(const std::vector<u8>& data, size bit)
+    {
+        return (data[bit / 8] >> (bit % 8)) & 0x01;
+    }
+
+    /* Cascade level (0 for CL1) of ANTICOLLISION and SELECT frames or -1 for other frames */
+    static int cascadeLevel(u8 sel)
+    {
+        return (0x93 == sel || 0x95 == sel || 0x97 == sel) ? (sel - 0x93) / 2 : -1;
+    }
+
+    std::vector<u8> fullUid() const
+    {
+        return uid.empty() ? std::vector<u8>(std::begin(serial), std::end(serial)) : uid;
+    }
+
+    std::vector<u8> uidCl(int level) const
+    {
+        return uidCl(fullUid(), level);
+    }
+
+    /* UID CLn followed by BCC. Empty if UID is complete at lower cascade levels */
+    static std::vector<u8> uidCl(const std::vector<u8>& full, int level)
+    {
+        size offset = static_cast<size>(level) * 3;
+        std::vector<u8> cl;
+        if (full.size() == offset + 4) {
+            cl.assign(full.begin() + offset, full.end());
+        } else if (full.size() > offset + 4) {
+            cl = {0x88, full[offset], full[offset + 1], full[offset + 2]};
+        } else {
+            return {};
+        }
+        cl.push_back(cl[0] ^ cl[1] ^ cl[2] ^ cl[3]);
+        return cl;
+    }
+
+    CardState state = CardState::idle; /* State of the single card */
+    bool pending = false;
+    size pollsLeft = 0;
+    u8 rxLastBits = 0;
+    size collPos = 0; /* Position of the first collided bit counted from the first received one or 0 */
+};
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+static mfrc522_drv_conf initDriver(CardChip* chip)
+{
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = SimulatedChip::ops(false);
+    conf.ll_ctx = chip;
+    conf.atqa_verify_fn = nullptr;
+    EXPECT_EQ(mfrc522_drv_status_ok, mfrc522_drv_init(&conf));
+    return conf;
+}
+
+/* Transceive configuration of REQA command */
+static mfrc522_drv_transceive_conf reqaConf(u8* tx, u8* rx, u16 timeout)
+{
+    mfrc522_drv_transceive_conf trConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    tx[0] = mfrc522_picc_cmd_reqa;
+    trConf.tx_data = tx;
+    trConf.tx_data_sz = 1;
+    trConf.rx_data = rx;
+    trConf.rx_data_sz = 2;
+    trConf.command = mfrc522_reg_cmd_transceive;
+    trConf.timeout = timeout;
+    trConf.tx_last_bits = 7;
+    return trConf;
+}
+
+/* Poll an operation until it is done. Returns the number of polls which reported the operation in progress */
+static size pollUntilDone(const mfrc522_drv_conf* conf, mfrc522_drv_transceive_op* op)
+{
+    size inProgress = 0;
+    mfrc522_drv_status status;
+    while (mfrc522_drv_status_in_progress == (status = mfrc522_drv_transceive_poll(conf, op))) {
+        ++inProgress;
+    }
+    EXPECT_EQ(mfrc522_drv_status_ok, status);
+    return inProgress;
+}
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Test cases ------------------------ */
+/* ------------------------------------------------------------ */
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive_poll__NullCases)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_transceive_op op = {};
+    u8 tx, rx[2];
+    auto trConf = reqaConf(&tx, rx, 0);
+
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_transceive_start(nullptr, &op, &trConf));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_transceive_start(&conf, nullptr, &trConf));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_transceive_start(&conf, &op, nullptr));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_transceive_poll(nullptr, &op));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_transceive_poll(&conf, nullptr));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_transceive_finish(nullptr, &op));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_transceive_finish(&conf, nullptr));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive_poll__NotStarted__Failure)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_transceive_op op = {};
+
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_transceive_poll(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_transceive_finish(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_transceive_state_idle, op.state);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive_start__InvalidCommand__OperationNotStarted)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_transceive_op op = {};
+    u8 tx, rx[2];
+    auto trConf = reqaConf(&tx, rx, 0);
+    trConf.command = mfrc522_reg_cmd_mem;
+
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_transceive_start(&conf, &op, &trConf));
+    ASSERT_EQ(mfrc522_drv_transceive_state_idle, op.state);
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_transceive_poll(&conf, &op));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive__TypicalCase__AllStatesVisited)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_transceive_op op = {};
+    u8 tx, rx[2] = {};
+    auto trConf = reqaConf(&tx, rx, 0);
+
+    /* Idle -> busy */
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_start(&conf, &op, &trConf));
+    ASSERT_EQ(mfrc522_drv_transceive_state_busy, op.state);
+    ASSERT_EQ(std::vector<u8>{mfrc522_picc_cmd_reqa}, chip.lastFrame);
+
+    /* Busy -> busy. Finish is not allowed until the command completes */
+    for (size i = 0; i < chip.latency - 1; ++i) {
+        ASSERT_EQ(mfrc522_drv_status_in_progress, mfrc522_drv_transceive_poll(&conf, &op));
+        ASSERT_EQ(mfrc522_drv_transceive_state_busy, op.state);
+    }
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_transceive_finish(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_transceive_state_busy, op.state);
+
+    /* Busy -> done. Subsequent polls do not touch the device */
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_poll(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_transceive_state_done, op.state);
+    chip.recvFails = true;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_poll(&conf, &op));
+    chip.recvFails = false;
+
+    /* Done -> idle */
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_finish(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_transceive_state_idle, op.state);
+    ASSERT_EQ(0x04, rx[0]);
+    ASSERT_EQ(0x00, rx[1]);
+    ASSERT_EQ(mfrc522_reg_cmd_idle, chip.regs[mfrc522_reg_command] & 0x0F);
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_transceive_finish(&conf, &op));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive_poll__NoCardWithoutTimer__DoneAfterPollLimit)
+{
+    CardChip chip;
+    chip.cardPresent = false;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_transceive_op op = {};
+    u8 tx, rx[2];
+    auto trConf = reqaConf(&tx, rx, 0);
+
+    /* TimerIRq is not awaited when the timeout is not set */
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_start(&conf, &op, &trConf));
+    ASSERT_EQ(op.poll_limit - 1, pollUntilDone(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_status_transceive_timeout, mfrc522_drv_transceive_finish(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_transceive_state_idle, op.state);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive_poll__NoCardWithTimer__DoneOnTimerIrq)
+{
+    CardChip chip;
+    chip.cardPresent = false;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_transceive_op op = {};
+    u8 tx, rx[2];
+    auto trConf = reqaConf(&tx, rx, MFRC522_DRV_FWT_ISO14443_3);
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_start(&conf, &op, &trConf));
+    ASSERT_EQ(chip.latency - 1, pollUntilDone(&conf, &op));
+    ASSERT_LT(chip.latency, op.poll_limit);
+    ASSERT_EQ(mfrc522_drv_status_transceive_timeout, mfrc522_drv_transceive_finish(&conf, &op));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive_poll__ErrorIrq__TransceiveErrorReturned)
+{
+    CardChip chip;
+    chip.collision = true;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_transceive_op op = {};
+    u8 tx, rx[2];
+    auto trConf = reqaConf(&tx, rx, MFRC522_DRV_FWT_ISO14443_3);
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_start(&conf, &op, &trConf));
+    pollUntilDone(&conf, &op);
+    ASSERT_EQ(mfrc522_drv_status_transceive_err, mfrc522_drv_transceive_finish(&conf, &op));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive_poll__LlError__OperationDone)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_transceive_op op = {};
+    u8 tx, rx[2];
+    auto trConf = reqaConf(&tx, rx, 0);
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_start(&conf, &op, &trConf));
+    chip.recvFails = true;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, mfrc522_drv_transceive_poll(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_transceive_state_done, op.state);
+
+    /* The command is still terminated and the error is reported once again */
+    chip.recvFails = false;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, mfrc522_drv_transceive_finish(&conf, &op));
+    ASSERT_EQ(mfrc522_reg_cmd_idle, chip.regs[mfrc522_reg_command] & 0x0F);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive__Blocking__SameResultAsNonBlocking)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    u8 tx, rx[2] = {};
+    auto trConf = reqaConf(&tx, rx, MFRC522_DRV_FWT_ISO14443_3);
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive(&conf, &trConf));
+    ASSERT_EQ(0x04, rx[0]);
+    ASSERT_EQ(0x00, rx[1]);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_reqa_finish__NoCard__InvalidAtqa)
+{
+    CardChip chip;
+    chip.cardPresent = false;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_transceive_op op = {};
+    u16 atqa = 0;
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_reqa_start(&conf, &op));
+    pollUntilDone(&conf, &op);
+    ASSERT_EQ(mfrc522_drv_status_transceive_timeout, mfrc522_drv_reqa_finish(&conf, &op, &atqa));
+    ASSERT_EQ(MFRC522_PICC_ATQA_INV, atqa);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_picc_ops__NotDone__Failure)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_transceive_op op = {};
+    u16 atqa = 0;
+    u8 serial[5];
+    u8 sak;
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_reqa_start(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_reqa_finish(&conf, &op, &atqa));
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_anticollision_finish(&conf, &op, serial));
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_select_finish(&conf, &op, &sak));
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_authenticate_finish(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_halt_finish(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_transceive_state_busy, op.state);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_picc_ops__TwoReaders__InterleavedOnSingleThread)
+{
+    CardChip chips[2];
+    chips[1].latency = 7;
+    chips[1].serial[0] = 0x01;
+    mfrc522_drv_conf confs[] = {initDriver(&chips[0]), initDriver(&chips[1])};
+    mfrc522_drv_transceive_op ops[2] = {};
+
+    /* Drive both readers at once until all operations are done */
+    auto runAll = [&]() {
+        bool busy = true;
+        while (busy) {
+            busy = false;
+            for (size i = 0; i < SIZE_ARRAY(ops); ++i) {
+                auto status = mfrc522_drv_transceive_poll(&confs[i], &ops[i]);
+                ASSERT_TRUE(mfrc522_drv_status_ok == status || mfrc522_drv_status_in_progress == status);
+                busy |= (mfrc522_drv_status_in_progress == status);
+            }
+        }
+    };
+
+    /* REQA */
+    u16 atqa[2];
+    for (size i = 0; i < SIZE_ARRAY(ops); ++i) {
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_reqa_start(&confs[i], &ops[i]));
+    }
+    runAll();
+    for (size i = 0; i < SIZE_ARRAY(ops); ++i) {
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_reqa_finish(&confs[i], &ops[i], &atqa[i]));
+        ASSERT_EQ(0x0004, atqa[i]);
+    }
+
+    /* Anticollision */
+    u8 serial[2][5];
+    for (size i = 0; i < SIZE_ARRAY(ops); ++i) {
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_anticollision_start(&confs[i], &ops[i]));
+    }
+    runAll();
+    for (size i = 0; i < SIZE_ARRAY(ops); ++i) {
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_anticollision_finish(&confs[i], &ops[i], serial[i]));
+        ASSERT_EQ(0, memcmp(chips[i].serial, serial[i], 4));
+    }
+
+    /* Select */
+    u8 sak[2];
+    for (size i = 0; i < SIZE_ARRAY(ops); ++i) {
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_select_start(&confs[i], &ops[i], serial[i]));
+    }
+    runAll();
+    for (size i = 0; i < SIZE_ARRAY(ops); ++i) {
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_select_finish(&confs[i], &ops[i], &sak[i]));
+        ASSERT_EQ(0x08, sak[i]);
+    }
+
+    /* Authenticate */
+    u8 key[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    for (size i = 0; i < SIZE_ARRAY(ops); ++i) {
+        mfrc522_drv_auth_conf authConf;
+        authConf.serial = serial[i];
+        authConf.sector = mfrc522_picc_sector1;
+        authConf.block = mfrc522_picc_block0;
+        authConf.key_type = mfrc522_picc_key_a;
+        authConf.key = key;
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_authenticate_start(&confs[i], &ops[i], &authConf));
+    }
+    runAll();
+    for (size i = 0; i < SIZE_ARRAY(ops); ++i) {
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_authenticate_finish(&confs[i], &ops[i]));
+        ASSERT_EQ(12U, chips[i].lastFrame.size());
+    }
+
+    /* Halt. The card does not respond, which is a success */
+    for (size i = 0; i < SIZE_ARRAY(ops); ++i) {
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_halt_start(&confs[i], &ops[i]));
+    }
+    runAll();
+    for (size i = 0; i < SIZE_ARRAY(ops); ++i) {
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_halt_finish(&confs[i], &ops[i]));
+        ASSERT_EQ(0x00, chips[i].regs[mfrc522_reg_status2] & (1 << 3));
+    }
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_select__SoftwareCrc__FewerBusTransactions)
+{
+    /* Select and halt the same card with CRC computed by the coprocessor and in software */
+    size transactions[2];
+    for (size i = 0; i < SIZE_ARRAY(transactions); ++i) {
+        CardChip chip;
+        auto conf = initDriver(&chip);
+        conf.crc_mode = (1 == i) ? mfrc522_drv_crc_mode_sw : mfrc522_drv_crc_mode_coproc;
+
+        u8 serial[5] = {chip.serial[0], chip.serial[1], chip.serial[2], chip.serial[3],
+                        static_cast<u8>(chip.serial[0] ^ chip.serial[1] ^ chip.serial[2] ^ chip.serial[3])};
+        u8 sak;
+        chip.transactions = 0;
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_select(&conf, serial, &sak));
+        ASSERT_EQ(0x08, sak);
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_halt(&conf));
+        transactions[i] = chip.transactions;
+        RecordProperty(mfrc522_drv_crc_mode_sw == conf.crc_mode ? "SoftwareCrcTransactions"
+                                                                 : "CoprocessorCrcTransactions",
+                       static_cast<int>(transactions[i]));
+    }
+
+    /* Three CRCs computed in software, each one saves at least 8 transactions */
+    ASSERT_LE(transactions[1] + 3 * 8, transactions[0]);
+
+    /*
+     * Software CRC costs CPU time instead. It is only reported next to the fastest bus for comparison, since wall-clock
+     * time depends on the host: a single register access over SPI clocked at 10 Mbit/s takes 2 bytes, i.e. 1.6 us
+     */
+    const u8 frame[] = {0x93, 0x70, 0xDE, 0xAD, 0xBE, 0xEF, 0x22}; /* SELECT without CRC */
+    const size rounds = 100000;
+    volatile u16 sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size i = 0; i < rounds; ++i) {
+        sink = sink ^ mfrc522_picc_crc_a(frame, SIZE_ARRAY(frame));
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    const i64 busTransactionNs = 1600;
+    i64 crcNs = elapsed.count() / static_cast<i64>(rounds);
+    RecordProperty("SoftwareCrcNsPerFrame", static_cast<int>(crcNs));
+    RecordProperty("BusTransactionNs", static_cast<int>(busTransactionNs));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_select__HardwareCrc__FramesProtectedByChip)
+{
+    /* Select and halt the same card with CRC computed by the coprocessor and appended by the chip on the fly */
+    size transactions[2];
+    for (size i = 0; i < SIZE_ARRAY(transactions); ++i) {
+        CardChip chip;
+        auto conf = initDriver(&chip);
+        conf.crc_mode = (1 == i) ? mfrc522_drv_crc_mode_hw : mfrc522_drv_crc_mode_coproc;
+
+        u8 serial[5] = {chip.serial[0], chip.serial[1], chip.serial[2], chip.serial[3],
+                        static_cast<u8>(chip.serial[0] ^ chip.serial[1] ^ chip.serial[2] ^ chip.serial[3])};
+        u8 sak;
+        chip.transactions = 0;
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_select(&conf, serial, &sak));
+        ASSERT_EQ(0x08, sak);
+        ASSERT_EQ(9U, chip.lastFrame.size());
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_halt(&conf));
+        ASSERT_EQ(4U, chip.lastFrame.size());
+        ASSERT_EQ(0x57, chip.lastFrame[2]);
+        ASSERT_EQ(0xCD, chip.lastFrame[3]);
+        transactions[i] = chip.transactions;
+        RecordProperty(mfrc522_drv_crc_mode_hw == conf.crc_mode ? "HardwareCrcTransactions"
+                                                                 : "CoprocessorCrcTransactions",
+                       static_cast<int>(transactions[i]));
+
+        /* Modes of the chip are restored, so frames without CRC are not affected */
+        ASSERT_EQ(0x00, chip.regs[mfrc522_reg_tx_mode] & 0x80);
+        ASSERT_EQ(0x00, chip.regs[mfrc522_reg_rx_mode] & 0x80);
+    }
+
+    ASSERT_LT(transactions[1], transactions[0]);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_select__HardwareCrcLlErrorWhilePolling__ModesRestored)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    conf.crc_mode = mfrc522_drv_crc_mode_hw;
+    mfrc522_drv_reg_cache cache;
+    mfrc522_drv_reg_cache_attach(&conf, &cache);
+
+    u8 serial[5] = {chip.serial[0], chip.serial[1], chip.serial[2], chip.serial[3],
+                    static_cast<u8>(chip.serial[0] ^ chip.serial[1] ^ chip.serial[2] ^ chip.serial[3])};
+    u8 sak;
+    chip.recvLost = true;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, mfrc522_drv_select(&conf, serial, &sak));
+
+    /* The command is terminated and the cache agrees with the chip */
+    ASSERT_EQ(mfrc522_reg_cmd_idle, chip.regs[mfrc522_reg_command] & 0x0F);
+    ASSERT_EQ(0x00, chip.regs[mfrc522_reg_tx_mode] & 0x80);
+    ASSERT_EQ(0x00, chip.regs[mfrc522_reg_rx_mode] & 0x80);
+    for (auto reg : {mfrc522_reg_tx_mode, mfrc522_reg_rx_mode, mfrc522_reg_bit_framing}) {
+        if (cache.valid & (1ULL << reg)) {
+            ASSERT_EQ(chip.regs[reg], cache.regs[reg]);
+        }
+    }
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_select__HardwareCrcBusLostWhilePolling__CacheEntriesDropped)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    conf.crc_mode = mfrc522_drv_crc_mode_hw;
+    mfrc522_drv_reg_cache cache;
+    mfrc522_drv_reg_cache_attach(&conf, &cache);
+
+    u8 serial[5] = {chip.serial[0], chip.serial[1], chip.serial[2], chip.serial[3],
+                    static_cast<u8>(chip.serial[0] ^ chip.serial[1] ^ chip.serial[2] ^ chip.serial[3])};
+    u8 sak;
+    chip.recvLost = true;
+    chip.sendLost = true;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, mfrc522_drv_select(&conf, serial, &sak));
+
+    /* Modes could not be restored, so their values are read again next time */
+    ASSERT_EQ(0U, cache.valid & (1ULL << mfrc522_reg_tx_mode));
+    ASSERT_EQ(0U, cache.valid & (1ULL << mfrc522_reg_rx_mode));
+    ASSERT_EQ(0U, cache.valid & (1ULL << mfrc522_reg_bit_framing));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_select__HardwareCrc__InvalidCrcOfResponse)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    conf.crc_mode = mfrc522_drv_crc_mode_hw;
+    chip.badCrc = true;
+
+    u8 serial[5] = {chip.serial[0], chip.serial[1], chip.serial[2], chip.serial[3],
+                    static_cast<u8>(chip.serial[0] ^ chip.serial[1] ^ chip.serial[2] ^ chip.serial[3])};
+    u8 sak;
+    ASSERT_EQ(mfrc522_drv_status_crc_err, mfrc522_drv_select(&conf, serial, &sak));
+    ASSERT_EQ(0x00, chip.regs[mfrc522_reg_tx_mode] & 0x80);
+    ASSERT_EQ(0x00, chip.regs[mfrc522_reg_rx_mode] & 0x80);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive__InvalidFraming__Failure)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    u8 tx, rx[2];
+    auto trConf = reqaConf(&tx, rx, 0);
+
+    trConf.tx_last_bits = 8;
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_transceive(&conf, &trConf));
+    trConf.tx_last_bits = 7;
+    trConf.rx_align = 8;
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_transceive(&conf, &trConf));
+    ASSERT_TRUE(chip.lastFrame.empty());
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive__VariableLength__AtsReceived)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+
+    /* RATS with CRC appended by the device, thus ATS is reported without CRC */
+    u8 tx[2] = {0xE0, 0x50};
+    u8 rx[16];
+    mfrc522_drv_transceive_conf trConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    trConf.tx_data = tx;
+    trConf.tx_data_sz = SIZE_ARRAY(tx);
+    trConf.rx_data = rx;
+    trConf.rx_data_sz = SIZE_ARRAY(rx);
+    trConf.command = mfrc522_reg_cmd_transceive;
+    trConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
+    trConf.hw_crc = true;
+    trConf.rx_var_len = true;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive(&conf, &trConf));
+    ASSERT_EQ(5U, trConf.rx_len);
+    ASSERT_EQ(0, trConf.rx_last_bits);
+    ASSERT_EQ(std::vector<u8>(chip.ats.begin(), chip.ats.end() - 2), std::vector<u8>(rx, rx + trConf.rx_len));
+
+    /* The same response does not fit into smaller buffer */
+    trConf.rx_data_sz = 4;
+    ASSERT_EQ(mfrc522_drv_status_transceive_rx_mism, mfrc522_drv_transceive(&conf, &trConf));
+    ASSERT_EQ(0U, trConf.rx_len);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive__VariableLength__IncompleteByteReported)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+
+    /* WRITE command answered with 4-bit ACK */
+    u8 tx[8] = {0xA2, 0x04, 0x01, 0x02, 0x03, 0x04};
+    u16 crc = mfrc522_picc_crc_a(tx, 6);
+    tx[6] = crc & 0xFF;
+    tx[7] = crc >> 8;
+    u8 rx[1];
+    mfrc522_drv_transceive_conf trConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    trConf.tx_data = tx;
+    trConf.tx_data_sz = SIZE_ARRAY(tx);
+    trConf.rx_data = rx;
+    trConf.rx_data_sz = SIZE_ARRAY(rx);
+    trConf.command = mfrc522_reg_cmd_transceive;
+    trConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
+
+    /* Exact length mode accepts the whole bytes only */
+    ASSERT_EQ(mfrc522_drv_status_transceive_rx_mism, mfrc522_drv_transceive(&conf, &trConf));
+
+    trConf.rx_var_len = true;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive(&conf, &trConf));
+    ASSERT_EQ(1U, trConf.rx_len);
+    ASSERT_EQ(4, trConf.rx_last_bits);
+    ASSERT_EQ(0x0A, rx[0] & 0x0F);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive_start__BitOrientedFrame__FramingRestored)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    chip.regs[mfrc522_reg_bit_framing] = 0x00;
+
+    /* Anticollision frame with 3 bits of UID CLn known. The first received bit is stored at position 3 */
+    u8 tx[3] = {0x93, 0x23, static_cast<u8>(chip.serial[0] & 0x07)};
+    u8 rx[5];
+    mfrc522_drv_transceive_conf trConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    trConf.tx_data = tx;
+    trConf.tx_data_sz = SIZE_ARRAY(tx);
+    trConf.rx_data = rx;
+    trConf.rx_data_sz = SIZE_ARRAY(rx);
+    trConf.command = mfrc522_reg_cmd_transceive;
+    trConf.timeout = MFRC522_DRV_FWT_ISO14443_3;
+    trConf.tx_last_bits = 3;
+    trConf.rx_align = 3;
+    trConf.rx_var_len = true;
+
+    mfrc522_drv_transceive_op op = {};
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_start(&conf, &op, &trConf));
+    pollUntilDone(&conf, &op);
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_finish(&conf, &op));
+    ASSERT_EQ(0x33, chip.lastBitFraming);
+    ASSERT_EQ(0x00, chip.regs[mfrc522_reg_bit_framing]);
+
+    /* Known bits and received ones make up the whole UID CLn */
+    ASSERT_EQ(5U, op.tr_conf.rx_len);
+    ASSERT_EQ(chip.serial[0], static_cast<u8>(tx[2] | rx[0]));
+    ASSERT_EQ(0, memcmp(&chip.serial[1], &rx[1], 3));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_probe__NullCases)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_probe_ctx probe = {};
+    bool present;
+    u16 atqa;
+
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_probe_init(nullptr, &probe, mfrc522_picc_cmd_reqa));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_probe_init(&conf, nullptr, mfrc522_picc_cmd_reqa));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_probe(nullptr, &probe, &present, &atqa));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_probe(&conf, nullptr, &present, &atqa));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_probe(&conf, &probe, nullptr, &atqa));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_probe(&conf, &probe, &present, nullptr));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_probe_deinit(nullptr, &probe));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_probe_deinit(&conf, nullptr));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_probe__NotConfigured__Failure)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    mfrc522_drv_probe_ctx probe = {};
+    bool present;
+    u16 atqa;
+
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_probe(&conf, &probe, &present, &atqa));
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_probe_deinit(&conf, &probe));
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_probe_init(&conf, &probe, mfrc522_picc_cmd_halt));
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_probe(&conf, &probe, &present, &atqa));
+    ASSERT_TRUE(chip.lastFrame.empty());
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_probe__CardPresentAndRemoved__PresenceReported)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    chip.regs[mfrc522_reg_command] = 0x20; /* RcvOff bit shall be kept */
+    mfrc522_drv_probe_ctx probe;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_probe_init(&conf, &probe, mfrc522_picc_cmd_wupa));
+
+    /* The card answering a probe stays in READY state and ignores the next frame, which is then sent again */
+    bool present;
+    u16 atqa;
+    for (size i = 0; i < 3; ++i) {
+        size frames = chip.frames;
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_probe(&conf, &probe, &present, &atqa));
+        ASSERT_TRUE(present);
+        ASSERT_EQ(i ? 2U : 1U, chip.frames - frames);
+        ASSERT_EQ(0x0004, atqa);
+        ASSERT_EQ(std::vector<u8>{mfrc522_picc_cmd_wupa}, chip.lastFrame);
+        ASSERT_EQ(0x07, chip.lastBitFraming & 0x07);
+    }
+
+    /* No response within frame waiting time */
+    chip.cardPresent = false;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_probe(&conf, &probe, &present, &atqa));
+    ASSERT_FALSE(present);
+    ASSERT_EQ(MFRC522_PICC_ATQA_INV, atqa);
+
+    /* Several cards answered at once */
+    chip.cardPresent = true;
+    chip.collision = true;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_probe(&conf, &probe, &present, &atqa));
+    ASSERT_TRUE(present);
+    ASSERT_EQ(MFRC522_PICC_ATQA_INV, atqa);
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_probe_deinit(&conf, &probe));
+    ASSERT_EQ(0x20 | mfrc522_reg_cmd_idle, chip.regs[mfrc522_reg_command]);
+    ASSERT_EQ(0x00, chip.regs[mfrc522_reg_bit_framing]);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_probe__ComparedToReqa__FewerBusTransactions)
+{
+    /* Transactions per frame sent with the card present and absent */
+    for (bool cardPresent : {true, false}) {
+        CardChip chip;
+        auto conf = initDriver(&chip);
+        chip.cardPresent = cardPresent;
+        u16 atqa;
+
+        chip.transactions = 0;
+        auto status = mfrc522_drv_reqa(&conf, &atqa);
+        ASSERT_EQ(cardPresent ? mfrc522_drv_status_ok : mfrc522_drv_status_transceive_timeout, status);
+        size reqaTransactions = chip.transactions;
+
+        /* The card left in READY state ignores the first frame, hence the probe sends it twice */
+        mfrc522_drv_probe_ctx probe;
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_probe_init(&conf, &probe, mfrc522_picc_cmd_reqa));
+        bool present;
+        chip.transactions = 0;
+        size frames = chip.frames;
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_probe(&conf, &probe, &present, &atqa));
+        ASSERT_EQ(cardPresent, present);
+        ASSERT_EQ(2U, chip.frames - frames);
+        size probeTransactions = chip.transactions / 2;
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_probe_deinit(&conf, &probe));
+
+        RecordProperty(cardPresent ? "ReqaTransactionsPresent" : "ReqaTransactionsAbsent",
+                       static_cast<int>(reqaTransactions));
+        RecordProperty(cardPresent ? "ProbeTransactionsPresent" : "ProbeTransactionsAbsent",
+                       static_cast<int>(probeTransactions));
+        ASSERT_LE(2 * probeTransactions, reqaTransactions);
+    }
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_select_uid__NullCases)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    mfrc522_picc_uid uid;
+
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_select_uid(nullptr, &uid));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_select_uid(&conf, nullptr));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_select_uid__EachUidSize__TwoFramesPerCascadeLevel)
+{
+    const std::vector<u8> uids[] = {
+        {0xDE, 0xAD, 0xBE, 0xEF}, /* MIFARE Classic */
+        {0x04, 0x5A, 0x3C, 0x8A, 0x6E, 0x49, 0x80}, /* NTAG, DESFire */
+        {0x04, 0x11, 0x22, 0x88, 0x33, 0x44, 0x55, 0x66, 0x77, 0x99}, /* Cascade tag value inside UID is allowed */
+    };
+    const u8 saks[] = {0x08, 0x00, 0x20};
+
+    for (auto crcMode : {mfrc522_drv_crc_mode_coproc, mfrc522_drv_crc_mode_sw, mfrc522_drv_crc_mode_hw}) {
+        for (size i = 0; i < SIZE_ARRAY(uids); ++i) {
+            CardChip chip;
+            auto conf = initDriver(&chip);
+            conf.crc_mode = crcMode;
+            chip.uid = uids[i];
+            chip.sak = saks[i];
+
+            mfrc522_picc_uid uid;
+            uid.sz = 0;
+            ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_select_uid(&conf, &uid));
+            ASSERT_EQ(uids[i].size(), uid.sz);
+            ASSERT_TRUE(std::equal(uids[i].begin(), uids[i].end(), uid.bytes));
+            ASSERT_EQ(saks[i], uid.sak);
+            ASSERT_EQ(2 * (i + 1), chip.frames);
+        }
+    }
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_select_uid__KnownUid__SelectFramesOnly)
+{
+    const std::vector<u8> uids[] = {
+        {0xDE, 0xAD, 0xBE, 0xEF},
+        {0x04, 0x5A, 0x3C, 0x8A, 0x6E, 0x49, 0x80},
+        {0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99},
+    };
+
+    for (size i = 0; i < SIZE_ARRAY(uids); ++i) {
+        CardChip chip;
+        auto conf = initDriver(&chip);
+        chip.uid = uids[i];
+
+        /* The card is selected again, e.g. after HLTA and WUPA */
+        mfrc522_picc_uid uid;
+        uid.sz = static_cast<u8>(uids[i].size());
+        std::copy(uids[i].begin(), uids[i].end(), uid.bytes);
+        uid.sak = 0x00;
+        ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_select_uid(&conf, &uid));
+        ASSERT_EQ(uids[i].size(), uid.sz);
+        ASSERT_EQ(0x08, uid.sak);
+        ASSERT_EQ(i + 1, chip.frames);
+    }
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_select_uid__KnownUidOfOtherCard__Timeout)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    chip.uid = {0x04, 0x5A, 0x3C, 0x8A, 0x6E, 0x49, 0x80};
+
+    mfrc522_picc_uid uid;
+    uid.sz = 7;
+    std::copy(chip.uid.begin(), chip.uid.end(), uid.bytes);
+    uid.bytes[6] ^= 0xFF;
+    ASSERT_EQ(mfrc522_drv_status_transceive_timeout, mfrc522_drv_select_uid(&conf, &uid));
+    ASSERT_EQ(2U, chip.frames);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_select_uid__InvalidUid__Failure)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+
+    /* Size of a known UID has to be one of 4, 7 and 10 bytes */
+    mfrc522_picc_uid uid;
+    uid.sz = 5;
+    ASSERT_EQ(mfrc522_drv_status_nok, mfrc522_drv_select_uid(&conf, &uid));
+    ASSERT_EQ(0U, chip.frames);
+
+    /* Known UID is double size, but the card reports complete UID at CL1 */
+    chip.uid = {0x88, 0x04, 0x5A, 0x3C};
+    uid.sz = 7;
+    const u8 bytes[] = {0x04, 0x5A, 0x3C, 0x8A, 0x6E, 0x49, 0x80};
+    std::copy(std::begin(bytes), std::end(bytes), uid.bytes);
+    ASSERT_EQ(mfrc522_drv_status_cascade_err, mfrc522_drv_select_uid(&conf, &uid));
+
+    /* Single size UID cannot start with cascade tag */
+    uid.sz = 0;
+    ASSERT_EQ(mfrc522_drv_status_cascade_err, mfrc522_drv_select_uid(&conf, &uid));
+    ASSERT_EQ(0U, uid.sz);
+
+    /* The last byte of every response is corrupted, i.e. BCC of UID CLn or CRC of SAK */
+    chip.uid.clear();
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_select_uid(&conf, &uid));
+    chip.badCrc = true;
+    ASSERT_EQ(mfrc522_drv_status_crc_err, mfrc522_drv_select_uid(&conf, &uid));
+    uid.sz = 0;
+    ASSERT_EQ(mfrc522_drv_status_anticoll_chksum_err, mfrc522_drv_select_uid(&conf, &uid));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_transceive__VariableLength__CollisionPositionReported)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    chip.addCard({0x12, 0x34, 0x56, 0x78});
+    chip.addCard({0x12, 0x34, 0x76, 0x78}); /* The first difference is bit 5 of the third byte */
+
+    u16 atqa;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_reqa(&conf, &atqa));
+
+    /* The whole UID CL1 is requested */
+    u8 tx[2];
+    u8 rx[5];
+    mfrc522_drv_transceive_conf trConf = reqaConf(tx, rx, MFRC522_DRV_FWT_ISO14443_3);
+    tx[0] = 0x93;
+    tx[1] = 0x20;
+    trConf.tx_data_sz = 2;
+    trConf.rx_data_sz = sizeof(rx);
+    trConf.tx_last_bits = 0;
+    trConf.rx_var_len = true;
+    ASSERT_EQ(mfrc522_drv_status_collision, mfrc522_drv_transceive(&conf, &trConf));
+    ASSERT_EQ(22, trConf.coll_pos);
+    ASSERT_EQ(3U, trConf.rx_len);
+    ASSERT_EQ(0x12, rx[0]);
+    ASSERT_EQ(0x34, rx[1]);
+    ASSERT_EQ(0x16, rx[2] & 0x1F);
+
+    /* Partial byte frame with 17 known bits. Position is counted from the first received bit and includes RxAlign */
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_halt(&conf)); /* Cards in READY state go back to IDLE */
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_reqa(&conf, &atqa));
+    u8 partial[5] = {0x93, 0x41, 0x12, 0x34, 0x00};
+    trConf.tx_data = partial;
+    trConf.tx_data_sz = 5;
+    trConf.rx_data_sz = 3;
+    trConf.tx_last_bits = 1;
+    trConf.rx_align = 1;
+    ASSERT_EQ(mfrc522_drv_status_collision, mfrc522_drv_transceive(&conf, &trConf));
+    ASSERT_EQ(6, trConf.coll_pos);
+
+    /* No collision when all cards match the known bits */
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_halt(&conf));
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_reqa(&conf, &atqa));
+    partial[1] = 0x46;
+    partial[4] = 0x36;
+    trConf.tx_last_bits = 6;
+    trConf.rx_align = 6;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive(&conf, &trConf));
+    ASSERT_EQ(0, trConf.coll_pos);
+    ASSERT_EQ(3U, trConf.rx_len);
+    ASSERT_EQ(0x40, rx[0] & 0xC0);
+    ASSERT_EQ(0x78, rx[1]);
+    ASSERT_EQ(0x12 ^ 0x34 ^ 0x76 ^ 0x78, rx[2]);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_select_uid__TwoCards__CollisionResolved)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    chip.addCard({0x12, 0x34, 0x56, 0x78}, 0x08);
+    chip.addCard({0x12, 0x34, 0x76, 0x78}, 0x18);
+
+    u16 atqa;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_reqa(&conf, &atqa));
+    chip.frames = 0;
+
+    /* Collided bit is chosen to be one. A single additional ANTICOLLISION frame is sent */
+    mfrc522_picc_uid uid;
+    uid.sz = 0;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_select_uid(&conf, &uid));
+    ASSERT_EQ(4U, uid.sz);
+    const u8 expected[] = {0x12, 0x34, 0x76, 0x78};
+    ASSERT_TRUE(std::equal(std::begin(expected), std::end(expected), uid.bytes));
+    ASSERT_EQ(0x18, uid.sak);
+    ASSERT_EQ(3U, chip.frames);
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_inventory__NullCases)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    mfrc522_picc_uid uids[2];
+    size found;
+
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_inventory(nullptr, uids, 2, &found));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_inventory(&conf, nullptr, 2, &found));
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_inventory(&conf, uids, 2, nullptr));
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_inventory__MultipleCards__AllEnumerated)
+{
+    const std::vector<u8> uids[] = {
+        {0xDE, 0xAD, 0xBE, 0xEF},
+        {0xDE, 0xAD, 0xBE, 0xEE}, /* Differs from the previous one in the last bit of UID */
+        {0x04, 0x5A, 0x3C, 0x8A, 0x6E, 0x49, 0x80},
+        {0x04, 0x5A, 0x3C, 0x11, 0x22, 0x33, 0x44}, /* The same UID CL1 as the previous one */
+        {0x04, 0x11, 0x22, 0x88, 0x33, 0x44, 0x55, 0x66, 0x77, 0x99},
+    };
+
+    for (auto crcMode : {mfrc522_drv_crc_mode_coproc, mfrc522_drv_crc_mode_sw, mfrc522_drv_crc_mode_hw}) {
+        for (size cards : {0U, 1U, 3U, 5U}) {
+            CardChip chip;
+            auto conf = initDriver(&chip);
+            conf.crc_mode = crcMode;
+            chip.cardPresent = (0 != cards);
+            for (size i = 0; i < cards; ++i) {
+                chip.addCard(uids[i], static_cast<u8>(i << 4));
+            }
+
+            mfrc522_picc_uid found[SIZE_ARRAY(uids)];
+            size num = SIZE_ARRAY(uids);
+            ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_inventory(&conf, found, SIZE_ARRAY(found), &num));
+            ASSERT_EQ(cards, num);
+
+            /* Each card is reported once and left halted */
+            for (size i = 0; i < cards; ++i) {
+                const auto& card = chip.cards[i];
+                auto it = std::find_if(found, found + num, [&card](const mfrc522_picc_uid& uid) {
+                    return uid.sz == card.uid.size() && std::equal(card.uid.begin(), card.uid.end(), uid.bytes);
+                });
+                ASSERT_NE(found + num, it);
+                ASSERT_EQ(card.sak, it->sak);
+                ASSERT_EQ(CardChip::CardState::halt, card.state);
+            }
+
+            if (mfrc522_drv_crc_mode_coproc == crcMode) {
+                RecordProperty("Frames" + std::to_string(cards) + "Cards", static_cast<int>(chip.frames));
+            }
+        }
+    }
+}
+
+TEST(TestMfrc522DrvTransceiveOp, mfrc522_drv_inventory__MoreCardsThanSlots__RestEnumeratedLater)
+{
+    CardChip chip;
+    auto conf = initDriver(&chip);
+    chip.addCard({0x11, 0x22, 0x33, 0x44});
+    chip.addCard({0x11, 0x22, 0x33, 0x45});
+    chip.addCard({0x91, 0x22, 0x33, 0x44});
+
+    mfrc522_picc_uid uids[2];
+    size found;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_inventory(&conf, uids, SIZE_ARRAY(uids), &found));
+    ASSERT_EQ(2U, found);
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_inventory(&conf, uids, SIZE_ARRAY(uids), &found));
+    ASSERT_EQ(1U, found);
+
+    /* All cards are halted, so a single REQA is sent */
+    chip.frames = 0;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_inventory(&conf, uids, SIZE_ARRAY(uids), &found));
+    ASSERT_EQ(0U, found);
+    ASSERT_EQ(1U, chip.frames);
+}
@@ -0,0 +1,287 @@
+#include "mfrc522_drv.h"
+#include "mfrc522_ll_event.h"
+#include <gtest/gtest.h>
+#include <linux/gpio.h>
+#include <string>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <vector>
+#include "common/SimulatedChip.h"
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Private data ---------------------- */
+/* ------------------------------------------------------------ */
+
+/* State of emulated GPIO character device. Each requested line is backed by a pipe */
+static struct
+{
+    std::vector<gpio_v2_line_request> requests;
+    std::vector<int> writeEnds; /* Write end of a pipe of each requested line */
+    bool fail;
+} fakeChip;
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+/* Emulate line request issued to GPIO character device */
+static int fakeIoctl(int fd, unsigned long req, void* arg)
+{
+    static_cast<void>(fd);
+    if (fakeChip.fail || GPIO_V2_GET_LINE_IOCTL != req) {
+        return -1;
+    }
+
+    auto request = static_cast<gpio_v2_line_request*>(arg);
+    int ends[2];
+    if (pipe(ends) < 0) {
+        return -1;
+    }
+    request->fd = ends[0];
+    fakeChip.requests.push_back(*request);
+    fakeChip.writeEnds.push_back(ends[1]);
+    return 0;
+}
+
+/* Report an edge on a line */
+static void raiseEdge(int writeEnd)
+{
+    gpio_v2_line_event event = {};
+    event.id = GPIO_V2_LINE_EVENT_RISING_EDGE;
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(event)), write(writeEnd, &event, sizeof(event)));
+}
+
+static void resetFakeChip()
+{
+    for (auto fd : fakeChip.writeEnds) {
+        close(fd);
+    }
+    fakeChip.requests.clear();
+    fakeChip.writeEnds.clear();
+    fakeChip.fail = false;
+}
+
+static mfrc522_ll_event_conf eventConf(const char* chipPath = "/dev/null", u32 line = 17)
+{
+    mfrc522_ll_event_conf conf;
+    conf.chip_path = chipPath;
+    conf.line = line;
+    conf.active_low = true;
+    conf.poll_period = 0;
+    conf.ioctl_fn = fakeIoctl;
+    return conf;
+}
+
+/* MFRC522 whose command completes as soon as transmission is started. Enabled interrupts raise an edge on IRQ pin */
+class IrqChip : public SimulatedChip
+{
+public:
+    int irqLine = -1; /* Write end of a pipe connected to IRQ pin. Negative if not connected */
+
+private:
+    void transmit() override
+    {
+        SimulatedChip::transmit();
+        regs[mfrc522_reg_com_irq] |= (1 << mfrc522_reg_irq_rx) | (1 << mfrc522_reg_irq_idle);
+        if ((regs[mfrc522_reg_com_irq_en] & regs[mfrc522_reg_com_irq] & 0x7F) && irqLine >= 0) {
+            raiseEdge(irqLine);
+        }
+    }
+};
+
+static mfrc522_drv_conf initDriver(IrqChip* chip)
+{
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = SimulatedChip::ops(false);
+    conf.ll_ctx = chip;
+    EXPECT_EQ(mfrc522_drv_status_ok, mfrc522_drv_init(&conf));
+    return conf;
+}
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Test cases ------------------------ */
+/* ------------------------------------------------------------ */
+
+TEST(TestMfrc522LlEvent, mfrc522_ll_event_open__NullCases)
+{
+    mfrc522_ll_event ev;
+    auto conf = eventConf();
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_event_open(nullptr, &conf));
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_event_open(&ev, nullptr));
+    ASSERT_GT(0, mfrc522_ll_event_fd(nullptr));
+    ASSERT_EQ(mfrc522_ll_status_recv_err, mfrc522_ll_event_ack(nullptr));
+    ASSERT_EQ(mfrc522_ll_status_recv_err, mfrc522_ll_event_wait(nullptr, 0));
+    mfrc522_ll_event_close(nullptr);
+}
+
+TEST(TestMfrc522LlEvent, mfrc522_ll_event_open__GpioLine__ActiveEdgeRequested)
+{
+    resetFakeChip();
+    mfrc522_ll_event ev;
+    auto conf = eventConf("/dev/null", 23);
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_open(&ev, &conf));
+    ASSERT_TRUE(ev.irq);
+    ASSERT_LE(0, mfrc522_ll_event_fd(&ev));
+
+    ASSERT_EQ(1U, fakeChip.requests.size());
+    const auto& req = fakeChip.requests[0];
+    ASSERT_EQ(1U, req.num_lines);
+    ASSERT_EQ(23U, req.offsets[0]);
+    ASSERT_EQ(std::string(MFRC522_LL_EVENT_CONSUMER), std::string(req.consumer));
+    const u64 flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_ACTIVE_LOW;
+    ASSERT_EQ(flags, req.config.flags);
+
+    mfrc522_ll_event_close(&ev);
+    ASSERT_GT(0, mfrc522_ll_event_fd(&ev));
+    ASSERT_EQ(mfrc522_ll_status_recv_err, mfrc522_ll_event_ack(&ev));
+}
+
+TEST(TestMfrc522LlEvent, mfrc522_ll_event_open__ActiveHighPin__PolarityNotInverted)
+{
+    resetFakeChip();
+    mfrc522_ll_event ev;
+    auto conf = eventConf();
+    conf.active_low = false;
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_open(&ev, &conf));
+    ASSERT_EQ(0U, fakeChip.requests[0].config.flags & GPIO_V2_LINE_FLAG_ACTIVE_LOW);
+    mfrc522_ll_event_close(&ev);
+}
+
+TEST(TestMfrc522LlEvent, mfrc522_ll_event_ack__EdgesReported__AllAcknowledgedAtOnce)
+{
+    resetFakeChip();
+    mfrc522_ll_event ev;
+    auto conf = eventConf();
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_open(&ev, &conf));
+
+    ASSERT_EQ(mfrc522_ll_status_timeout, mfrc522_ll_event_ack(&ev));
+    for (size i = 0; i < 6; ++i) {
+        raiseEdge(fakeChip.writeEnds[0]);
+    }
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_ack(&ev));
+    ASSERT_EQ(mfrc522_ll_status_timeout, mfrc522_ll_event_ack(&ev));
+    mfrc522_ll_event_close(&ev);
+}
+
+TEST(TestMfrc522LlEvent, mfrc522_ll_event_wait__NoEdge__Timeout)
+{
+    resetFakeChip();
+    mfrc522_ll_event ev;
+    auto conf = eventConf();
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_open(&ev, &conf));
+
+    ASSERT_EQ(mfrc522_ll_status_timeout, mfrc522_ll_event_wait(&ev, 1000));
+    raiseEdge(fakeChip.writeEnds[0]);
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_wait(&ev, 1000));
+    mfrc522_ll_event_close(&ev);
+}
+
+TEST(TestMfrc522LlEvent, mfrc522_ll_event_open__LineNotAvailable__TimerFallback)
+{
+    resetFakeChip();
+    fakeChip.fail = true;
+    mfrc522_ll_event ev;
+    auto conf = eventConf();
+    conf.poll_period = 500;
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_open(&ev, &conf));
+    ASSERT_FALSE(ev.irq);
+
+    /* The timer expires periodically */
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_wait(&ev, 100000));
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_wait(&ev, 100000));
+    mfrc522_ll_event_close(&ev);
+}
+
+TEST(TestMfrc522LlEvent, mfrc522_ll_event_open__NoGpioChip__TimerFallback)
+{
+    resetFakeChip();
+    mfrc522_ll_event ev;
+    auto conf = eventConf(nullptr);
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_open(&ev, &conf));
+    ASSERT_FALSE(ev.irq);
+    ASSERT_TRUE(fakeChip.requests.empty());
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_wait(&ev, 100000));
+    mfrc522_ll_event_close(&ev);
+
+    /* Chip which cannot be opened */
+    conf = eventConf("/nonexistent/gpiochip");
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_open(&ev, &conf));
+    ASSERT_FALSE(ev.irq);
+    mfrc522_ll_event_close(&ev);
+}
+
+TEST(TestMfrc522LlEvent, epoll__ManyDevices__OnlySignalledDeviceReported)
+{
+    resetFakeChip();
+    mfrc522_ll_event evs[8];
+    int epfd = epoll_create1(0);
+    ASSERT_LE(0, epfd);
+    for (size i = 0; i < SIZE_ARRAY(evs); ++i) {
+        auto conf = eventConf("/dev/null", i);
+        ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_open(&evs[i], &conf));
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        ASSERT_EQ(0, epoll_ctl(epfd, EPOLL_CTL_ADD, mfrc522_ll_event_fd(&evs[i]), &event));
+    }
+
+    raiseEdge(fakeChip.writeEnds[5]);
+    epoll_event ready[SIZE_ARRAY(evs)];
+    ASSERT_EQ(1, epoll_wait(epfd, ready, SIZE_ARRAY(ready), 100));
+    ASSERT_EQ(5U, ready[0].data.u32);
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_ack(&evs[5]));
+    ASSERT_EQ(0, epoll_wait(epfd, ready, SIZE_ARRAY(ready), 0));
+
+    for (auto& ev : evs) {
+        mfrc522_ll_event_close(&ev);
+    }
+    close(epfd);
+}
+
+TEST(TestMfrc522LlEvent, mfrc522_drv_transceive_irq_en__TypicalCase__CompletionIrqsRouted)
+{
+    IrqChip chip;
+    auto conf = initDriver(&chip);
+    chip.regs[mfrc522_reg_com_irq_en] = 0x80; /* IRqInv */
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_irq_en(&conf, true));
+    ASSERT_EQ(0xB3, chip.regs[mfrc522_reg_com_irq_en]);
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_irq_en(&conf, false));
+    ASSERT_EQ(0x80, chip.regs[mfrc522_reg_com_irq_en]);
+    ASSERT_EQ(mfrc522_drv_status_nullptr, mfrc522_drv_transceive_irq_en(nullptr, true));
+}
+
+TEST(TestMfrc522LlEvent, mfrc522_drv_transceive_poll__DrivenByEvent__OperationCompleted)
+{
+    resetFakeChip();
+    IrqChip chip;
+    auto conf = initDriver(&chip);
+    mfrc522_ll_event ev;
+    auto evConf = eventConf();
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_open(&ev, &evConf));
+    chip.irqLine = fakeChip.writeEnds[0];
+
+    mfrc522_drv_irq_conf irqConf;
+    irqConf.irq_signal_inv = true;
+    irqConf.irq_push_pull = true;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_irq_init(&conf, &irqConf));
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_irq_en(&conf, true));
+
+    u8 tx = mfrc522_picc_cmd_reqa;
+    mfrc522_drv_transceive_conf trConf = MFRC522_DRV_TRANSCEIVE_CONF_DEFAULT;
+    trConf.tx_data = &tx;
+    trConf.tx_data_sz = 1;
+    trConf.rx_data = nullptr;
+    trConf.rx_data_sz = 0;
+    trConf.command = mfrc522_reg_cmd_transceive;
+    mfrc522_drv_transceive_op op = {};
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_start(&conf, &op, &trConf));
+
+    /* The device is polled only after IRQ pin became active */
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_event_wait(&ev, 100000));
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_poll(&conf, &op));
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_transceive_finish(&conf, &op));
+    ASSERT_EQ(mfrc522_ll_status_timeout, mfrc522_ll_event_ack(&ev));
+    mfrc522_ll_event_close(&ev);
+}
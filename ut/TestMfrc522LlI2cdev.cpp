@@ -0,0 +1,261 @@
+#include "mfrc522_drv.h"
+#include "mfrc522_ll_i2cdev.h"
+#include <gtest/gtest.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <vector>
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Private data ---------------------- */
+/* ------------------------------------------------------------ */
+
+/* Single I2C message seen by fake ioctl */
+struct Message
+{
+    u16 addr;
+    bool read;
+    std::vector<u8> tx;
+};
+
+/* State of emulated i2c-dev device */
+static struct
+{
+    u8 regs[MFRC522_DRV_REG_NUM];
+    std::vector<std::vector<Message>> transactions;
+    unsigned long funcs;
+    unsigned long failReq;
+} fake;
+
+/* Instance of the backend under test */
+static mfrc522_ll_i2cdev i2cdev;
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+/* Emulate MFRC522 connected to i2c-dev device */
+static int fakeIoctl(int fd, unsigned long req, void* arg)
+{
+    static_cast<void>(fd);
+    if (fake.failReq == req) {
+        return -1;
+    }
+
+    if (I2C_FUNCS == req) {
+        *static_cast<unsigned long*>(arg) = fake.funcs;
+        return 0;
+    }
+
+    auto data = static_cast<i2c_rdwr_ioctl_data*>(arg);
+    std::vector<Message> transaction;
+    u8 ptr = 0;
+    for (size i = 0; i < data->nmsgs; ++i) {
+        const auto& msg = data->msgs[i];
+        if (msg.flags & I2C_M_RD) {
+            transaction.push_back({msg.addr, true, {}});
+            std::fill(msg.buf, msg.buf + msg.len, fake.regs[ptr]);
+        } else {
+            transaction.push_back({msg.addr, false, std::vector<u8>(msg.buf, msg.buf + msg.len)});
+            ptr = msg.buf[0] & 0x3F;
+            for (size j = 1; j < msg.len; ++j) {
+                fake.regs[ptr] = msg.buf[j];
+            }
+        }
+    }
+    fake.transactions.push_back(transaction);
+    return static_cast<int>(data->nmsgs);
+}
+
+/* Reset fake device and set up the backend to use it */
+static void setupFake(const char* path = "/dev/null")
+{
+    std::fill(std::begin(fake.regs), std::end(fake.regs), 0x00);
+    fake.transactions.clear();
+    fake.funcs = I2C_FUNC_I2C;
+    fake.failReq = 0;
+
+    mfrc522_ll_i2cdev_conf conf;
+    conf.path = path;
+    conf.addr = 0;
+    conf.ioctl_fn = fakeIoctl;
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_i2cdev_setup(&i2cdev, &conf));
+}
+
+/* Initialize the driver on top of i2c-dev backend */
+static mfrc522_drv_conf initDriver(mfrc522_ll_i2cdev* dev = &i2cdev)
+{
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &mfrc522_ll_i2cdev_ops;
+    conf.ll_ctx = dev;
+    fake.regs[mfrc522_reg_version] = 0x92;
+    EXPECT_EQ(mfrc522_drv_status_ok, mfrc522_drv_init(&conf));
+    fake.transactions.clear();
+    return conf;
+}
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Test cases ------------------------ */
+/* ------------------------------------------------------------ */
+
+TEST(TestMfrc522LlI2cdev, mfrc522_ll_i2cdev_setup__NullCases)
+{
+    mfrc522_ll_i2cdev_conf conf;
+    conf.path = "/dev/null";
+    conf.addr = 0;
+    conf.ioctl_fn = fakeIoctl;
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_i2cdev_setup(nullptr, &conf));
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_i2cdev_setup(&i2cdev, nullptr));
+
+    conf.path = nullptr;
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_i2cdev_setup(&i2cdev, &conf));
+}
+
+TEST(TestMfrc522LlI2cdev, mfrc522_drv_init__TypicalCase__ChipVersionRead)
+{
+    setupFake();
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &mfrc522_ll_i2cdev_ops;
+    conf.ll_ctx = &i2cdev;
+    fake.regs[mfrc522_reg_version] = 0x92;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_init(&conf));
+    ASSERT_EQ(0x92, conf.chip_version);
+
+    /* Register address write and data read are combined */
+    ASSERT_EQ(1U, fake.transactions.size());
+    ASSERT_EQ(2U, fake.transactions[0].size());
+    ASSERT_EQ(MFRC522_LL_I2CDEV_DEF_ADDR, fake.transactions[0][0].addr);
+    ASSERT_FALSE(fake.transactions[0][0].read);
+    ASSERT_EQ(std::vector<u8>{mfrc522_reg_version}, fake.transactions[0][0].tx);
+    ASSERT_TRUE(fake.transactions[0][1].read);
+    mfrc522_ll_i2cdev_close(&i2cdev);
+}
+
+TEST(TestMfrc522LlI2cdev, mfrc522_drv_init__OpenFailure__LlErrorReturned)
+{
+    setupFake("/nonexistent/i2c-1");
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &mfrc522_ll_i2cdev_ops;
+    conf.ll_ctx = &i2cdev;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, mfrc522_drv_init(&conf));
+}
+
+TEST(TestMfrc522LlI2cdev, mfrc522_drv_init__PlainI2cNotSupported__LlErrorReturned)
+{
+    setupFake();
+    fake.funcs = 0;
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &mfrc522_ll_i2cdev_ops;
+    conf.ll_ctx = &i2cdev;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, mfrc522_drv_init(&conf));
+}
+
+TEST(TestMfrc522LlI2cdev, send__TypicalCase__SingleMessageSent)
+{
+    setupFake();
+    auto conf = initDriver();
+
+    const u8 payload[] = {0xAB, 0xCD};
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write(&conf, mfrc522_reg_fifo_data, SIZE_ARRAY(payload), payload));
+
+    ASSERT_EQ(1U, fake.transactions.size());
+    ASSERT_EQ(1U, fake.transactions[0].size());
+    const std::vector<u8> expected = {mfrc522_reg_fifo_data, 0xAB, 0xCD};
+    ASSERT_EQ(expected, fake.transactions[0][0].tx);
+    mfrc522_ll_i2cdev_close(&i2cdev);
+}
+
+TEST(TestMfrc522LlI2cdev, send__TwoDevicesOnAdapter__OwnAddressUsed)
+{
+    setupFake();
+    mfrc522_ll_i2cdev other;
+    mfrc522_ll_i2cdev_conf otherConf = i2cdev.conf;
+    otherConf.addr = MFRC522_LL_I2CDEV_DEF_ADDR + 1;
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_i2cdev_setup(&other, &otherConf));
+    auto conf = initDriver();
+    auto otherDrvConf = initDriver(&other);
+
+    const u8 payload = 0xAB;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write(&otherDrvConf, mfrc522_reg_fifo_data, 1, &payload));
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write(&conf, mfrc522_reg_fifo_data, 1, &payload));
+
+    ASSERT_EQ(2U, fake.transactions.size());
+    ASSERT_EQ(MFRC522_LL_I2CDEV_DEF_ADDR + 1, fake.transactions[0][0].addr);
+    ASSERT_EQ(MFRC522_LL_I2CDEV_DEF_ADDR, fake.transactions[1][0].addr);
+    mfrc522_ll_i2cdev_close(&other);
+    mfrc522_ll_i2cdev_close(&i2cdev);
+}
+
+TEST(TestMfrc522LlI2cdev, mfrc522_drv_fifo_read_mul__TypicalCase__BurstRead)
+{
+    setupFake();
+    auto conf = initDriver();
+    fake.regs[mfrc522_reg_fifo_data] = 0x5A;
+
+    u8 buffer[16];
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_fifo_read_mul(&conf, buffer, SIZE_ARRAY(buffer)));
+
+    ASSERT_EQ(1U, fake.transactions.size());
+    ASSERT_EQ(2U, fake.transactions[0].size());
+    for (auto byte : buffer) {
+        ASSERT_EQ(0x5A, byte);
+    }
+    mfrc522_ll_i2cdev_close(&i2cdev);
+}
+
+TEST(TestMfrc522LlI2cdev, transfer_multi__TypicalCase__SingleTransactionSent)
+{
+    setupFake();
+    initDriver();
+    fake.regs[mfrc522_reg_demod] = 0x4D;
+
+    u8 write = 0x33;
+    u8 read;
+    const mfrc522_ll_xfer xfers[] = {
+        {mfrc522_reg_tx_control, 1, &write, nullptr},
+        {mfrc522_reg_demod, 1, nullptr, &read},
+        {mfrc522_reg_command, 1, &write, nullptr}
+    };
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_i2cdev_ops.transfer_multi(&i2cdev, xfers, SIZE_ARRAY(xfers)));
+
+    ASSERT_EQ(1U, fake.transactions.size());
+    ASSERT_EQ(4U, fake.transactions[0].size());
+    ASSERT_EQ(0x4D, read);
+    ASSERT_EQ(0x33, fake.regs[mfrc522_reg_tx_control]);
+    ASSERT_EQ(0x33, fake.regs[mfrc522_reg_command]);
+    mfrc522_ll_i2cdev_close(&i2cdev);
+}
+
+TEST(TestMfrc522LlI2cdev, transfer_multi__LongBatch__SplitIntoSeveralTransactions)
+{
+    setupFake();
+    initDriver();
+
+    u8 read[MFRC522_LL_I2CDEV_MSG_MAX];
+    std::vector<mfrc522_ll_xfer> xfers;
+    for (auto& byte : read) {
+        xfers.push_back({mfrc522_reg_status1, 1, nullptr, &byte});
+    }
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_i2cdev_ops.transfer_multi(&i2cdev, xfers.data(), xfers.size()));
+
+    /* Each read takes two messages */
+    ASSERT_EQ(2U, fake.transactions.size());
+    ASSERT_EQ(static_cast<size>(MFRC522_LL_I2CDEV_MSG_MAX), fake.transactions[0].size());
+    ASSERT_EQ(static_cast<size>(MFRC522_LL_I2CDEV_MSG_MAX), fake.transactions[1].size());
+    mfrc522_ll_i2cdev_close(&i2cdev);
+}
+
+TEST(TestMfrc522LlI2cdev, transfer_multi__IoctlFailure__ErrorReturned)
+{
+    setupFake();
+    initDriver();
+    fake.failReq = I2C_RDWR;
+
+    u8 byte = 0x00;
+    ASSERT_EQ(mfrc522_ll_status_send_err, mfrc522_ll_i2cdev_ops.send(&i2cdev, mfrc522_reg_command, 1, &byte));
+    ASSERT_EQ(mfrc522_ll_status_recv_err, mfrc522_ll_i2cdev_ops.recv(&i2cdev, mfrc522_reg_command, &byte));
+    mfrc522_ll_i2cdev_close(&i2cdev);
+}
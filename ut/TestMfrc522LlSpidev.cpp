@@ -0,0 +1,288 @@
+#include "mfrc522_drv.h"
+#include "mfrc522_ll_spidev.h"
+#include <gtest/gtest.h>
+#include <linux/spi/spidev.h>
+#include <vector>
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Private data ---------------------- */
+/* ------------------------------------------------------------ */
+
+/* Single SPI transfer seen by fake ioctl */
+struct Frame
+{
+    std::vector<u8> tx;
+    bool csChange;
+};
+
+/* State of emulated spidev device */
+static struct
+{
+    u8 regs[MFRC522_DRV_REG_NUM];
+    std::vector<std::vector<Frame>> messages;
+    std::vector<int> fds; /* File descriptor each message was sent through */
+    u8 mode;
+    u8 bits;
+    u32 speed;
+    unsigned long failReq;
+} fake;
+
+/* Instance of the backend under test */
+static mfrc522_ll_spidev spidev;
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+/* Emulate MFRC522 connected to spidev device */
+static int fakeIoctl(int fd, unsigned long req, void* arg)
+{
+    if (fake.failReq == req) {
+        return -1;
+    }
+
+    switch (req) {
+        case SPI_IOC_WR_MODE:
+            fake.mode = *static_cast<u8*>(arg);
+            return 0;
+        case SPI_IOC_WR_BITS_PER_WORD:
+            fake.bits = *static_cast<u8*>(arg);
+            return 0;
+        case SPI_IOC_WR_MAX_SPEED_HZ:
+            fake.speed = *static_cast<u32*>(arg);
+            return 0;
+        default:
+            break;
+    }
+
+    auto msgs = static_cast<spi_ioc_transfer*>(arg);
+    auto num = _IOC_SIZE(req) / sizeof(spi_ioc_transfer);
+    std::vector<Frame> message;
+    for (size i = 0; i < num; ++i) {
+        auto tx = reinterpret_cast<const u8*>(msgs[i].tx_buf);
+        auto rx = reinterpret_cast<u8*>(msgs[i].rx_buf);
+        message.push_back({std::vector<u8>(tx, tx + msgs[i].len), 0 != msgs[i].cs_change});
+
+        rx[0] = 0x00;
+        if (tx[0] & 0x80) {
+            for (size j = 1; j < msgs[i].len; ++j) {
+                rx[j] = fake.regs[(tx[j - 1] >> 1) & 0x3F];
+            }
+        } else {
+            for (size j = 1; j < msgs[i].len; ++j) {
+                fake.regs[(tx[0] >> 1) & 0x3F] = tx[j];
+            }
+        }
+    }
+    fake.messages.push_back(message);
+    fake.fds.push_back(fd);
+    return static_cast<int>(num);
+}
+
+/* Reset fake device and set up the backend to use it */
+static void setupFake(const char* path = "/dev/null")
+{
+    std::fill(std::begin(fake.regs), std::end(fake.regs), 0x00);
+    fake.messages.clear();
+    fake.fds.clear();
+    fake.mode = 0xFF;
+    fake.bits = 0;
+    fake.speed = 0;
+    fake.failReq = 0;
+
+    mfrc522_ll_spidev_conf conf;
+    conf.path = path;
+    conf.speed = 0;
+    conf.ioctl_fn = fakeIoctl;
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_spidev_setup(&spidev, &conf));
+}
+
+/* Initialize the driver on top of spidev backend */
+static mfrc522_drv_conf initDriver(mfrc522_ll_spidev* dev = &spidev)
+{
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &mfrc522_ll_spidev_ops;
+    conf.ll_ctx = dev;
+    fake.regs[mfrc522_reg_version] = 0x92;
+    EXPECT_EQ(mfrc522_drv_status_ok, mfrc522_drv_init(&conf));
+    fake.messages.clear();
+    fake.fds.clear();
+    return conf;
+}
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Test cases ------------------------ */
+/* ------------------------------------------------------------ */
+
+TEST(TestMfrc522LlSpidev, mfrc522_ll_spidev_setup__NullCases)
+{
+    mfrc522_ll_spidev_conf conf;
+    conf.path = "/dev/null";
+    conf.speed = 0;
+    conf.ioctl_fn = fakeIoctl;
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_spidev_setup(nullptr, &conf));
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_spidev_setup(&spidev, nullptr));
+
+    conf.path = nullptr;
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_spidev_setup(&spidev, &conf));
+}
+
+TEST(TestMfrc522LlSpidev, mfrc522_drv_init__TypicalCase__DeviceConfigured)
+{
+    setupFake();
+    auto conf = initDriver();
+
+    ASSERT_EQ(0x92, conf.chip_version);
+    ASSERT_EQ(SPI_MODE_0, fake.mode);
+    ASSERT_EQ(8, fake.bits);
+    ASSERT_EQ(static_cast<u32>(MFRC522_LL_SPIDEV_DEF_SPEED), fake.speed);
+    mfrc522_ll_spidev_close(&spidev);
+}
+
+TEST(TestMfrc522LlSpidev, mfrc522_drv_write__TwoInstances__OwnDeviceUsed)
+{
+    setupFake();
+    mfrc522_ll_spidev other;
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_spidev_setup(&other, &spidev.conf));
+    auto conf = initDriver();
+    auto otherConf = initDriver(&other);
+    ASSERT_NE(spidev.fd, other.fd);
+
+    const u8 payload = 0xAB;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write(&otherConf, mfrc522_reg_fifo_data, 1, &payload));
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write(&conf, mfrc522_reg_fifo_data, 1, &payload));
+
+    const std::vector<int> expected = {other.fd, spidev.fd};
+    ASSERT_EQ(expected, fake.fds);
+    mfrc522_ll_spidev_close(&other);
+    mfrc522_ll_spidev_close(&spidev);
+}
+
+TEST(TestMfrc522LlSpidev, mfrc522_drv_init__OpenFailure__LlErrorReturned)
+{
+    setupFake("/nonexistent/spidev0.0");
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &mfrc522_ll_spidev_ops;
+    conf.ll_ctx = &spidev;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, mfrc522_drv_init(&conf));
+}
+
+TEST(TestMfrc522LlSpidev, mfrc522_drv_init__IoctlFailure__LlErrorReturned)
+{
+    setupFake();
+    fake.failReq = SPI_IOC_WR_MAX_SPEED_HZ;
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &mfrc522_ll_spidev_ops;
+    conf.ll_ctx = &spidev;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, mfrc522_drv_init(&conf));
+}
+
+TEST(TestMfrc522LlSpidev, send__TypicalCase__AddressByteEncoded)
+{
+    setupFake();
+    auto conf = initDriver();
+
+    const u8 payload[] = {0xAB, 0xCD};
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write(&conf, mfrc522_reg_fifo_data, SIZE_ARRAY(payload), payload));
+
+    ASSERT_EQ(1U, fake.messages.size());
+    ASSERT_EQ(1U, fake.messages[0].size());
+    const std::vector<u8> expected = {0x12, 0xAB, 0xCD};
+    ASSERT_EQ(expected, fake.messages[0][0].tx);
+    ASSERT_FALSE(fake.messages[0][0].csChange);
+    mfrc522_ll_spidev_close(&spidev);
+}
+
+TEST(TestMfrc522LlSpidev, recv_mul__TypicalCase__AddressByteRepeated)
+{
+    setupFake();
+    auto conf = initDriver();
+    fake.regs[mfrc522_reg_fifo_data] = 0x5A;
+
+    u8 buffer[3];
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_read_mul(&conf, mfrc522_reg_fifo_data, SIZE_ARRAY(buffer), buffer));
+
+    ASSERT_EQ(1U, fake.messages.size());
+    const std::vector<u8> expected = {0x92, 0x92, 0x92, 0x00};
+    ASSERT_EQ(expected, fake.messages[0][0].tx);
+    for (auto byte : buffer) {
+        ASSERT_EQ(0x5A, byte);
+    }
+    mfrc522_ll_spidev_close(&spidev);
+}
+
+TEST(TestMfrc522LlSpidev, transfer_multi__TypicalCase__SingleMessageSent)
+{
+    setupFake();
+    initDriver();
+    fake.regs[mfrc522_reg_demod] = 0x4D;
+
+    u8 write = 0x33;
+    u8 read;
+    const mfrc522_ll_xfer xfers[] = {
+        {mfrc522_reg_tx_control, 1, &write, nullptr},
+        {mfrc522_reg_demod, 1, nullptr, &read},
+        {mfrc522_reg_command, 1, &write, nullptr}
+    };
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_spidev_ops.transfer_multi(&spidev, xfers, SIZE_ARRAY(xfers)));
+
+    ASSERT_EQ(1U, fake.messages.size());
+    ASSERT_EQ(3U, fake.messages[0].size());
+    /* Chip-select is toggled between transfers but not after the last one */
+    ASSERT_TRUE(fake.messages[0][0].csChange);
+    ASSERT_TRUE(fake.messages[0][1].csChange);
+    ASSERT_FALSE(fake.messages[0][2].csChange);
+    ASSERT_EQ(0x4D, read);
+    ASSERT_EQ(0x33, fake.regs[mfrc522_reg_tx_control]);
+    mfrc522_ll_spidev_close(&spidev);
+}
+
+TEST(TestMfrc522LlSpidev, transfer_multi__LongBatch__SplitIntoSeveralMessages)
+{
+    setupFake();
+    initDriver();
+
+    u8 write = 0x01;
+    std::vector<mfrc522_ll_xfer> xfers(MFRC522_LL_SPIDEV_XFER_MAX + 4, {mfrc522_reg_fifo_data, 1, &write, nullptr});
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_spidev_ops.transfer_multi(&spidev, xfers.data(), xfers.size()));
+
+    ASSERT_EQ(2U, fake.messages.size());
+    ASSERT_EQ(static_cast<size>(MFRC522_LL_SPIDEV_XFER_MAX), fake.messages[0].size());
+    ASSERT_EQ(4U, fake.messages[1].size());
+    mfrc522_ll_spidev_close(&spidev);
+}
+
+TEST(TestMfrc522LlSpidev, transfer_multi__IoctlFailure__ErrorReturned)
+{
+    setupFake();
+    initDriver();
+    fake.failReq = SPI_IOC_MESSAGE(1);
+
+    u8 byte = 0x00;
+    ASSERT_EQ(mfrc522_ll_status_send_err, mfrc522_ll_spidev_ops.send(&spidev, mfrc522_reg_command, 1, &byte));
+    ASSERT_EQ(mfrc522_ll_status_recv_err, mfrc522_ll_spidev_ops.recv(&spidev, mfrc522_reg_command, &byte));
+    mfrc522_ll_spidev_close(&spidev);
+}
+
+TEST(TestMfrc522LlSpidev, mfrc522_drv_tim_start__TypicalCase__FewSystemCallsUsed)
+{
+    setupFake();
+    auto conf = initDriver();
+
+    mfrc522_drv_tim_conf timerConf = MFRC522_DRV_TIM_CONF_DEFAULT;
+    timerConf.prescaler_type = mfrc522_drv_tim_psl_odd;
+    timerConf.prescaler = 0xFABC;
+    timerConf.reload_val = 0x0CA0;
+    timerConf.periodic = true;
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_tim_start(&conf, &timerConf));
+
+    /* Host-owned registers are read at once, then the configuration and Control register read, then the last write */
+    ASSERT_EQ(3U, fake.messages.size());
+    ASSERT_EQ(0xBC, fake.regs[mfrc522_reg_tim_prescaler]);
+    ASSERT_EQ(0xA0, fake.regs[mfrc522_reg_tim_reload_lo]);
+    ASSERT_EQ(0x0C, fake.regs[mfrc522_reg_tim_reload_hi]);
+    mfrc522_ll_spidev_close(&spidev);
+}
@@ -0,0 +1,258 @@
+#include "mfrc522_drv.h"
+#include "mfrc522_ll_thread.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Private data ---------------------- */
+/* ------------------------------------------------------------ */
+
+/* State of emulated device */
+static struct
+{
+    u8 regs[MFRC522_DRV_REG_NUM];
+    std::mutex lock;
+    std::condition_variable cond;
+    bool blocked; /* Send calls wait while the flag is set */
+    size waiting; /* Number of send calls waiting for being unblocked */
+} fake;
+
+/* Instance of the backend under test */
+static mfrc522_ll_thread thread;
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+/* Synchronous low-level operations wrapped by the backend. Context points to the fake device */
+static mfrc522_ll_status fakeInit(void* ctx)
+{
+    return (&fake == ctx) ? mfrc522_ll_status_ok : mfrc522_ll_status_init_err;
+}
+
+static mfrc522_ll_status fakeSend(void* ctx, u8 addr, size bytes, const u8* payload)
+{
+    if (&fake != ctx) {
+        return mfrc522_ll_status_send_err;
+    }
+    std::unique_lock<std::mutex> lock(fake.lock);
+    ++fake.waiting;
+    fake.cond.notify_all();
+    fake.cond.wait(lock, [] { return !fake.blocked; });
+    --fake.waiting;
+    for (size i = 0; i < bytes; ++i) {
+        fake.regs[addr] = payload[i];
+    }
+    return mfrc522_ll_status_ok;
+}
+
+static mfrc522_ll_status fakeRecvMul(void* ctx, u8 addr, size bytes, u8* payload)
+{
+    if (&fake != ctx) {
+        return mfrc522_ll_status_recv_err;
+    }
+    std::fill(payload, payload + bytes, fake.regs[addr]);
+    return mfrc522_ll_status_ok;
+}
+
+static mfrc522_ll_status fakeRecv(void* ctx, u8 addr, u8* payload)
+{
+    return fakeRecvMul(ctx, addr, 1, payload);
+}
+
+static void fakeDelay(void* ctx, u32 period)
+{
+    static_cast<void>(ctx);
+    static_cast<void>(period);
+}
+
+static mfrc522_ll_status fakeWaitIrq(void* ctx, u32 timeout)
+{
+    return (&fake == ctx && 1000 == timeout) ? mfrc522_ll_status_timeout : mfrc522_ll_status_recv_err;
+}
+
+static u32 fakeNow(void* ctx)
+{
+    return (&fake == ctx) ? 0xDEADBEEF : 0;
+}
+
+static mfrc522_ll_ops fakeOps()
+{
+    mfrc522_ll_ops ops;
+    ops.version = MFRC522_LL_OPS_VERSION;
+    ops.init = fakeInit;
+    ops.send = fakeSend;
+    ops.recv = fakeRecv;
+    ops.recv_mul = fakeRecvMul;
+    ops.delay = fakeDelay;
+    ops.transfer_multi = nullptr;
+    ops.submit = nullptr;
+    ops.wait_irq = nullptr;
+    ops.now = nullptr;
+    return ops;
+}
+
+/* Block or unblock send calls */
+static void blockSend(bool blocked)
+{
+    {
+        std::lock_guard<std::mutex> lock(fake.lock);
+        fake.blocked = blocked;
+    }
+    fake.cond.notify_all();
+}
+
+/* Completion callback fulfilling a promise */
+static void completeCb(mfrc522_drv_status status, void* arg)
+{
+    static_cast<std::promise<mfrc522_drv_status>*>(arg)->set_value(status);
+}
+
+/* Start the worker and initialize the driver on top of it */
+static mfrc522_drv_conf initDriver(const mfrc522_ll_ops* ops)
+{
+    std::fill(std::begin(fake.regs), std::end(fake.regs), 0x00);
+    fake.regs[mfrc522_reg_version] = 0x92;
+    fake.blocked = false;
+    fake.waiting = 0;
+    EXPECT_EQ(mfrc522_ll_status_ok, mfrc522_ll_thread_start(&thread, ops, &fake));
+
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &mfrc522_ll_thread_ops;
+    conf.ll_ctx = &thread;
+    EXPECT_EQ(mfrc522_drv_status_ok, mfrc522_drv_init(&conf));
+    return conf;
+}
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Test cases ------------------------ */
+/* ------------------------------------------------------------ */
+
+TEST(TestMfrc522LlThread, mfrc522_ll_thread_start__NullCases)
+{
+    auto ops = fakeOps();
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_thread_start(nullptr, &ops, &fake));
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_thread_start(&thread, nullptr, &fake));
+}
+
+TEST(TestMfrc522LlThread, mfrc522_ll_thread_start__AlreadyRunning__Failure)
+{
+    auto ops = fakeOps();
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_thread_start(&thread, &ops, &fake));
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_thread_start(&thread, &ops, &fake));
+    mfrc522_ll_thread_stop(&thread);
+}
+
+TEST(TestMfrc522LlThread, mfrc522_drv_init__NotStarted__LlErrorReturned)
+{
+    mfrc522_ll_thread notStarted = {};
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ops = &mfrc522_ll_thread_ops;
+    conf.ll_ctx = &notStarted;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, mfrc522_drv_init(&conf));
+}
+
+TEST(TestMfrc522LlThread, mfrc522_drv_write_async__TypicalCase__PerformedByWorker)
+{
+    auto ops = fakeOps();
+    auto conf = initDriver(&ops);
+
+    /* Worker is blocked, so the write cannot complete before the function returns */
+    blockSend(true);
+    std::promise<mfrc522_drv_status> promise;
+    auto future = promise.get_future();
+    const u8 payload = 0x5A;
+    mfrc522_drv_async_req req;
+    ASSERT_EQ(mfrc522_drv_status_ok,
+              mfrc522_drv_write_async(&conf, &req, mfrc522_reg_fifo_data, 1, &payload, completeCb, &promise));
+    ASSERT_EQ(std::future_status::timeout, future.wait_for(std::chrono::milliseconds(10)));
+
+    blockSend(false);
+    ASSERT_EQ(mfrc522_drv_status_ok, future.get());
+    ASSERT_EQ(0x5A, fake.regs[mfrc522_reg_fifo_data]);
+    mfrc522_ll_thread_stop(&thread);
+}
+
+TEST(TestMfrc522LlThread, mfrc522_drv_read_async__MixedWithSyncCalls__ValidValueRead)
+{
+    auto ops = fakeOps();
+    auto conf = initDriver(&ops);
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write_byte(&conf, mfrc522_reg_demod, 0x4D));
+
+    std::promise<mfrc522_drv_status> promise;
+    auto future = promise.get_future();
+    u8 payload = 0x00;
+    mfrc522_drv_async_req req;
+    ASSERT_EQ(mfrc522_drv_status_ok,
+              mfrc522_drv_read_async(&conf, &req, mfrc522_reg_demod, &payload, completeCb, &promise));
+    ASSERT_EQ(mfrc522_drv_status_ok, future.get());
+    ASSERT_EQ(0x4D, payload);
+    mfrc522_ll_thread_stop(&thread);
+}
+
+TEST(TestMfrc522LlThread, mfrc522_drv_write_async__QueueFull__LlErrorReturned)
+{
+    auto ops = fakeOps();
+    auto conf = initDriver(&ops);
+    blockSend(true);
+
+    /* The first request is taken by the worker, the rest fill up the queue */
+    const u8 payload = 0x01;
+    std::promise<mfrc522_drv_status> promises[MFRC522_LL_THREAD_QUEUE_SZ + 1];
+    mfrc522_drv_async_req reqs[MFRC522_LL_THREAD_QUEUE_SZ + 2];
+    ASSERT_EQ(mfrc522_drv_status_ok,
+              mfrc522_drv_write_async(&conf, &reqs[0], mfrc522_reg_fifo_data, 1, &payload, completeCb, &promises[0]));
+    {
+        std::unique_lock<std::mutex> lock(fake.lock);
+        fake.cond.wait(lock, [] { return fake.waiting > 0; });
+    }
+    for (size i = 1; i < SIZE_ARRAY(promises); ++i) {
+        ASSERT_EQ(mfrc522_drv_status_ok,
+                  mfrc522_drv_write_async(&conf, &reqs[i], mfrc522_reg_fifo_data, 1, &payload, completeCb,
+                                          &promises[i]));
+    }
+    ASSERT_EQ(mfrc522_drv_status_ll_err,
+              mfrc522_drv_write_async(&conf, &reqs[SIZE_ARRAY(promises)], mfrc522_reg_fifo_data, 1, &payload,
+                                      completeCb, nullptr));
+
+    /* Pending requests are completed when the worker is stopped */
+    blockSend(false);
+    mfrc522_ll_thread_stop(&thread);
+    for (auto& promise : promises) {
+        ASSERT_EQ(mfrc522_drv_status_ok, promise.get_future().get());
+    }
+}
+
+TEST(TestMfrc522LlThread, mfrc522_ll_thread_ops__WaitIrqAndClockWrapped__Forwarded)
+{
+    auto ops = fakeOps();
+    ops.wait_irq = fakeWaitIrq;
+    ops.now = fakeNow;
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_thread_start(&thread, &ops, &fake));
+
+    ASSERT_EQ(mfrc522_ll_status_timeout, mfrc522_ll_thread_ops.wait_irq(&thread, 1000));
+    ASSERT_EQ(0xDEADBEEF, mfrc522_ll_thread_ops.now(&thread));
+    mfrc522_ll_thread_stop(&thread);
+}
+
+TEST(TestMfrc522LlThread, mfrc522_ll_thread_ops__WaitIrqAndClockNotWrapped__FallbacksUsed)
+{
+    auto ops = fakeOps();
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_thread_start(&thread, &ops, &fake));
+
+    /* Pin is reported active, so the driver checks interrupt request registers */
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_thread_ops.wait_irq(&thread, 1000));
+
+    /* System clock advances */
+    u32 start = mfrc522_ll_thread_ops.now(&thread);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    ASSERT_LE(2000u, static_cast<u32>(mfrc522_ll_thread_ops.now(&thread) - start));
+    mfrc522_ll_thread_stop(&thread);
+}
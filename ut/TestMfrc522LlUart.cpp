@@ -0,0 +1,307 @@
+#include "mfrc522_drv.h"
+#include "mfrc522_ll_uart.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <map>
+#include <poll.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Private data ---------------------- */
+/* ------------------------------------------------------------ */
+
+/* SerialSpeedReg values and corresponding baud rates */
+static const std::map<u8, std::pair<u32, speed_t>> serialSpeeds = {
+    {0x1C, {921600, B921600}},
+    {0x3A, {460800, B460800}},
+    {0x5A, {230400, B230400}},
+    {0x7A, {115200, B115200}},
+    {0x9A, {57600, B57600}},
+    {0xAB, {38400, B38400}},
+    {0xCB, {19200, B19200}},
+    {0xEB, {9600, B9600}}
+};
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Private classes -------------------- */
+/* ------------------------------------------------------------ */
+
+/*
+ * MFRC522 emulated on master side of a pseudo-terminal. Bytes sent while host side uses different baud rate than
+ * the device are dropped, as they would be garbled on a real serial line.
+ */
+class PtyDevice
+{
+public:
+    explicit PtyDevice(u32 maxBaud, u8 serialSpeed = 0xEB) : maxBaud(maxBaud)
+    {
+        std::fill(std::begin(regs), std::end(regs), 0x00);
+        regs[mfrc522_reg_version] = 0x92;
+        regs[mfrc522_reg_serial_speed] = serialSpeed;
+
+        master = posix_openpt(O_RDWR | O_NOCTTY);
+        grantpt(master);
+        unlockpt(master);
+        path = ptsname(master);
+    }
+
+    ~PtyDevice()
+    {
+        stop();
+        close(master);
+    }
+
+    void start()
+    {
+        running = true;
+        worker = std::thread(&PtyDevice::loop, this);
+    }
+
+    void stop()
+    {
+        running = false;
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    u8 regs[MFRC522_DRV_REG_NUM];
+    std::string path;
+
+private:
+    void loop()
+    {
+        bool writePending = false;
+        u8 addr = 0;
+        while (running) {
+            pollfd pfd = {master, POLLIN, 0};
+            u8 byte;
+            if (poll(&pfd, 1, 5) <= 0 || read(master, &byte, 1) != 1) {
+                continue;
+            }
+
+            /* Pseudo-terminal master shares termios settings with slave side */
+            termios tio;
+            tcgetattr(master, &tio);
+            if (cfgetospeed(&tio) != serialSpeeds.at(regs[mfrc522_reg_serial_speed]).second) {
+                writePending = false;
+                continue;
+            }
+
+            if (writePending) {
+                write(master, &addr, 1);
+                auto rate = serialSpeeds.find(byte);
+                bool rejected = (mfrc522_reg_serial_speed == addr) &&
+                                (serialSpeeds.end() == rate || rate->second.first > maxBaud);
+                if (!rejected) {
+                    regs[addr] = byte;
+                }
+                writePending = false;
+            } else if (byte & 0x80) {
+                write(master, &regs[byte & 0x3F], 1);
+            } else {
+                addr = byte & 0x3F;
+                writePending = true;
+            }
+        }
+    }
+
+    int master;
+    u32 maxBaud;
+    std::atomic<bool> running{false};
+    std::thread worker;
+};
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+/* Host serial port which does not support the highest rate, e.g. a USB-UART bridge */
+static int tcsetattrNo921600(int fd, int actions, const termios* tio)
+{
+    if (B921600 == cfgetospeed(tio)) {
+        errno = EINVAL;
+        return -1;
+    }
+    return tcsetattr(fd, actions, tio);
+}
+
+/* Instance of the backend under test */
+static mfrc522_ll_uart uart;
+
+/* Set up the backend and initialize the driver on top of it */
+static mfrc522_drv_status initDriver(const std::string& path, mfrc522_drv_conf* conf, u32 maxBaud = 0,
+                                     mfrc522_ll_uart* dev = &uart, mfrc522_ll_uart_tcsetattr tcsetattrFn = nullptr)
+{
+    mfrc522_ll_uart_conf uartConf;
+    uartConf.path = path.c_str();
+    uartConf.max_baud = maxBaud;
+    uartConf.timeout = 0;
+    uartConf.tcsetattr_fn = tcsetattrFn;
+    EXPECT_EQ(mfrc522_ll_status_ok, mfrc522_ll_uart_setup(dev, &uartConf));
+
+    mfrc522_drv_conf_init(conf);
+    conf->ll_ops = &mfrc522_ll_uart_ops;
+    conf->ll_ctx = dev;
+    return mfrc522_drv_init(conf);
+}
+
+/* ------------------------------------------------------------ */
+/* ------------------------ Test cases ------------------------ */
+/* ------------------------------------------------------------ */
+
+TEST(TestMfrc522LlUart, mfrc522_ll_uart_setup__NullCases)
+{
+    mfrc522_ll_uart_conf conf;
+    conf.path = "/dev/null";
+    conf.max_baud = 0;
+    conf.timeout = 0;
+    conf.tcsetattr_fn = nullptr;
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_uart_setup(nullptr, &conf));
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_uart_setup(&uart, nullptr));
+
+    conf.path = nullptr;
+    ASSERT_EQ(mfrc522_ll_status_init_err, mfrc522_ll_uart_setup(&uart, &conf));
+}
+
+TEST(TestMfrc522LlUart, mfrc522_drv_init__TypicalCase__HighestRateNegotiated)
+{
+    PtyDevice device(MFRC522_LL_UART_MAX_BAUD);
+    device.start();
+
+    mfrc522_drv_conf conf;
+    ASSERT_EQ(mfrc522_drv_status_ok, initDriver(device.path, &conf));
+    ASSERT_EQ(0x92, conf.chip_version);
+    ASSERT_EQ(static_cast<u32>(MFRC522_LL_UART_MAX_BAUD), mfrc522_ll_uart_baud(&uart));
+
+    mfrc522_ll_uart_close(&uart);
+    device.stop();
+    ASSERT_EQ(0x1C, device.regs[mfrc522_reg_serial_speed]);
+}
+
+TEST(TestMfrc522LlUart, mfrc522_drv_init__MaxBaudLimited__LimitRespected)
+{
+    PtyDevice device(MFRC522_LL_UART_MAX_BAUD);
+    device.start();
+
+    mfrc522_drv_conf conf;
+    ASSERT_EQ(mfrc522_drv_status_ok, initDriver(device.path, &conf, 115200));
+    ASSERT_EQ(115200U, mfrc522_ll_uart_baud(&uart));
+    mfrc522_ll_uart_close(&uart);
+}
+
+TEST(TestMfrc522LlUart, mfrc522_drv_init__HighRatesRejected__FallbackToLowerRate)
+{
+    PtyDevice device(115200);
+    device.start();
+
+    mfrc522_drv_conf conf;
+    ASSERT_EQ(mfrc522_drv_status_ok, initDriver(device.path, &conf));
+    ASSERT_EQ(115200U, mfrc522_ll_uart_baud(&uart));
+    ASSERT_EQ(0x92, conf.chip_version);
+    mfrc522_ll_uart_close(&uart);
+}
+
+TEST(TestMfrc522LlUart, mfrc522_drv_init__RateNotSupportedByHost__DeviceNotSwitched)
+{
+    PtyDevice device(MFRC522_LL_UART_MAX_BAUD);
+    device.start();
+
+    mfrc522_drv_conf conf;
+    ASSERT_EQ(mfrc522_drv_status_ok, initDriver(device.path, &conf, 0, &uart, tcsetattrNo921600));
+    ASSERT_EQ(460800U, mfrc522_ll_uart_baud(&uart));
+    ASSERT_EQ(0x92, conf.chip_version);
+
+    mfrc522_ll_uart_close(&uart);
+    device.stop();
+    ASSERT_EQ(0x3A, device.regs[mfrc522_reg_serial_speed]);
+}
+
+TEST(TestMfrc522LlUart, mfrc522_drv_init__RateKeptFromPreviousSession__RateFound)
+{
+    PtyDevice device(MFRC522_LL_UART_MAX_BAUD, 0x7A);
+    device.start();
+
+    mfrc522_drv_conf conf;
+    ASSERT_EQ(mfrc522_drv_status_ok, initDriver(device.path, &conf));
+    ASSERT_EQ(static_cast<u32>(MFRC522_LL_UART_MAX_BAUD), mfrc522_ll_uart_baud(&uart));
+    mfrc522_ll_uart_close(&uart);
+}
+
+TEST(TestMfrc522LlUart, mfrc522_drv_init__TwoInstances__RatesNegotiatedIndependently)
+{
+    PtyDevice device(MFRC522_LL_UART_MAX_BAUD);
+    PtyDevice otherDevice(115200);
+    device.start();
+    otherDevice.start();
+
+    mfrc522_ll_uart other;
+    mfrc522_drv_conf conf;
+    mfrc522_drv_conf otherConf;
+    ASSERT_EQ(mfrc522_drv_status_ok, initDriver(device.path, &conf));
+    ASSERT_EQ(mfrc522_drv_status_ok, initDriver(otherDevice.path, &otherConf, 0, &other));
+    ASSERT_EQ(static_cast<u32>(MFRC522_LL_UART_MAX_BAUD), mfrc522_ll_uart_baud(&uart));
+    ASSERT_EQ(115200U, mfrc522_ll_uart_baud(&other));
+
+    ASSERT_EQ(mfrc522_drv_status_ok, mfrc522_drv_write_byte(&otherConf, mfrc522_reg_demod, 0x4D));
+    mfrc522_ll_uart_close(&other);
+    mfrc522_ll_uart_close(&uart);
+    otherDevice.stop();
+    device.stop();
+    ASSERT_EQ(0x4D, otherDevice.regs[mfrc522_reg_demod]);
+    ASSERT_NE(0x4D, device.regs[mfrc522_reg_demod]);
+}
+
+TEST(TestMfrc522LlUart, mfrc522_drv_init__NoDevice__LlErrorReturned)
+{
+    PtyDevice device(MFRC522_LL_UART_MAX_BAUD);
+
+    mfrc522_drv_conf conf;
+    ASSERT_EQ(mfrc522_drv_status_ll_err, initDriver(device.path, &conf));
+    ASSERT_EQ(0U, mfrc522_ll_uart_baud(&uart));
+}
+
+TEST(TestMfrc522LlUart, transfer_multi__TypicalCase__WritesAndReadsHandled)
+{
+    PtyDevice device(MFRC522_LL_UART_MAX_BAUD);
+    device.regs[mfrc522_reg_demod] = 0x4D;
+    device.start();
+
+    mfrc522_drv_conf conf;
+    ASSERT_EQ(mfrc522_drv_status_ok, initDriver(device.path, &conf));
+
+    const u8 write[] = {0x33, 0x44};
+    u8 read[2];
+    const mfrc522_ll_xfer xfers[] = {
+        {mfrc522_reg_tx_control, 1, &write[0], nullptr},
+        {mfrc522_reg_demod, SIZE_ARRAY(read), nullptr, read},
+        {mfrc522_reg_fifo_data, SIZE_ARRAY(write), write, nullptr}
+    };
+    ASSERT_EQ(mfrc522_ll_status_ok, mfrc522_ll_uart_ops.transfer_multi(&uart, xfers, SIZE_ARRAY(xfers)));
+    ASSERT_EQ(0x4D, read[0]);
+    ASSERT_EQ(0x4D, read[1]);
+
+    mfrc522_ll_uart_close(&uart);
+    device.stop();
+    ASSERT_EQ(0x33, device.regs[mfrc522_reg_tx_control]);
+    ASSERT_EQ(0x44, device.regs[mfrc522_reg_fifo_data]);
+}
+
+TEST(TestMfrc522LlUart, transfer_multi__DeviceNotResponding__ErrorReturned)
+{
+    PtyDevice device(MFRC522_LL_UART_MAX_BAUD);
+    device.start();
+
+    mfrc522_drv_conf conf;
+    ASSERT_EQ(mfrc522_drv_status_ok, initDriver(device.path, &conf));
+    device.stop();
+
+    u8 byte = 0x00;
+    ASSERT_EQ(mfrc522_ll_status_send_err, mfrc522_ll_uart_ops.send(&uart, mfrc522_reg_command, 1, &byte));
+    ASSERT_EQ(mfrc522_ll_status_recv_err, mfrc522_ll_uart_ops.recv(&uart, mfrc522_reg_command, &byte));
+    mfrc522_ll_uart_close(&uart);
+}
@@ -199,4 +199,28 @@ TEST(TestMfrc522Picc, mfrc522_picc_block_descriptor__MiscCases)
 
     desc = mfrc522_picc_block_descriptor(mfrc522_picc_sector15, mfrc522_picc_block3);
     ASSERT_EQ(63, desc);
-}
\ No newline at end of file
+}
+TEST(TestMfrc522Picc, mfrc522_picc_crc_a__NullOrEmptyFrame__PresetReturned)
+{
+    ASSERT_EQ(MFRC522_PICC_CRC_A_PRESET, mfrc522_picc_crc_a(nullptr, 2));
+
+    u8 frame = 0x00;
+    ASSERT_EQ(MFRC522_PICC_CRC_A_PRESET, mfrc522_picc_crc_a(&frame, 0));
+}
+
+TEST(TestMfrc522Picc, mfrc522_picc_crc_a__KnownFrames__Success)
+{
+    /* Examples from ISO/IEC 14443-3 Annex B */
+    const u8 zeros[] = {0x00, 0x00};
+    ASSERT_EQ(0x1EA0, mfrc522_picc_crc_a(zeros, sizeof(zeros)));
+    const u8 example[] = {0x12, 0x34};
+    ASSERT_EQ(0xCF26, mfrc522_picc_crc_a(example, sizeof(example)));
+
+    /* Frames exchanged with a PICC */
+    const u8 halt[] = {0x50, 0x00};
+    ASSERT_EQ(0xCD57, mfrc522_picc_crc_a(halt, sizeof(halt)));
+    const u8 select[] = {0x93, 0x70, 0x73, 0xEF, 0xD7, 0x18, 0x53};
+    ASSERT_EQ(0xEF95, mfrc522_picc_crc_a(select, sizeof(select)));
+    const u8 sak = 0x08;
+    ASSERT_EQ(0xDDB6, mfrc522_picc_crc_a(&sak, 1));
+}
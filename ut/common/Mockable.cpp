@@ -1,10 +1,21 @@
 #include "Mockable.h"
 
 /* Required by C Mock library */
-DEFINE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_init, ());
-DEFINE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_send, (u8, size, const u8*));
-DEFINE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_recv, (u8, u8*));
-DEFINE_MOCKABLE(void, mfrc522_ll_delay, (u32));
+DEFINE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_init, (void*));
+DEFINE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_send, (void*, u8, size, const u8*));
+DEFINE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_recv, (void*, u8, u8*));
+DEFINE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_recv_mul, (void*, u8, size, u8*));
+DEFINE_MOCKABLE(void, mfrc522_ll_delay, (void*, u32));
+#if MFRC522_LL_BATCH
+DEFINE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_transfer_multi, (void*, const mfrc522_ll_xfer*, size));
+#endif
+#if MFRC522_LL_IRQ
+DEFINE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_wait_irq, (void*, u32));
+#endif
+#if MFRC522_LL_ASYNC
+DEFINE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_submit,
+               (void*, const mfrc522_ll_xfer*, size, mfrc522_ll_complete, void*));
+#endif
 DEFINE_MOCKABLE(mfrc522_drv_status, mfrc522_drv_init, (mfrc522_drv_conf*));
 DEFINE_MOCKABLE(mfrc522_drv_status, mfrc522_drv_soft_reset, (const mfrc522_drv_conf*));
 DEFINE_MOCKABLE(mfrc522_drv_status, mfrc522_drv_invoke_cmd, (const mfrc522_drv_conf*, mfrc522_reg_cmd));
@@ -26,10 +26,10 @@ CMOCK_MOCK_FUNCTION(FUNC##__MOCK, RET, FUNC, ARGS) static_assert(true, "Semicolo
 #define STUB_CALL(FUNC, ...) ON_CALL(FUNC##__mocked, FUNC(__VA_ARGS__))
 #define MOCK_CALL_NO_ARGS(FUNC) EXPECT_CALL(FUNC##__mocked, FUNC())
 #define IGNORE_REDUNDANT_LL_RECV_CALLS() \
-MOCK_CALL(mfrc522_ll_recv, _, _).Times(AnyNumber()) \
-    .WillRepeatedly(DoAll(SetArgPointee<1>(0x00), Return(mfrc522_ll_status_ok)))
+MOCK_CALL(mfrc522_ll_recv, _, _, _).Times(AnyNumber()) \
+    .WillRepeatedly(DoAll(SetArgPointee<2>(0x00), Return(mfrc522_ll_status_ok)))
 #define IGNORE_REDUNDANT_LL_SEND_CALLS() \
-MOCK_CALL(mfrc522_ll_send, _, _, _).Times(AnyNumber()) \
+MOCK_CALL(mfrc522_ll_send, _, _, _, _).Times(AnyNumber()) \
     .WillRepeatedly(Return(mfrc522_ll_status_ok))
 
 /* ------------------------------------------------------------ */
@@ -37,10 +37,21 @@ MOCK_CALL(mfrc522_ll_send, _, _, _).Times(AnyNumber()) \
 /* ------------------------------------------------------------ */
 
 /* Put mock declarations here */
-DECLARE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_init, ());
-DECLARE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_send, (u8, size, const u8*));
-DECLARE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_recv, (u8, u8*));
-DECLARE_MOCKABLE(void, mfrc522_ll_delay, (u32));
+DECLARE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_init, (void*));
+DECLARE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_send, (void*, u8, size, const u8*));
+DECLARE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_recv, (void*, u8, u8*));
+DECLARE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_recv_mul, (void*, u8, size, u8*));
+DECLARE_MOCKABLE(void, mfrc522_ll_delay, (void*, u32));
+#if MFRC522_LL_BATCH
+DECLARE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_transfer_multi, (void*, const mfrc522_ll_xfer*, size));
+#endif
+#if MFRC522_LL_IRQ
+DECLARE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_wait_irq, (void*, u32));
+#endif
+#if MFRC522_LL_ASYNC
+DECLARE_MOCKABLE(mfrc522_ll_status, mfrc522_ll_submit,
+                 (void*, const mfrc522_ll_xfer*, size, mfrc522_ll_complete, void*));
+#endif
 DECLARE_MOCKABLE(mfrc522_drv_status, mfrc522_drv_init, (mfrc522_drv_conf*));
 DECLARE_MOCKABLE(mfrc522_drv_status, mfrc522_drv_soft_reset, (const mfrc522_drv_conf*));
 DECLARE_MOCKABLE(mfrc522_drv_status, mfrc522_drv_invoke_cmd, (const mfrc522_drv_conf*, mfrc522_reg_cmd));
@@ -0,0 +1,182 @@
+#include "SimulatedChip.h"
+#include <algorithm>
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public functions ------------------- */
+/* ------------------------------------------------------------ */
+
+SimulatedChip::SimulatedChip()
+{
+    std::fill(std::begin(regs), std::end(regs), 0x00);
+    regs[mfrc522_reg_command] = 0x20 | mfrc522_reg_cmd_idle;
+    regs[mfrc522_reg_version] = 0x92;
+}
+
+const mfrc522_ll_ops* SimulatedChip::ops(bool clock, bool batch)
+{
+    static const mfrc522_ll_ops table[2][2] = {
+        {makeOps(false, false), makeOps(false, true)},
+        {makeOps(true, false), makeOps(true, true)}
+    };
+    return &table[clock][batch];
+}
+
+/* ------------------------------------------------------------ */
+/* --------------------- Protected functions ------------------ */
+/* ------------------------------------------------------------ */
+
+void SimulatedChip::access(u8 addr)
+{
+    static_cast<void>(addr);
+}
+
+void SimulatedChip::write(u8 addr, u8 val)
+{
+    switch (addr) {
+        case mfrc522_reg_fifo_data:
+            fifo.push_back(val);
+            break;
+        case mfrc522_reg_fifo_level:
+            if (val & 0x80) {
+                fifo.clear();
+            }
+            break;
+        case mfrc522_reg_com_irq:
+        case mfrc522_reg_div_irq:
+            /* Set1 bit decides whether marked bits are set or cleared */
+            regs[addr] = (val & 0x80) ? (regs[addr] | (val & 0x7F)) : (regs[addr] & ~val);
+            break;
+        case mfrc522_reg_bit_framing:
+            regs[addr] = val & 0x7F;
+            if ((val & 0x80) && mfrc522_reg_cmd_transceive == (regs[mfrc522_reg_command] & 0x0F)) {
+                transmit();
+            }
+            break;
+        default:
+            regs[addr] = val;
+            break;
+    }
+}
+
+u8 SimulatedChip::read(u8 addr)
+{
+    switch (addr) {
+        case mfrc522_reg_fifo_data: {
+            u8 val = fifo.empty() ? 0x00 : fifo.front();
+            if (!fifo.empty()) {
+                fifo.pop_front();
+            }
+            return val;
+        }
+        case mfrc522_reg_fifo_level:
+            return static_cast<u8>(fifo.size());
+        default:
+            return regs[addr];
+    }
+}
+
+void SimulatedChip::transmit()
+{
+    fifo.clear();
+}
+
+/* ------------------------------------------------------------ */
+/* --------------------- Private functions -------------------- */
+/* ------------------------------------------------------------ */
+
+SimulatedChip* SimulatedChip::self(void* ctx)
+{
+    return static_cast<SimulatedChip*>(ctx);
+}
+
+mfrc522_ll_status SimulatedChip::init(void* ctx)
+{
+    static_cast<void>(ctx);
+    return mfrc522_ll_status_ok;
+}
+
+void SimulatedChip::delay(void* ctx, u32 period)
+{
+    self(ctx)->clock += period;
+}
+
+u32 SimulatedChip::now(void* ctx)
+{
+    ++self(ctx)->clockCalls;
+    return self(ctx)->clock;
+}
+
+mfrc522_ll_status SimulatedChip::send(void* ctx, u8 addr, size bytes, const u8* payload)
+{
+    self(ctx)->transaction();
+    if (self(ctx)->sendFails) {
+        return mfrc522_ll_status_send_err;
+    }
+    self(ctx)->access(addr);
+    for (size i = 0; i < bytes; ++i) {
+        self(ctx)->write(addr, payload[i]);
+    }
+    return mfrc522_ll_status_ok;
+}
+
+mfrc522_ll_status SimulatedChip::recv(void* ctx, u8 addr, u8* payload)
+{
+    return recvMul(ctx, addr, 1, payload);
+}
+
+mfrc522_ll_status SimulatedChip::recvMul(void* ctx, u8 addr, size bytes, u8* payload)
+{
+    self(ctx)->transaction();
+    if (self(ctx)->recvFails) {
+        return mfrc522_ll_status_recv_err;
+    }
+    self(ctx)->access(addr);
+    for (size i = 0; i < bytes; ++i) {
+        payload[i] = self(ctx)->read(addr);
+    }
+    return mfrc522_ll_status_ok;
+}
+
+mfrc522_ll_status SimulatedChip::transferMulti(void* ctx, const mfrc522_ll_xfer* xfers, size num)
+{
+    self(ctx)->transaction();
+    for (size i = 0; i < num; ++i) {
+        if (nullptr == xfers[i].tx && self(ctx)->recvFails) {
+            return mfrc522_ll_status_recv_err;
+        }
+        if (nullptr != xfers[i].tx && self(ctx)->sendFails) {
+            return mfrc522_ll_status_send_err;
+        }
+        self(ctx)->access(xfers[i].addr);
+        for (size j = 0; j < xfers[i].bytes; ++j) {
+            if (nullptr != xfers[i].tx) {
+                self(ctx)->write(xfers[i].addr, xfers[i].tx[j]);
+            } else {
+                xfers[i].rx[j] = self(ctx)->read(xfers[i].addr);
+            }
+        }
+    }
+    return mfrc522_ll_status_ok;
+}
+
+mfrc522_ll_ops SimulatedChip::makeOps(bool clock, bool batch)
+{
+    mfrc522_ll_ops ops;
+    ops.version = MFRC522_LL_OPS_VERSION;
+    ops.init = init;
+    ops.send = send;
+    ops.recv = recv;
+    ops.recv_mul = recvMul;
+    ops.delay = delay;
+    ops.transfer_multi = batch ? transferMulti : nullptr;
+    ops.submit = nullptr;
+    ops.wait_irq = nullptr;
+    ops.now = clock ? now : nullptr;
+    return ops;
+}
+
+void SimulatedChip::transaction()
+{
+    clock += busCost;
+    ++transactions;
+}
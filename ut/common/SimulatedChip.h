@@ -0,0 +1,60 @@
+#ifndef MFRC522_SIMULATEDCHIP_H
+#define MFRC522_SIMULATEDCHIP_H
+
+#include "mfrc522_drv.h"
+#include <deque>
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Public classes --------------------- */
+/* ------------------------------------------------------------ */
+
+/*
+ * MFRC522 emulated at register level with simulated time. The base chip handles FIFO, interrupt request registers and
+ * accounts bus time of every low-level call. Tests derive from it and override register accesses they care about.
+ */
+class SimulatedChip
+{
+public:
+    SimulatedChip();
+    virtual ~SimulatedChip() = default;
+
+    /* Low-level operations of a simulated chip. The chip is passed as low-level context */
+    static const mfrc522_ll_ops* ops(bool clock = true, bool batch = false);
+
+    u8 regs[MFRC522_DRV_REG_NUM];
+    std::deque<u8> fifo;
+    u32 clock = 0; /* Time in microseconds */
+    u32 busCost = 0; /* Bus time of a single low-level call in microseconds */
+    size transactions = 0; /* Number of low-level calls. A batch counts as one call */
+    size clockCalls = 0;
+    bool recvFails = false; /* Set to make all receive calls fail */
+    bool sendFails = false; /* Set to make all send calls fail */
+
+protected:
+    /* Called on every low-level call with the address of each register accessed. Bus time is already accounted */
+    virtual void access(u8 addr);
+
+    /* Register write. FIFO, Set1 bit of ComIrqReg and DivIrqReg and StartSend bit are handled here */
+    virtual void write(u8 addr, u8 val);
+
+    /* Register read. FIFO is handled here */
+    virtual u8 read(u8 addr);
+
+    /* Called when StartSend bit is set during Transceive command. FIFO holds the frame to send */
+    virtual void transmit();
+
+private:
+    static SimulatedChip* self(void* ctx);
+    static mfrc522_ll_status init(void* ctx);
+    static void delay(void* ctx, u32 period);
+    static u32 now(void* ctx);
+    static mfrc522_ll_status send(void* ctx, u8 addr, size bytes, const u8* payload);
+    static mfrc522_ll_status recv(void* ctx, u8 addr, u8* payload);
+    static mfrc522_ll_status recvMul(void* ctx, u8 addr, size bytes, u8* payload);
+    static mfrc522_ll_status transferMulti(void* ctx, const mfrc522_ll_xfer* xfers, size num);
+    static mfrc522_ll_ops makeOps(bool clock, bool batch);
+
+    void transaction();
+};
+
+#endif //MFRC522_SIMULATEDCHIP_H
@@ -14,6 +14,8 @@ mfrc522_drv_conf initDevice()
 {
     /* Configuration structure returned by mocked init */
     mfrc522_drv_conf conf;
+    mfrc522_drv_conf_init(&conf);
+    conf.ll_ctx = nullptr;
     conf.chip_version = MFRC522_CONF_CHIP_TYPE;
     conf.atqa_verify_fn = piccAcceptAny;
 
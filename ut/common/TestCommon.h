@@ -2,6 +2,32 @@
 #define MFRC522_TESTCOMMON_H
 
 #include "mfrc522_picc.h"
+#include <gmock/gmock.h>
+
+/* ------------------------------------------------------------ */
+/* ----------------------- Custom Actions --------------------- */
+/* ------------------------------------------------------------ */
+
+/* Action to copy send transfers passed to mocked batch function */
+ACTION_P(SaveXfers, out)
+{
+    for (size i = 0; i < arg2; ++i) {
+        if (nullptr != arg1[i].tx) {
+            out->emplace_back(arg1[i].addr, arg1[i].tx[arg1[i].bytes - 1]);
+        }
+    }
+}
+
+/* Action to fill receive transfers passed to mocked batch function. Values are taken in order */
+ACTION_P(FillRx, values)
+{
+    size idx = 0;
+    for (size i = 0; i < arg2; ++i) {
+        if (nullptr != arg1[i].rx) {
+            arg1[i].rx[0] = values[idx++];
+        }
+    }
+}
 
 /* ------------------------------------------------------------ */
 /* ----------------------- Public functions ------------------- */